@@ -0,0 +1,145 @@
+#include "storfs.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define PAGESIZE 512
+#define PAGECOUNT 8192
+uint8_t memorySim[PAGESIZE * PAGECOUNT];
+
+#define DIR_NUM         16
+#define FILE_NUM        16
+#define FILE_SIZE       100
+#define BENCH_ROUNDS    20
+
+static char fileData[FILE_SIZE];
+
+storfs_err_t storfs_read(const struct storfs *storfsInst, storfs_page_t page,
+            storfs_byte_t byte, uint8_t *buffer, storfs_size_t size)
+{
+  if((byte + size) > PAGESIZE || page >= PAGECOUNT)
+  {
+    return STORFS_ERROR;
+  }
+  memcpy(buffer, &memorySim[(PAGESIZE * page) + byte], size);
+
+  return STORFS_OK;
+}
+
+storfs_err_t storfs_write(const struct storfs *storfsInst, storfs_page_t page,
+            storfs_byte_t byte, uint8_t *buffer, storfs_size_t size)
+{
+  if((byte + size) > PAGESIZE || page >= PAGECOUNT)
+  {
+    return STORFS_ERROR;
+  }
+  memcpy(&memorySim[(PAGESIZE * page) + byte], buffer, size);
+
+  return STORFS_OK;
+}
+
+storfs_err_t storfs_erase(const struct storfs *storfsInst, storfs_page_t page)
+{
+  if(page >= PAGECOUNT)
+  {
+    return STORFS_ERROR;
+  }
+  memset(&memorySim[PAGESIZE * page], 0xFF, PAGESIZE);
+
+  return STORFS_OK;
+}
+
+storfs_err_t storfs_sync(const struct storfs *storfsInst)
+{
+  return STORFS_OK;
+}
+
+storfs_t fs = {
+  .read = storfs_read,
+  .write = storfs_write,
+  .erase = storfs_erase,
+  .sync = storfs_sync,
+  .memInst = NULL,
+  .firstPageLoc = 20,
+  .firstByteLoc = 0,
+  .pageSize = PAGESIZE,
+  .pageCount = PAGECOUNT,
+};
+
+static double elapsed_ns(struct timespec *start, struct timespec *end)
+{
+  return (double)(end->tv_sec - start->tv_sec) * 1e9 + (double)(end->tv_nsec - start->tv_nsec);
+}
+
+int main(void)
+{
+  STORFS_FILE file;
+  char path[64];
+  char buffer[FILE_SIZE];
+  long errors = 0, ops = 0;
+  struct timespec start, end;
+
+  for(int i = 0; i < FILE_SIZE; i++)
+  {
+    fileData[i] = 33 + (i % 94);
+  }
+  memset(memorySim, 0xFF, sizeof(memorySim));
+
+  if(storfs_mount(&fs, "C:") != STORFS_OK)
+  {
+    printf("Failed to create the file system\n");
+    return 1;
+  }
+
+  //Build a tree of directories each holding single page files
+  for(int d = 0; d < DIR_NUM; d++)
+  {
+    sprintf(path, "C:/d%d", d);
+    if(storfs_mkdir(&fs, path) != STORFS_OK)
+    {
+      printf("Failed to create %s\n", path);
+      return 1;
+    }
+    for(int f = 0; f < FILE_NUM; f++)
+    {
+      sprintf(path, "C:/d%d/f%d.txt", d, f);
+      if(storfs_fopen(&fs, path, "w", &file) != STORFS_OK || storfs_fputs(&fs, fileData, FILE_SIZE, &file) != STORFS_OK)
+      {
+        printf("Failed to create %s\n", path);
+        return 1;
+      }
+      storfs_fclose(&fs, &file);
+    }
+  }
+
+  //Walk the tree to every file and read it back, every step converts the locations held within the headers
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &start);
+  for(int r = 0; r < BENCH_ROUNDS; r++)
+  {
+    for(int d = 0; d < DIR_NUM; d++)
+    {
+      for(int f = 0; f < FILE_NUM; f++)
+      {
+        sprintf(path, "C:/d%d/f%d.txt", d, f);
+        if(storfs_fopen(&fs, path, "r", &file) != STORFS_OK || storfs_fgets(&fs, buffer, FILE_SIZE, &file) != STORFS_OK ||
+            memcmp(buffer, fileData, FILE_SIZE) != 0)
+        {
+          errors++;
+        }
+        storfs_fclose(&fs, &file);
+        ops++;
+      }
+    }
+  }
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &end);
+
+#ifdef STORFS_PAGE_SIZE_LOG2
+  printf("%-16s", "Fixed geometry");
+#else
+  printf("%-16s", "Runtime geometry");
+#endif
+  printf(" %ld open/read: %8.0f ns each, errors: %ld\n", ops, elapsed_ns(&start, &end) / ops, errors);
+
+  return errors != 0;
+}
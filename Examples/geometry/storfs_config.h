@@ -0,0 +1,8 @@
+#ifndef __STORFS_CONFIG_H
+#define __STORFS_CONFIG_H
+
+#include <stdio.h>
+
+#define STORFS_NO_LOG
+   
+#endif
@@ -0,0 +1,668 @@
+#include "storfs.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define PAGESIZE 512
+#define PAGECOUNT 2048
+uint8_t memorySim[PAGESIZE * PAGECOUNT];
+
+//Pages erased together by a single call to the erase callback
+#ifndef SMOKE_ERASE_PAGES
+#define SMOKE_ERASE_PAGES 1
+#endif
+
+//A page whose programs are corrupted, to exercise the bad block handling, -1 for none
+#ifndef SMOKE_BAD_PAGE
+#define SMOKE_BAD_PAGE -1
+#endif
+
+//The file system starts on a block boundary when pages are erased together
+#if SMOKE_ERASE_PAGES > 1
+#define SMOKE_FIRST_PAGE SMOKE_ERASE_PAGES
+#else
+#define SMOKE_FIRST_PAGE 4
+#endif
+#define SMOKE_DATA_SIZE 20000
+
+#ifdef STORFS_SPARE_HEADERS
+#define SPARESIZE 16
+uint8_t spareSim[SPARESIZE * PAGECOUNT];
+#endif
+
+//Number of calls made to each device callback
+static long eraseCount, writeCount, readCount, syncCount;
+static long failCount;
+
+static char fileData[SMOKE_DATA_SIZE];
+static char readBuf[SMOKE_DATA_SIZE];
+
+#define SMOKE_CHECK(cond)                                                   \
+  do                                                                        \
+  {                                                                         \
+    if(!(cond))                                                             \
+    {                                                                       \
+      printf("FAIL %s:%d %s\n", __FILE__, __LINE__, #cond);                 \
+      failCount++;                                                          \
+    }                                                                       \
+  } while(0)
+
+storfs_err_t storfs_read(const struct storfs *storfsInst, storfs_page_t page,
+            storfs_byte_t byte, uint8_t *buffer, storfs_size_t size)
+{
+  if((byte + size) > PAGESIZE || page >= PAGECOUNT)
+  {
+    return STORFS_ERROR;
+  }
+  memcpy(buffer, &memorySim[(PAGESIZE * page) + byte], size);
+  readCount++;
+
+  return STORFS_OK;
+}
+
+storfs_err_t storfs_write(const struct storfs *storfsInst, storfs_page_t page,
+            storfs_byte_t byte, uint8_t *buffer, storfs_size_t size)
+{
+  if((byte + size) > PAGESIZE || page >= PAGECOUNT)
+  {
+    return STORFS_ERROR;
+  }
+  for(storfs_size_t i = 0; i < size; i++)
+  {
+    //Programming only clears bits, the bad page also flips some of them
+    uint8_t value = (long)page == SMOKE_BAD_PAGE ? buffer[i] ^ 0x5A : buffer[i];
+    memorySim[(PAGESIZE * page) + byte + i] &= value;
+  }
+  writeCount++;
+
+  return STORFS_OK;
+}
+
+storfs_err_t storfs_erase(const struct storfs *storfsInst, storfs_page_t page)
+{
+  if(page >= PAGECOUNT || page % SMOKE_ERASE_PAGES)
+  {
+    return STORFS_ERROR;
+  }
+  memset(&memorySim[PAGESIZE * page], 0xFF, PAGESIZE * SMOKE_ERASE_PAGES);
+#ifdef STORFS_SPARE_HEADERS
+  memset(&spareSim[SPARESIZE * page], 0xFF, SPARESIZE * SMOKE_ERASE_PAGES);
+#endif
+  eraseCount++;
+
+  return STORFS_OK;
+}
+
+storfs_err_t storfs_sync(const struct storfs *storfsInst)
+{
+  syncCount++;
+
+  return STORFS_OK;
+}
+
+#ifdef STORFS_WRITEV
+storfs_err_t storfs_writev(const struct storfs *storfsInst, storfs_page_t page, storfs_byte_t byte,
+            const uint8_t *header, storfs_size_t headerLen, const uint8_t *payload, storfs_size_t payloadLen)
+{
+  if((byte + headerLen + payloadLen) > PAGESIZE || page >= PAGECOUNT)
+  {
+    return STORFS_ERROR;
+  }
+  for(storfs_size_t i = 0; i < headerLen + payloadLen; i++)
+  {
+    uint8_t value = i < headerLen ? header[i] : payload[i - headerLen];
+    if((long)page == SMOKE_BAD_PAGE)
+    {
+      value ^= 0x5A;
+    }
+    memorySim[(PAGESIZE * page) + byte + i] &= value;
+  }
+  writeCount++;
+
+  return STORFS_OK;
+}
+#endif
+
+#ifdef STORFS_SPARE_HEADERS
+storfs_err_t storfs_read_spare(const struct storfs *storfsInst, storfs_page_t page,
+            storfs_byte_t byte, uint8_t *buffer, storfs_size_t size)
+{
+  if((byte + size) > SPARESIZE || page >= PAGECOUNT)
+  {
+    return STORFS_ERROR;
+  }
+  memcpy(buffer, &spareSim[(SPARESIZE * page) + byte], size);
+
+  return STORFS_OK;
+}
+
+storfs_err_t storfs_write_spare(const struct storfs *storfsInst, storfs_page_t page,
+            storfs_byte_t byte, uint8_t *buffer, storfs_size_t size)
+{
+  if((byte + size) > SPARESIZE || page >= PAGECOUNT)
+  {
+    return STORFS_ERROR;
+  }
+  for(storfs_size_t i = 0; i < size; i++)
+  {
+    spareSim[(SPARESIZE * page) + byte + i] &= buffer[i];
+  }
+
+  return STORFS_OK;
+}
+#endif
+
+#ifdef STORFS_THREADSAFE
+//The example runs on a single thread, the callbacks only need to exist
+storfs_err_t storfs_lock(const struct storfs *storfsInst, storfs_lock_t lockType)
+{
+  return STORFS_OK;
+}
+
+storfs_err_t storfs_unlock(const struct storfs *storfsInst, storfs_lock_t lockType)
+{
+  return STORFS_OK;
+}
+#endif
+
+#if defined(STORFS_WORK_BUF) && STORFS_WORK_BUF_SIZE == 0
+static uint8_t workBuf[8 * (PAGESIZE + 16)];
+#endif
+
+storfs_t fs;
+
+//Sets the instance up as if the device had just been powered on, anything held in RAM is lost
+static void power_on(void)
+{
+  memset(&fs, 0, sizeof(fs));
+  fs.read = storfs_read;
+  fs.write = storfs_write;
+  fs.erase = storfs_erase;
+  fs.sync = storfs_sync;
+  fs.firstPageLoc = SMOKE_FIRST_PAGE;
+  fs.pageSize = PAGESIZE;
+  fs.pageCount = PAGECOUNT;
+  fs.eraseSize = PAGESIZE * SMOKE_ERASE_PAGES;
+  fs.partialProgram = 1;
+#ifdef STORFS_WRITEV
+  fs.writev = storfs_writev;
+#endif
+#ifdef STORFS_SPARE_HEADERS
+  //The fragment header of each page is held in its spare area
+  fs.readSpare = storfs_read_spare;
+  fs.writeSpare = storfs_write_spare;
+  fs.pageSize = PAGESIZE + STORFS_FRAGMENT_HEADER_TOTAL_SIZE;
+  fs.eraseSize = fs.pageSize * SMOKE_ERASE_PAGES;
+#endif
+#ifdef STORFS_THREADSAFE
+  fs.lock = storfs_lock;
+  fs.unlock = storfs_unlock;
+#endif
+#if defined(STORFS_WORK_BUF) && STORFS_WORK_BUF_SIZE == 0
+  fs.workBuf = workBuf;
+  fs.workBufSize = sizeof(workBuf);
+#endif
+}
+
+static void remount(void)
+{
+  power_on();
+  SMOKE_CHECK(storfs_mount(&fs, "") == STORFS_OK);
+}
+
+//Prints the number of device calls made since the previous step
+static void step_done(const char *step)
+{
+  static long prevErase, prevWrite, prevRead, prevSync;
+
+  printf("%-12s erase=%ld write=%ld read=%ld sync=%ld\n", step, eraseCount - prevErase, writeCount - prevWrite,
+    readCount - prevRead, syncCount - prevSync);
+  prevErase = eraseCount;
+  prevWrite = writeCount;
+  prevRead = readCount;
+  prevSync = syncCount;
+}
+
+static void write_file(char *path, const char *mode, const char *data, int size)
+{
+  STORFS_FILE file;
+
+  SMOKE_CHECK(storfs_fopen(&fs, path, mode, &file) == STORFS_OK);
+  SMOKE_CHECK(storfs_fputs(&fs, data, size, &file) == STORFS_OK);
+  SMOKE_CHECK(storfs_fclose(&fs, &file) == STORFS_OK);
+}
+
+//Reads a file within a single page with fgets and compares it to what was written
+static void check_file(char *path, const char *data, int size)
+{
+  STORFS_FILE file;
+
+  memset(readBuf, 0, size);
+  SMOKE_CHECK(storfs_fopen(&fs, path, "r", &file) == STORFS_OK);
+  SMOKE_CHECK(storfs_fgets(&fs, readBuf, size, &file) == STORFS_OK);
+  SMOKE_CHECK(storfs_fclose(&fs, &file) == STORFS_OK);
+  if(memcmp(readBuf, data, size) != 0)
+  {
+    printf("FAIL %s does not match what was written\n", path);
+    failCount++;
+  }
+}
+
+typedef struct
+{
+  const char *data;
+  uint32_t pos;
+} smoke_stream_t;
+
+static storfs_err_t smoke_producer(void *ctx, uint8_t *buffer, uint32_t size)
+{
+  smoke_stream_t *stream = ctx;
+
+  memcpy(buffer, stream->data + stream->pos, size);
+  stream->pos += size;
+
+  return STORFS_OK;
+}
+
+static storfs_err_t smoke_consumer(void *ctx, const uint8_t *buffer, uint32_t size)
+{
+  smoke_stream_t *stream = ctx;
+
+  if(memcmp(buffer, stream->data + stream->pos, size) != 0)
+  {
+    return STORFS_ERROR;
+  }
+  stream->pos += size;
+
+  return STORFS_OK;
+}
+
+//Reads a file of any size with fread_stream and compares it to what was written
+static void check_stream(char *path, const char *data, uint32_t size)
+{
+  STORFS_FILE file;
+  smoke_stream_t stream = {data, 0};
+
+  SMOKE_CHECK(storfs_fopen(&fs, path, "r", &file) == STORFS_OK);
+  SMOKE_CHECK(storfs_fread_stream(&fs, &file, smoke_consumer, &stream) == STORFS_OK);
+  SMOKE_CHECK(storfs_fclose(&fs, &file) == STORFS_OK);
+  if(stream.pos != size)
+  {
+    printf("FAIL %s read back %u of %u bytes\n", path, stream.pos, size);
+    failCount++;
+  }
+}
+
+//A small file and multi-page files within nested directories, read back after a remount
+static void smoke_files(void)
+{
+  STORFS_FILE file;
+
+  SMOKE_CHECK(storfs_mkdir(&fs, "C:/dir") == STORFS_OK);
+  SMOKE_CHECK(storfs_mkdir(&fs, "C:/dir/sub") == STORFS_OK);
+
+  SMOKE_CHECK(storfs_fopen(&fs, "C:/dir/a.txt", "w+", &file) == STORFS_OK);
+  SMOKE_CHECK(storfs_fputs(&fs, fileData, 100, &file) == STORFS_OK);
+  memset(readBuf, 0, 100);
+  SMOKE_CHECK(storfs_fgets(&fs, readBuf, 100, &file) == STORFS_OK);
+  SMOKE_CHECK(memcmp(readBuf, fileData, 100) == 0);
+  SMOKE_CHECK(storfs_fclose(&fs, &file) == STORFS_OK);
+
+  write_file("C:/dir/b.txt", "w+", fileData, 1500);
+  check_stream("C:/dir/b.txt", fileData, 1500);
+
+  //Lengths just past a page of data, whose size was once read back short
+  write_file("C:/dir/c.txt", "w", fileData + 1, 449);
+  write_file("C:/dir/d.txt", "w", fileData + 2, 456);
+
+  remount();
+  check_stream("C:/dir/b.txt", fileData, 1500);
+  check_stream("C:/dir/c.txt", fileData + 1, 449);
+  check_stream("C:/dir/d.txt", fileData + 2, 456);
+  check_file("C:/dir/a.txt", fileData, 100);
+  step_done("files");
+}
+
+//Twenty small files within one directory, then one of the earlier files is removed
+static void smoke_entries(void)
+{
+  STORFS_FILE file;
+  char path[64];
+
+  for(int i = 0; i < 20; i++)
+  {
+    sprintf(path, "C:/dir/sub/f%d.txt", i);
+    SMOKE_CHECK(storfs_touch(&fs, path) == STORFS_OK);
+  }
+  for(int i = 0; i < 20; i++)
+  {
+    sprintf(path, "C:/dir/sub/f%d.txt", i);
+    write_file(path, "w+", fileData + i, 40);
+  }
+  for(int i = 0; i < 20; i++)
+  {
+    sprintf(path, "C:/dir/sub/f%d.txt", i);
+    check_file(path, fileData + i, 40);
+  }
+  step_done("entries");
+
+  SMOKE_CHECK(storfs_rm(&fs, "C:/dir/a.txt", &file) == STORFS_OK);
+#ifdef STORFS_IDLE
+#ifdef STORFS_LAZY_DELETE
+  while(fs.cachedInfo.idleEraseCount)
+  {
+    SMOKE_CHECK(storfs_idle(&fs, 100) == STORFS_OK);
+  }
+#else
+  SMOKE_CHECK(storfs_idle(&fs, 100) == STORFS_OK);
+#endif
+#endif
+  check_stream("C:/dir/b.txt", fileData, 1500);
+  step_done("rm file");
+
+  for(int pass = 0; pass < 2; pass++)
+  {
+#ifdef STORFS_JOURNAL
+    //The second remount finds the journal already folded back into the headers
+    if(pass == 1)
+    {
+      SMOKE_CHECK(storfs_checkpoint(&fs) == STORFS_OK);
+    }
+#endif
+    remount();
+    for(int i = 0; i < 20; i++)
+    {
+      sprintf(path, "C:/dir/sub/f%d.txt", i);
+      check_file(path, fileData + i, 40);
+    }
+  }
+  step_done("remount");
+}
+
+//Removes a whole directory and fills the space it held with new files
+static void smoke_rm_dir(void)
+{
+  STORFS_FILE file;
+  char path[64];
+
+  SMOKE_CHECK(storfs_rm(&fs, "C:/dir/sub", &file) == STORFS_OK);
+  step_done("rm dir");
+
+  for(int i = 0; i < 20; i++)
+  {
+    sprintf(path, "C:/dir/n%d.txt", i);
+    write_file(path, "w+", fileData + i, 40);
+  }
+  for(int pass = 0; pass < 2; pass++)
+  {
+    if(pass == 1)
+    {
+      remount();
+    }
+    for(int i = 0; i < 20; i++)
+    {
+      sprintf(path, "C:/dir/n%d.txt", i);
+      check_file(path, fileData + i, 40);
+    }
+  }
+  check_stream("C:/dir/b.txt", fileData, 1500);
+  step_done("refill");
+}
+
+//Many empty directories, packed into shared pages with STORFS_METADATA_PACK
+static void smoke_directories(void)
+{
+  STORFS_FILE file;
+  char path[64];
+
+  SMOKE_CHECK(storfs_mkdir(&fs, "C:/m") == STORFS_OK);
+  for(int i = 0; i < 12; i++)
+  {
+    sprintf(path, "C:/m/d%d", i);
+    SMOKE_CHECK(storfs_mkdir(&fs, path) == STORFS_OK);
+  }
+  write_file("C:/m/d5/x.txt", "w+", fileData + 3, 30);
+  SMOKE_CHECK(storfs_rm(&fs, "C:/m/d3", &file) == STORFS_OK);
+  SMOKE_CHECK(storfs_rm(&fs, "C:/m/d0", &file) == STORFS_OK);
+  SMOKE_CHECK(storfs_rm(&fs, "C:/m/d11", &file) == STORFS_OK);
+  check_file("C:/m/d5/x.txt", fileData + 3, 30);
+
+  remount();
+  for(int i = 0; i < 4; i++)
+  {
+    sprintf(path, "C:/m/e%d", i);
+    SMOKE_CHECK(storfs_mkdir(&fs, path) == STORFS_OK);
+  }
+  write_file("C:/m/e2/y.txt", "w+", fileData + 7, 20);
+  check_file("C:/m/d5/x.txt", fileData + 3, 30);
+
+  remount();
+  check_file("C:/m/e2/y.txt", fileData + 7, 20);
+  check_file("C:/m/d5/x.txt", fileData + 3, 30);
+  check_file("C:/dir/n4.txt", fileData + 4, 40);
+  step_done("directories");
+}
+
+//A small file rewritten many times, held inline with STORFS_INLINE_FILES, then grown past the inline size
+static void smoke_rewrite(void)
+{
+  STORFS_FILE file;
+
+  for(int i = 0; i < 20; i++)
+  {
+    write_file("C:/m/s.txt", "w+", fileData + i, 16);
+  }
+  check_file("C:/m/s.txt", fileData + 19, 16);
+  remount();
+  check_file("C:/m/s.txt", fileData + 19, 16);
+  step_done("rewrite");
+
+#ifdef STORFS_INLINE_FILES
+  write_file("C:/m/s.txt", "a", fileData + 60, 10);
+  memset(readBuf, 0, 26);
+  SMOKE_CHECK(storfs_fopen(&fs, "C:/m/s.txt", "r", &file) == STORFS_OK);
+  SMOKE_CHECK(storfs_fgets(&fs, readBuf, 8, &file) == STORFS_OK);
+  SMOKE_CHECK(storfs_fgets(&fs, readBuf + 8, 18, &file) == STORFS_OK);
+  SMOKE_CHECK(memcmp(readBuf, fileData + 19, 16) == 0 && memcmp(readBuf + 16, fileData + 60, 10) == 0);
+  SMOKE_CHECK(storfs_fclose(&fs, &file) == STORFS_OK);
+  step_done("append");
+#endif
+
+  write_file("C:/m/s.txt", "w+", fileData + 100, 120);
+  check_file("C:/m/s.txt", fileData + 100, 120);
+  remount();
+  check_file("C:/m/s.txt", fileData + 100, 120);
+  SMOKE_CHECK(storfs_rm(&fs, "C:/m/s.txt", &file) == STORFS_OK);
+  check_file("C:/m/d5/x.txt", fileData + 3, 30);
+  step_done("grow");
+}
+
+//A file many pages long written from a producer and read back into a consumer
+static void smoke_stream(void)
+{
+  STORFS_FILE file;
+  smoke_stream_t stream = {fileData, 0};
+
+  SMOKE_CHECK(storfs_fopen(&fs, "C:/big.txt", "w", &file) == STORFS_OK);
+#ifdef STORFS_FALLOCATE
+  SMOKE_CHECK(storfs_fallocate(&fs, &file, SMOKE_DATA_SIZE) == STORFS_OK);
+  //Another file written in between must not take the reserved pages
+  write_file("C:/mid.txt", "w", fileData + 5, 1200);
+#if SMOKE_ERASE_PAGES > 1
+  //Linking the other file moves the header of this one, which keeps its reservation but must be opened again
+  SMOKE_CHECK(storfs_fopen(&fs, "C:/big.txt", "w", &file) == STORFS_OK);
+#endif
+#endif
+  SMOKE_CHECK(storfs_fwrite_stream(&fs, &file, SMOKE_DATA_SIZE, smoke_producer, &stream) == STORFS_OK);
+  SMOKE_CHECK(storfs_fclose(&fs, &file) == STORFS_OK);
+  check_stream("C:/big.txt", fileData, SMOKE_DATA_SIZE);
+#ifdef STORFS_FALLOCATE
+  check_stream("C:/mid.txt", fileData + 5, 1200);
+#endif
+  remount();
+  check_stream("C:/big.txt", fileData, SMOKE_DATA_SIZE);
+  step_done("stream");
+}
+
+//Files of every length from within a single page to many pages, each read back whole
+static void smoke_sizes(void)
+{
+  STORFS_FILE file;
+
+  for(int size = 1; size <= 6000; size += 7)
+  {
+    write_file("C:/size.txt", "w", fileData, size);
+    check_stream("C:/size.txt", fileData, size);
+  }
+  SMOKE_CHECK(storfs_rm(&fs, "C:/size.txt", &file) == STORFS_OK);
+  step_done("sizes");
+}
+
+#ifdef STORFS_JOURNAL
+//Changes made within a transaction are lost entirely if power is cut before the commit
+static void smoke_transaction(void)
+{
+  STORFS_FILE file;
+  char path[32];
+
+  SMOKE_CHECK(storfs_begin(&fs) == STORFS_OK);
+  SMOKE_CHECK(storfs_mkdir(&fs, "C:/t") == STORFS_OK);
+  for(int i = 0; i < 4; i++)
+  {
+    sprintf(path, "C:/t/t%d", i);
+    write_file(path, "w", path, 8);
+  }
+
+  //Power is cut before the commit, none of the files may be found
+  remount();
+  for(int i = 0; i < 4; i++)
+  {
+    sprintf(path, "C:/t/t%d", i);
+    memset(readBuf, 0, 8);
+    if(storfs_fopen(&fs, path, "r", &file) == STORFS_OK)
+    {
+      if(storfs_fgets(&fs, readBuf, 8, &file) == STORFS_OK)
+      {
+        SMOKE_CHECK(strcmp(readBuf, path) != 0);
+      }
+      SMOKE_CHECK(storfs_fclose(&fs, &file) == STORFS_OK);
+    }
+  }
+  check_stream("C:/big.txt", fileData, SMOKE_DATA_SIZE);
+
+  SMOKE_CHECK(storfs_begin(&fs) == STORFS_OK);
+  SMOKE_CHECK(storfs_mkdir(&fs, "C:/u") == STORFS_OK);
+  for(int i = 0; i < 4; i++)
+  {
+    sprintf(path, "C:/u/u%d", i);
+    write_file(path, "w", path, 8);
+  }
+  SMOKE_CHECK(storfs_commit(&fs) == STORFS_OK);
+
+  remount();
+  for(int i = 0; i < 4; i++)
+  {
+    sprintf(path, "C:/u/u%d", i);
+    check_file(path, path, 8);
+  }
+  step_done("transaction");
+}
+#endif
+
+#ifdef STORFS_ASYNC
+static void smoke_async_done(storfs_t *storfsInst, storfs_async_t *handle)
+{
+  SMOKE_CHECK(handle->status == STORFS_OK);
+}
+
+static void smoke_async_run(void)
+{
+  int polls = 0;
+
+  while(fs.cachedInfo.asyncHead != NULL && polls < 100)
+  {
+    SMOKE_CHECK(storfs_poll(&fs) == STORFS_OK);
+    polls++;
+  }
+  SMOKE_CHECK(fs.cachedInfo.asyncHead == NULL);
+}
+
+//A multi-page write queued and carried out one page per poll, then rewritten while other writes are refused
+static void smoke_async(void)
+{
+  STORFS_FILE file;
+  storfs_async_t openHandle, writeHandle, rmHandle;
+
+  memset(&openHandle, 0, sizeof(openHandle));
+  memset(&writeHandle, 0, sizeof(writeHandle));
+  memset(&rmHandle, 0, sizeof(rmHandle));
+  SMOKE_CHECK(storfs_fopen_async(&fs, "C:/async.txt", "w", &file, &openHandle, smoke_async_done) == STORFS_OK);
+  SMOKE_CHECK(storfs_fputs_async(&fs, fileData, 3000, &file, &writeHandle, smoke_async_done) == STORFS_OK);
+  smoke_async_run();
+  SMOKE_CHECK(storfs_fclose(&fs, &file) == STORFS_OK);
+  check_stream("C:/async.txt", fileData, 3000);
+
+  SMOKE_CHECK(storfs_fopen_async(&fs, "C:/async.txt", "w", &file, &openHandle, smoke_async_done) == STORFS_OK);
+  SMOKE_CHECK(storfs_fputs_async(&fs, fileData + 7, 2000, &file, &writeHandle, smoke_async_done) == STORFS_OK);
+  while(fs.cachedInfo.asyncHead != NULL && fs.cachedInfo.asyncWrite == NULL)
+  {
+    SMOKE_CHECK(storfs_poll(&fs) == STORFS_OK);
+  }
+  SMOKE_CHECK(fs.cachedInfo.asyncHead == &writeHandle);
+  SMOKE_CHECK(storfs_touch(&fs, "C:/async2.txt") != STORFS_OK);
+  smoke_async_run();
+  SMOKE_CHECK(storfs_fclose(&fs, &file) == STORFS_OK);
+  check_stream("C:/async.txt", fileData + 7, 2000);
+
+  SMOKE_CHECK(storfs_rm_async(&fs, "C:/async.txt", NULL, &rmHandle, smoke_async_done) == STORFS_OK);
+  smoke_async_run();
+  SMOKE_CHECK(storfs_fopen(&fs, "C:/async.txt", "r", &file) == STORFS_OK);
+  SMOKE_CHECK(file.fileInfo.fileSize <= STORFS_HEADER_TOTAL_SIZE);
+  SMOKE_CHECK(storfs_fclose(&fs, &file) == STORFS_OK);
+  write_file("C:/async.txt", "w", fileData, 3000);
+  check_stream("C:/async.txt", fileData, 3000);
+  step_done("async");
+}
+#endif
+
+int main(void)
+{
+  memset(memorySim, 0xFF, sizeof(memorySim));
+#ifdef STORFS_SPARE_HEADERS
+  memset(spareSim, 0xFF, sizeof(spareSim));
+#endif
+  for(int i = 0; i < SMOKE_DATA_SIZE; i++)
+  {
+    fileData[i] = 'a' + (i * 7) % 26;
+  }
+
+  power_on();
+  SMOKE_CHECK(storfs_mount(&fs, "C:") == STORFS_OK);
+  SMOKE_CHECK(storfs_mount(&fs, "") == STORFS_OK);
+  step_done("mount");
+
+  smoke_files();
+  smoke_entries();
+  smoke_rm_dir();
+  smoke_directories();
+  smoke_rewrite();
+  smoke_stream();
+  smoke_sizes();
+#ifdef STORFS_JOURNAL
+  smoke_transaction();
+#endif
+#ifdef STORFS_ASYNC
+  smoke_async();
+#endif
+
+#ifdef STORFS_BAD_BLOCK_TABLE
+  printf("bad blocks=%d\n", fs.cachedInfo.badBlockCount);
+#endif
+#ifdef STORFS_WORK_BUF
+  printf("work buffer peak=%ld\n", (long)fs.cachedInfo.workBufPeak);
+#endif
+  printf("total        erase=%ld write=%ld read=%ld sync=%ld\n", eraseCount, writeCount, readCount, syncCount);
+  printf(failCount ? "SMOKE FAILED %ld\n" : "SMOKE OK\n", failCount);
+
+  return failCount != 0;
+}
@@ -0,0 +1,18 @@
+#ifndef __STORFS_CONFIG_H
+#define __STORFS_CONFIG_H
+
+#include <stdio.h>
+
+//#define  STORFS_MAX_FILE_NAME                 22
+
+#define STORFS_NO_LOG
+//#define STORFS_USE_LOGI
+    //#define LOGI
+//#define STORFS_USE_LOGW
+    //#define LOGW
+//#define STORFS_USE_LOGE
+    //#define LOGE
+
+//#define STORFS_LOG_DISPLAY_HEADER
+
+#endif
@@ -0,0 +1,249 @@
+#define _GNU_SOURCE
+#include "storfs.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define PAGESIZE 512
+#define PAGECOUNT 8192
+uint8_t memorySim[PAGESIZE * PAGECOUNT];
+
+#define READER_NUM      4
+#define READER_SIZE     300
+#define WRITER_FILES    32
+#define WRITER_SIZE     200
+#define RUN_TIME_SEC    2
+
+//Simulated time taken by the device for every read/write/erase in nanoseconds
+#define DEVICE_DELAY_NS 2000
+
+static pthread_rwlock_t fsLock;
+static int globalLock;
+static atomic_int running;
+static char fileData[READER_SIZE + WRITER_SIZE];
+
+static void device_delay(void)
+{
+  struct timespec start, now;
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  do
+  {
+    clock_gettime(CLOCK_MONOTONIC, &now);
+  } while(((now.tv_sec - start.tv_sec) * 1000000000L + (now.tv_nsec - start.tv_nsec)) < DEVICE_DELAY_NS);
+}
+
+storfs_err_t storfs_read(const struct storfs *storfsInst, storfs_page_t page,
+            storfs_byte_t byte, uint8_t *buffer, storfs_size_t size)
+{
+  if((byte + size) > PAGESIZE || page >= PAGECOUNT)
+  {
+    return STORFS_ERROR;
+  }
+  device_delay();
+  memcpy(buffer, &memorySim[(PAGESIZE * page) + byte], size);
+
+  return STORFS_OK;
+}
+
+storfs_err_t storfs_write(const struct storfs *storfsInst, storfs_page_t page,
+            storfs_byte_t byte, uint8_t *buffer, storfs_size_t size)
+{
+  if((byte + size) > PAGESIZE || page >= PAGECOUNT)
+  {
+    return STORFS_ERROR;
+  }
+  device_delay();
+  memcpy(&memorySim[(PAGESIZE * page) + byte], buffer, size);
+
+  return STORFS_OK;
+}
+
+storfs_err_t storfs_erase(const struct storfs *storfsInst, storfs_page_t page)
+{
+  if(page >= PAGECOUNT)
+  {
+    return STORFS_ERROR;
+  }
+  device_delay();
+  memset(&memorySim[PAGESIZE * page], 0xFF, PAGESIZE);
+
+  return STORFS_OK;
+}
+
+storfs_err_t storfs_sync(const struct storfs *storfsInst)
+{
+  return STORFS_OK;
+}
+
+//Reader/writer lock, when globalLock is set every call takes the lock exclusively
+storfs_err_t storfs_lock(const struct storfs *storfsInst, storfs_lock_t lockType)
+{
+  if(lockType == STORFS_LOCK_SHARED && !globalLock)
+  {
+    return pthread_rwlock_rdlock(&fsLock) == 0 ? STORFS_OK : STORFS_ERROR;
+  }
+  return pthread_rwlock_wrlock(&fsLock) == 0 ? STORFS_OK : STORFS_ERROR;
+}
+
+storfs_err_t storfs_unlock(const struct storfs *storfsInst, storfs_lock_t lockType)
+{
+  return pthread_rwlock_unlock(&fsLock) == 0 ? STORFS_OK : STORFS_ERROR;
+}
+
+storfs_t fs = {
+  .read = storfs_read,
+  .write = storfs_write,
+  .erase = storfs_erase,
+  .sync = storfs_sync,
+  .lock = storfs_lock,
+  .unlock = storfs_unlock,
+  .memInst = NULL,
+  .firstPageLoc = 20,
+  .firstByteLoc = 0,
+  .pageSize = PAGESIZE,
+  .pageCount = PAGECOUNT,
+};
+
+typedef struct {
+  int id;
+  long ops;
+  long errors;
+} thread_info_t;
+
+static void *reader_thread(void *arg)
+{
+  thread_info_t *info = arg;
+  STORFS_FILE file;
+  char path[64];
+  char buffer[READER_SIZE];
+
+  sprintf(path, "C:/read/r%d.txt", info->id);
+  if(storfs_fopen(&fs, path, "r", &file) != STORFS_OK)
+  {
+    info->errors++;
+    return NULL;
+  }
+
+  //Read the whole file over and over, ensuring it is never disturbed by the writer
+  while(running)
+  {
+    storfs_rewind(&fs, &file);
+    memset(buffer, 0, sizeof(buffer));
+    if(storfs_fgets(&fs, buffer, READER_SIZE, &file) != STORFS_OK || memcmp(buffer, fileData + info->id, READER_SIZE) != 0)
+    {
+      info->errors++;
+    }
+    info->ops++;
+  }
+  storfs_fclose(&fs, &file);
+
+  return NULL;
+}
+
+static void *writer_thread(void *arg)
+{
+  thread_info_t *info = arg;
+  STORFS_FILE file;
+  char path[64];
+
+  //Continuously create and rewrite files in a separate directory
+  for(int i = 0; running; i++)
+  {
+    sprintf(path, "C:/write/w%d.txt", i % WRITER_FILES);
+    if(storfs_fopen(&fs, path, "w", &file) != STORFS_OK || storfs_fputs(&fs, fileData + (i % 64), WRITER_SIZE, &file) != STORFS_OK)
+    {
+      info->errors++;
+    }
+    storfs_fclose(&fs, &file);
+    info->ops++;
+  }
+
+  return NULL;
+}
+
+static int run_test(int useGlobalLock)
+{
+  pthread_t readers[READER_NUM], writer;
+  thread_info_t readerInfo[READER_NUM], writerInfo = {0};
+  STORFS_FILE file;
+  char path[64];
+  long totalReads = 0, totalErrors = 0;
+
+  memset(memorySim, 0xFF, sizeof(memorySim));
+  globalLock = useGlobalLock;
+
+  if(storfs_mount(&fs, "C:") != STORFS_OK || storfs_mkdir(&fs, "C:/read") != STORFS_OK || storfs_mkdir(&fs, "C:/write") != STORFS_OK)
+  {
+    printf("Failed to create the file system\n");
+    return 1;
+  }
+
+  //Each reader has its own file
+  for(int i = 0; i < READER_NUM; i++)
+  {
+    sprintf(path, "C:/read/r%d.txt", i);
+    if(storfs_fopen(&fs, path, "w", &file) != STORFS_OK || storfs_fputs(&fs, fileData + i, READER_SIZE, &file) != STORFS_OK)
+    {
+      printf("Failed to create %s\n", path);
+      return 1;
+    }
+    storfs_fclose(&fs, &file);
+  }
+
+  running = 1;
+  for(int i = 0; i < READER_NUM; i++)
+  {
+    readerInfo[i].id = i;
+    readerInfo[i].ops = 0;
+    readerInfo[i].errors = 0;
+    pthread_create(&readers[i], NULL, reader_thread, &readerInfo[i]);
+  }
+  pthread_create(&writer, NULL, writer_thread, &writerInfo);
+
+  struct timespec runTime = {RUN_TIME_SEC, 0};
+  nanosleep(&runTime, NULL);
+  running = 0;
+
+  for(int i = 0; i < READER_NUM; i++)
+  {
+    pthread_join(readers[i], NULL);
+    totalReads += readerInfo[i].ops;
+    totalErrors += readerInfo[i].errors;
+  }
+  pthread_join(writer, NULL);
+  totalErrors += writerInfo.errors;
+
+  printf("%-14s %d readers: %8.1f reads/s, writer: %8.1f writes/s, errors: %ld\n", useGlobalLock ? "Global lock" : "Shared readers",
+          READER_NUM, (double)totalReads / RUN_TIME_SEC, (double)writerInfo.ops / RUN_TIME_SEC, totalErrors);
+
+  return totalErrors != 0;
+}
+
+int main(void)
+{
+  int status = 0;
+  pthread_rwlockattr_t lockAttr;
+
+  for(int i = 0; i < sizeof(fileData); i++)
+  {
+    fileData[i] = 33 + (i % 94);
+  }
+
+  //Prefer the writer so that it is not starved by the readers
+  pthread_rwlockattr_init(&lockAttr);
+  pthread_rwlockattr_setkind_np(&lockAttr, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+  pthread_rwlock_init(&fsLock, &lockAttr);
+
+  //Compare every call taking the lock exclusively against readers sharing the lock
+  status |= run_test(1);
+  status |= run_test(0);
+
+  pthread_rwlock_destroy(&fsLock);
+
+  return status;
+}
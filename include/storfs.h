@@ -28,6 +28,139 @@
     #define STORFS_MAX_FILE_NAME  4
 #endif
 
+/** @brief Number of times a page is re-programmed before wear-levelling moves the data elsewhere */
+#ifndef STORFS_WEAR_LEVEL_RETRY_NUM
+    #define STORFS_WEAR_LEVEL_RETRY_NUM  3
+#endif
+
+/** @brief Maximum number of bad pages held in the bad block table, two copies of the table occupy the
+ *  pages following the second root header when STORFS_BAD_BLOCK_TABLE is defined, the default of 31
+ *  entries (2 + 2 + 31 * 8 + 2 = 254 bytes) fits within a 256 byte page */
+#ifdef STORFS_BAD_BLOCK_TABLE
+    #ifndef STORFS_BAD_BLOCK_TABLE_SIZE
+        #define STORFS_BAD_BLOCK_TABLE_SIZE  31
+    #endif
+#endif
+
+/** @brief Maximum number of logical pages that may be remapped onto spare pages, the map occupies the
+ *  page following the root headers (and bad block tables) when STORFS_L2P_MAP is defined, the default
+ *  of 15 entries (2 + 15 * 16 + 2 = 244 bytes) fits within a 256 byte page */
+#ifdef STORFS_L2P_MAP
+    #ifndef STORFS_L2P_MAP_SIZE
+        #define STORFS_L2P_MAP_SIZE  15
+    #endif
+    #ifndef STORFS_L2P_SPARE_PAGES
+        #define STORFS_L2P_SPARE_PAGES  STORFS_L2P_MAP_SIZE
+    #endif
+#endif
+
+/** @brief Number of pages used by the metadata journal and the maximum number of link updates held
+ *  before the journal is checkpointed into the tree when STORFS_JOURNAL is defined */
+#ifdef STORFS_JOURNAL
+    #ifndef STORFS_JOURNAL_PAGES
+        #define STORFS_JOURNAL_PAGES  2
+    #endif
+    #ifndef STORFS_JOURNAL_ENTRIES
+        #define STORFS_JOURNAL_ENTRIES  16
+    #endif
+#endif
+
+/** @brief Maximum number of removed pages waiting to be erased by storfs_idle when STORFS_IDLE and STORFS_LAZY_DELETE are defined */
+#ifdef STORFS_IDLE
+    #ifndef STORFS_IDLE_ERASE_PAGES
+        #define STORFS_IDLE_ERASE_PAGES  32
+    #endif
+#endif
+
+/** @brief Maximum number of freed pages a queued operation leaves to be erased by the following calls to storfs_poll
+ *  when STORFS_ASYNC is defined without STORFS_LAZY_DELETE, pages freed past it are erased straight away */
+#ifdef STORFS_ASYNC
+    #ifndef STORFS_ASYNC_ERASE_PAGES
+        #define STORFS_ASYNC_ERASE_PAGES  32
+    #endif
+#endif
+
+/** @brief Maximum number of erased pages held ready for allocation when STORFS_ERASE_POOL is defined */
+#ifdef STORFS_ERASE_POOL
+    #ifndef STORFS_ERASE_POOL_PAGES
+        #define STORFS_ERASE_POOL_PAGES  8
+    #endif
+#endif
+
+/** @brief Size of the static pool used as the work buffer of instances without a workBuf of their own when STORFS_WORK_BUF
+ *  is defined, 0 for no pool */
+#ifdef STORFS_WORK_BUF
+    #ifndef STORFS_WORK_BUF_SIZE
+        #define STORFS_WORK_BUF_SIZE  0
+    #endif
+#endif
+
+/** @brief Number of headers held in memory between calls when STORFS_OPEN_FILE_TABLE is defined, an open stream uses one
+ *  for its file header and one for the page it is reading, once the table is full its entries are replaced in turn */
+#ifdef STORFS_OPEN_FILE_TABLE
+    #ifndef STORFS_OPEN_FILES
+        #define STORFS_OPEN_FILES  4
+    #endif
+#endif
+
+/** @brief Maximum number of files holding pages reserved by storfs_fallocate when STORFS_FALLOCATE is defined, the pages
+ *  are reserved as a run found in the same way as STORFS_EXTENT_ALLOC, which is defined as well */
+#ifdef STORFS_FALLOCATE
+    #ifndef STORFS_EXTENT_ALLOC
+        #define STORFS_EXTENT_ALLOC
+    #endif
+    #ifndef STORFS_FALLOCATE_FILES
+        #define STORFS_FALLOCATE_FILES  2
+    #endif
+#endif
+
+/** @brief Maximum number of pages passed over while searching for a run of free pages to hold every fragment of a write
+ *  when STORFS_EXTENT_ALLOC is defined, the fragments are allocated one at a time once it is reached */
+#ifdef STORFS_EXTENT_ALLOC
+    #ifndef STORFS_EXTENT_SCAN_PAGES
+        #define STORFS_EXTENT_SCAN_PAGES  256
+    #endif
+#endif
+
+/** @brief Page size as a power of two and page count of the storage device fixed at compile time, pageSize and pageCount
+ *  within storfs_t must hold the same values, STORFS_PAGE_SIZE may be used to size the buffers of the application */
+#ifdef STORFS_PAGE_SIZE_LOG2
+    #define STORFS_PAGE_SIZE  (1UL << STORFS_PAGE_SIZE_LOG2)
+    #ifdef STORFS_SPARE_HEADERS
+        #error "STORFS_PAGE_SIZE_LOG2 cannot be used with STORFS_SPARE_HEADERS, the page size includes the spare area"
+    #endif
+#endif
+
+/** @brief The data of a file is passed to the writev callback apart from its header when STORFS_WRITEV is defined, fragment
+ *  headers held within the spare area are already written apart from the data of their page */
+#ifdef STORFS_WRITEV
+    #ifdef STORFS_SPARE_HEADERS
+        #error "STORFS_WRITEV cannot be used with STORFS_SPARE_HEADERS, the header is already written to the spare area"
+    #endif
+#endif
+
+/** @brief Largest file held within a metadata page and the number of versions appended before its header is
+ *  rewritten when STORFS_INLINE_FILES is defined, a version must fit within the space of a single header */
+#ifdef STORFS_INLINE_FILES
+    #ifndef STORFS_METADATA_PACK
+        #define STORFS_METADATA_PACK
+    #endif
+    #ifdef STORFS_COMPACT_LINKS
+        #define STORFS_INLINE_FILE_MAX  44
+    #else
+        #define STORFS_INLINE_FILE_MAX  52
+    #endif
+    #ifndef STORFS_INLINE_FILE_SIZE
+        #define STORFS_INLINE_FILE_SIZE  STORFS_INLINE_FILE_MAX
+    #elif STORFS_INLINE_FILE_SIZE > STORFS_INLINE_FILE_MAX
+        #undef STORFS_INLINE_FILE_SIZE
+        #define STORFS_INLINE_FILE_SIZE  STORFS_INLINE_FILE_MAX
+    #endif
+    #ifndef STORFS_INLINE_VERSIONS
+        #define STORFS_INLINE_VERSIONS  8
+    #endif
+#endif
+
 /** @brief STORFS_LOGging defines for serial output/display functionality */
 #ifndef STORFS_NO_LOG
     #ifndef STORFS_LOGI
@@ -54,10 +187,17 @@
 #endif
 
 #define STORFS_INFO_REG_SIZE                                1
-#define STORFS_CHILD_DIR_REG_SIZE                           8
-#define STORFS_SIBLING_DIR_SIZE                             8
+#ifdef STORFS_COMPACT_LINKS
+    //Locations are held in 32 bits within headers, the storage device may hold up to 4GB
+    #define STORFS_CHILD_DIR_REG_SIZE                       4
+    #define STORFS_SIBLING_DIR_SIZE                         4
+    #define STORFS_FRAGMENT_LOC_SIZE                        4
+#else
+    #define STORFS_CHILD_DIR_REG_SIZE                       8
+    #define STORFS_SIBLING_DIR_SIZE                         8
+    #define STORFS_FRAGMENT_LOC_SIZE                        8
+#endif
 #define STORFS_RESERVED_SIZE                                2
-#define STORFS_FRAGMENT_LOC_SIZE                            8
 #define STORFS_FILE_SIZE                                    4
 #define STORFS_CRC_SIZE                                     2
 #define STORFS_HEADER_TOTAL_SIZE                            (STORFS_INFO_REG_SIZE + STORFS_CHILD_DIR_REG_SIZE + \
@@ -67,6 +207,74 @@
 #define STORFS_FRAGMENT_HEADER_TOTAL_SIZE                   (STORFS_INFO_REG_SIZE + STORFS_RESERVED_SIZE + \
                                                             STORFS_FRAGMENT_LOC_SIZE + STORFS_CRC_SIZE)
 
+/** @brief Format version held within the reserved register of the root, an erased value marks the original layout
+ *  each option changing what is held on the device clears a bit of the low byte, the high byte holds the low bits of
+ *  the journal and spare page counts, so an image is only mounted with the options it was formatted with */
+#ifdef STORFS_COMPACT_LINKS
+    #define STORFS_FORMAT_COMPACT_LINKS                     0x0001
+#else
+    #define STORFS_FORMAT_COMPACT_LINKS                     0
+#endif
+#ifdef STORFS_LAZY_DELETE
+    #define STORFS_FORMAT_LAZY_DELETE                       0x0002
+#else
+    #define STORFS_FORMAT_LAZY_DELETE                       0
+#endif
+#ifdef STORFS_BAD_BLOCK_TABLE
+    #define STORFS_FORMAT_BAD_BLOCK_TABLE                   0x0004
+#else
+    #define STORFS_FORMAT_BAD_BLOCK_TABLE                   0
+#endif
+#ifdef STORFS_L2P_MAP
+    #define STORFS_FORMAT_L2P_MAP                           (0x0008 | ((STORFS_L2P_SPARE_PAGES & 0x0F) << 12))
+#else
+    #define STORFS_FORMAT_L2P_MAP                           0
+#endif
+#ifdef STORFS_JOURNAL
+    #define STORFS_FORMAT_JOURNAL                           (0x0010 | ((STORFS_JOURNAL_PAGES & 0x0F) << 8))
+#else
+    #define STORFS_FORMAT_JOURNAL                           0
+#endif
+#ifdef STORFS_METADATA_PACK
+    #define STORFS_FORMAT_METADATA_PACK                     0x0020
+#else
+    #define STORFS_FORMAT_METADATA_PACK                     0
+#endif
+#ifdef STORFS_INLINE_FILES
+    #define STORFS_FORMAT_INLINE_FILES                      0x0040
+#else
+    #define STORFS_FORMAT_INLINE_FILES                      0
+#endif
+#ifdef STORFS_SPARE_HEADERS
+    #define STORFS_FORMAT_SPARE_HEADERS                     0x0080
+#else
+    #define STORFS_FORMAT_SPARE_HEADERS                     0
+#endif
+#define STORFS_FORMAT_VERSION                               ((uint16_t)~(STORFS_FORMAT_COMPACT_LINKS | STORFS_FORMAT_LAZY_DELETE | \
+                                                            STORFS_FORMAT_BAD_BLOCK_TABLE | STORFS_FORMAT_L2P_MAP | \
+                                                            STORFS_FORMAT_JOURNAL | STORFS_FORMAT_METADATA_PACK | \
+                                                            STORFS_FORMAT_INLINE_FILES | STORFS_FORMAT_SPARE_HEADERS))
+
+/** @brief Bad block table layout: entry count, sequence number, page entries and a CRC over all three */
+#define STORFS_BAD_BLOCK_COUNT_SIZE                         2
+#define STORFS_BAD_BLOCK_SEQUENCE_SIZE                      2
+#define STORFS_BAD_BLOCK_ENTRY_SIZE                         8
+#define STORFS_BAD_BLOCK_TABLE_TOTAL_SIZE(entries)          (STORFS_BAD_BLOCK_COUNT_SIZE + STORFS_BAD_BLOCK_SEQUENCE_SIZE + \
+                                                            ((entries) * STORFS_BAD_BLOCK_ENTRY_SIZE) + STORFS_CRC_SIZE)
+
+/** @brief Logical to physical map layout: entry count, logical/physical page pairs and a CRC over both */
+#define STORFS_L2P_COUNT_SIZE                               2
+#define STORFS_L2P_ENTRY_SIZE                               16
+#define STORFS_L2P_MAP_TOTAL_SIZE(entries)                  (STORFS_L2P_COUNT_SIZE + \
+                                                            ((entries) * STORFS_L2P_ENTRY_SIZE) + STORFS_CRC_SIZE)
+
+/** @brief Journal record layout: record type, header location, new value and a CRC over all */
+#define STORFS_JOURNAL_TYPE_SIZE                            1
+#define STORFS_JOURNAL_LOC_SIZE                             8
+#define STORFS_JOURNAL_VALUE_SIZE                           8
+#define STORFS_JOURNAL_RECORD_SIZE                          (STORFS_JOURNAL_TYPE_SIZE + STORFS_JOURNAL_LOC_SIZE + \
+                                                            STORFS_JOURNAL_VALUE_SIZE + STORFS_CRC_SIZE)
+
 /** @brief File Info Register Bit Definitions */
 #define STORFS_INFO_REG_NOT_FRAGMENT_BIT                    (0X1 << 7)
 #define STORFS_INFO_REG_BLOCK_SIGN_EMPTY                    (0X3 << 5)
@@ -76,6 +284,8 @@
 #define STORFS_INFO_REG_FILE_TYPE_DIRECTORY                 (0X2 << 2)
 #define STORFS_INFO_REG_FILE_TYPE_ROOT                      (0X1 << 2)
 #define STORFS_INFO_REG_FILE_TYPE_FILE_FRAGMENT             (0X0 << 2)
+#define STORFS_INFO_REG_INLINE_BIT                          (0X1 << 4)
+#define STORFS_INFO_REG_VALID_BIT                           (0X1 << 1)
 
 
 /** @brief Alias for size in bytes of items */ 
@@ -109,6 +319,19 @@ typedef enum {
     STORFS_CRC_ERR,
 } storfs_err_t;
 
+/** @brief Lock types passed to the lock and unlock callbacks */ 
+typedef enum {
+    STORFS_LOCK_SHARED = 0x0UL,
+    STORFS_LOCK_EXCLUSIVE,
+} storfs_lock_t;
+
+/** @brief Operation left outstanding on the storage device, passed to the waitReady callback */ 
+typedef enum {
+    STORFS_BUSY_NONE = 0x0UL,
+    STORFS_BUSY_PROGRAM,
+    STORFS_BUSY_ERASE,
+} storfs_busy_t;
+
 /** @brief Location struct for the specific page and byte in that page to read/write to/from */ 
 typedef struct {
     storfs_page_t pageLoc;
@@ -127,12 +350,95 @@ typedef struct {
     storfs_crc_t crc;
 } storfs_file_header_t;
 
+/** @brief Header link update held within the journal until it is checkpointed */ 
+typedef struct
+{
+    storfs_size_t location;
+    storfs_size_t value;
+    uint8_t type;
+} storfs_journal_entry_t;
+
+/** @brief Copy of the header at location held within the open file table, dropped once its page is programmed or erased */ 
+typedef struct
+{
+    storfs_loc_t location;
+    storfs_file_header_t info;
+    uint8_t valid;
+} storfs_open_file_t;
+
+/** @brief Run of pages reserved by storfs_fallocate for the file whose header is held in filePage */ 
+typedef struct
+{
+    storfs_page_t filePage;
+    storfs_page_t page;
+    storfs_size_t pageNum;
+} storfs_falloc_t;
+
 /** @brief "Cache" for items in the current filesystem instance */ 
 typedef struct 
 {
     storfs_file_header_t rootHeaderInfo[2];
     storfs_page_t nextOpenByte;
     storfs_loc_t rootLocation[2];
+#ifdef STORFS_BAD_BLOCK_TABLE
+    storfs_page_t badBlockTable[STORFS_BAD_BLOCK_TABLE_SIZE];
+    uint16_t badBlockCount;
+    uint16_t badBlockSequence;
+    uint8_t badBlockCurrent;
+    storfs_page_t badBlockLocation[2];
+#endif
+#ifdef STORFS_L2P_MAP
+    storfs_page_t l2pLogical[STORFS_L2P_MAP_SIZE];
+    storfs_page_t l2pPhysical[STORFS_L2P_MAP_SIZE];
+    uint16_t l2pCount;
+    storfs_page_t l2pNextSpare;
+    storfs_page_t l2pLocation;
+#endif
+#ifdef STORFS_JOURNAL
+    storfs_journal_entry_t journalEntries[STORFS_JOURNAL_ENTRIES];
+    uint16_t journalCount;
+    storfs_page_t journalLocation;
+    storfs_loc_t journalHead;
+    uint8_t journalTransaction;
+#endif
+#if defined(STORFS_IDLE) && defined(STORFS_LAZY_DELETE)
+    storfs_page_t idleErasePages[STORFS_IDLE_ERASE_PAGES];
+    uint16_t idleEraseCount;
+#endif
+#ifdef STORFS_ERASE_POOL
+    storfs_page_t erasePool[STORFS_ERASE_POOL_PAGES];
+    uint16_t erasePoolCount;
+    storfs_page_t erasePoolScan;
+#endif
+#ifdef STORFS_METADATA_PACK
+    storfs_loc_t metaLoc;
+#endif
+#ifdef STORFS_WORK_BUF
+    storfs_size_t workBufUsed;
+    storfs_size_t workBufPeak;
+#endif
+    storfs_page_t dataPageLoc;
+#ifdef STORFS_ASYNC
+    struct storfs_async *asyncHead;
+    struct storfs_async *asyncTail;
+    struct storfs_async *asyncWrite;
+#ifndef STORFS_LAZY_DELETE
+    uint8_t asyncDefer;
+    storfs_page_t asyncErasePages[STORFS_ASYNC_ERASE_PAGES];
+    uint16_t asyncEraseCount;
+#endif
+#endif
+#ifdef STORFS_OPEN_FILE_TABLE
+    storfs_open_file_t openFiles[STORFS_OPEN_FILES];
+    uint8_t openFileNext;
+#endif
+#ifdef STORFS_LAZY_SYNC
+    storfs_busy_t deviceBusy;
+#endif
+#ifdef STORFS_FALLOCATE
+    storfs_falloc_t fallocFiles[STORFS_FALLOCATE_FILES];
+    uint16_t fallocCount;
+#endif
 } storfs_cached_info_t;
 
 /** @brief Filesystem Configuration */
@@ -207,9 +513,120 @@ typedef struct storfs{
 #endif
 
 #ifdef STORFS_THREADSAFE
-    int (*lock)(const struct storfs_t *storfsInst);
+    /**
+     * @brief       Lock Callback
+     *              Callback to take a reader/writer lock, shared locks may be held by multiple threads at once
+     *              while an exclusive lock must be held by a single thread
+     *              
+     * @param       storfsInst  Instance used for the STORfs
+     * @param       lockType    STORFS_LOCK_SHARED or STORFS_LOCK_EXCLUSIVE
+     * @return      STORFS_OK   Succeed
+     */
+    storfs_err_t (*lock)(const struct storfs *storfsInst, storfs_lock_t lockType);
 
-    int (*unlock)(const struct storfs_t *storfsInst);
+    /**
+     * @brief       Unlock Callback
+     *              Callback to release the lock taken with the same lock type
+     *              
+     * @param       storfsInst  Instance used for the STORfs
+     * @param       lockType    STORFS_LOCK_SHARED or STORFS_LOCK_EXCLUSIVE
+     * @return      STORFS_OK   Succeed
+     */
+    storfs_err_t (*unlock)(const struct storfs *storfsInst, storfs_lock_t lockType);
+#endif
+
+#ifdef STORFS_IDLE
+    /**
+     * @brief       Time Callback
+     *              Callback used by storfs_idle to keep within its time budget
+     *
+     * @attention   May be NULL, storfs_idle then performs a single piece of work per call
+     *              
+     * @param       storfsInst  Instance used for the STORfs
+     * @return      Free running time in microseconds, it may wrap around
+     */
+    uint32_t (*time)(const struct storfs *storfsInst);
+#endif
+
+#ifdef STORFS_ASYNC
+    /**
+     * @brief       Ready Callback
+     *              Callback used by storfs_poll to determine if the device is able to accept the next operation
+     *
+     * @attention   May be NULL if the device is always ready
+     *              
+     * @param       storfsInst  Instance used for the STORfs
+     * @return      STORFS_OK   Device is ready
+     */
+    storfs_err_t (*ready)(const struct storfs *storfsInst);
+#endif
+
+#ifdef STORFS_LAZY_SYNC
+    /**
+     * @brief       Wait Ready Callback
+     *              Callback used in place of sync to wait for the program or erase left outstanding on the device
+     *
+     * @attention   May be NULL, sync is then called for both operations
+     *              
+     * @param       storfsInst  Instance used for the STORfs
+     * @param       busy        STORFS_BUSY_PROGRAM or STORFS_BUSY_ERASE
+     * @return      STORFS_OK   Device is ready
+     */
+    storfs_err_t (*waitReady)(const struct storfs *storfsInst, storfs_busy_t busy);
+#endif
+
+#ifdef STORFS_WRITEV
+    /**
+     * @brief       Vectored Write Callback
+     *              Callback to write a header followed by its payload to a page with a specific byte offset in
+     *              a single program, the payload lies within the buffer passed to storfs_fputs
+     *
+     * @attention   May be NULL, the payload is then copied after the header and sent through the write callback
+     *              
+     * @param       storfsInst  Instance used for the STORfs
+     * @param       page        Page number to write data to
+     * @param       byte        Byte number within the page to write the header to
+     * @param       header      Header to be written at the byte offset
+     * @param       headerLen   Size of the header
+     * @param       payload     Data to be written directly after the header
+     * @param       payloadLen  Size of the payload
+     * @return      STORFS_OK   Succeed
+     */
+    storfs_err_t (*writev)(const struct storfs *storfsInst, storfs_page_t page, storfs_byte_t byte,
+            const uint8_t *header, storfs_size_t headerLen, const uint8_t *payload, storfs_size_t payloadLen);
+#endif
+
+#ifdef STORFS_SPARE_HEADERS
+    /**
+     * @brief       Spare Read Callback
+     *              Callback to read data from the spare (out of band) area of a page with a specific byte offset
+     *
+     * @attention   Only the first STORFS_FRAGMENT_HEADER_TOTAL_SIZE bytes of the spare area are used
+     *              
+     * @param       storfsInst  Instance used for the STORfs
+     * @param       page        Page number to read the spare area from
+     * @param       byte        Byte offset within the spare area
+     * @param       buffer      Buffer to store the data read from
+     * @param       size        Total size of the data to be read
+     * @return      STORFS_OK   Succeed
+     */
+    storfs_err_t (*readSpare)(const struct storfs *storfsInst, storfs_page_t page,
+            storfs_byte_t byte, uint8_t *buffer, storfs_size_t size);
+
+    /**
+     * @brief       Spare Write Callback
+     *              Callback to write data to the spare (out of band) area of a page with a specific byte offset,
+     *              the spare area must be erased along with its page by the erase callback
+     *              
+     * @param       storfsInst  Instance used for the STORfs
+     * @param       page        Page number to write the spare area of
+     * @param       byte        Byte offset within the spare area
+     * @param       buffer      Buffer to send data to the memory device
+     * @param       size        Size of the data to be sent
+     * @return      STORFS_OK   Succeed
+     */
+    storfs_err_t (*writeSpare)(const struct storfs *storfsInst, storfs_page_t page,
+            storfs_byte_t byte, uint8_t *buffer, storfs_size_t size);
 #endif
 
     /** @brief Location of the first page and byte within that page in memory for the directory to exist within */
@@ -217,11 +634,31 @@ typedef struct storfs{
     storfs_size_t firstByteLoc;
 
     /** @brief Size of the page/block/sector/section in bytes within the storage device typically 512 Bytes
-    This should be the lowest section available to write to a device */ 
+    This should be the lowest section available to write to a device
+    When STORFS_SPARE_HEADERS is defined it includes the STORFS_FRAGMENT_HEADER_TOTAL_SIZE bytes held within the spare area */ 
     storfs_size_t pageSize;
 
     /** @brief Number of erasable page/block/sector/section in bytes within the storage device typically 512 Bytes */
     storfs_size_t pageCount;
+
+    /** @brief Size of the block erased by the erase callback in bytes, a multiple of pageSize
+    If zero or equal to pageSize every page is erased on its own, otherwise a block is only erased once none of its pages
+    hold data, which requires STORFS_LAZY_DELETE and a firstPageLoc at the start of a block
+    Headers are then moved rather than rewritten, each write moves every header linking to the file up to the root and
+    appending is not supported, see the README for the options which cannot be used along with it */
+    storfs_size_t eraseSize;
+
+    /** @brief Set if the write callback is able to program the erased bytes of a page already holding data without erasing it
+    Links and removed pages are then programmed in place where the configuration allows, required by STORFS_LAZY_DELETE */
+    uint8_t partialProgram;
+
+#ifdef STORFS_WORK_BUF
+    /** @brief Buffer holding the page sized buffers otherwise placed on the stack, taken in turn as functions nest
+    A write may need four pages, the largest amount used is kept within
+    cachedInfo.workBufPeak, if NULL the static pool of STORFS_WORK_BUF_SIZE bytes is used */
+    uint8_t *workBuf;
+    storfs_size_t workBufSize;
+#endif
     
     /** @brief Information cached for use throughout the instance */
     storfs_cached_info_t cachedInfo;
@@ -335,6 +772,93 @@ storfs_err_t storfs_fputs(storfs_t *storfsInst, const char *str, const int n, ST
 */
 storfs_err_t storfs_fgets(storfs_t *storfsInst, char *str, int n, STORFS_FILE *stream);
 
+/** @brief Callback filling the buffer given with the next size bytes to be written to a file */ 
+typedef storfs_err_t (*storfs_producer_cb_t)(void *ctx, uint8_t *buffer, uint32_t size);
+
+/** @brief Callback given the next size bytes read from a file */ 
+typedef storfs_err_t (*storfs_consumer_cb_t)(void *ctx, const uint8_t *buffer, uint32_t size);
+
+/** @brief State of a write held between the pages programmed, used by storfs_poll to resume a queued write */ 
+typedef struct 
+{
+    const char              *str;
+    storfs_producer_cb_t    producer;
+    void                    *ctx;
+    STORFS_FILE             *stream;
+    uint32_t                headerLen;
+    int                     count;
+    int32_t                 sendDataItr;
+    int32_t                 currItr;
+    storfs_loc_t            currDataHeaderLoc;
+    storfs_loc_t            nextDataHeaderLoc;
+    storfs_loc_t            prevDataHeaderLoc;
+    storfs_loc_t            origHeaderLoc;
+    storfs_file_header_t    currHeaderInfo;
+    int32_t                 appendHeaderByteLoc;
+#ifdef STORFS_EXTENT_ALLOC
+    storfs_loc_t            extentLoc;
+    storfs_size_t           extentPageNum;
+#endif
+#ifdef STORFS_OPEN_FILE_TABLE
+    storfs_file_header_t    headInfo;
+    uint8_t                 headKnown;
+#endif
+#ifdef STORFS_INLINE_FILES
+    char                    inlineBuf[STORFS_INLINE_FILE_SIZE];
+#endif
+} storfs_write_t;
+
+/**
+     * @brief       fwrite_stream
+     *              Used to write to a file, the data is pulled from the producer one page at a time
+     * 
+     * @attention   The producer fills the page buffer directly and must provide every byte it is asked for,
+     *              an error returned by the producer stops the write and is returned
+     *              
+     * @param       storfsInst  Instance used for the STORfs
+     * @param       stream      File to write to
+     * @param       size        Total length of data to write to the file
+     * @param       producer    Called with the area of each page to be filled with the next data
+     * @param       ctx         Passed to the producer
+     * @return      STORFS_OK   Succeed
+*/
+storfs_err_t storfs_fwrite_stream(storfs_t *storfsInst, STORFS_FILE *stream, storfs_file_size_t size, storfs_producer_cb_t producer, void *ctx);
+
+/**
+     * @brief       fread_stream
+     *              Used to read the rest of a file, the data is pushed to the consumer one page at a time
+     * 
+     * @attention   The buffer given to the consumer is only valid until it returns, an error returned by the consumer
+     *              stops the read and is returned
+     *              
+     * @param       storfsInst  Instance used for the STORfs
+     * @param       stream      File to read from
+     * @param       consumer    Called with the data of each page read
+     * @param       ctx         Passed to the consumer
+     * @return      STORFS_OK   Succeed
+*/
+storfs_err_t storfs_fread_stream(storfs_t *storfsInst, STORFS_FILE *stream, storfs_consumer_cb_t consumer, void *ctx);
+
+/**
+     * @brief       fallocate
+     *              Reserves a run of pages for the fragments of the data about to be written to a file, the writes
+     *              that follow take the reserved pages in order without searching for free pages
+     * 
+     * @attention   Only available when STORFS_FALLOCATE is defined, the stream must be opened for writing or appending
+     * @attention   The reservation is held in memory, pages left unused are reserved until the file is removed,
+     *              storfs_fallocate is called with a size of 0 or the file system is mounted again
+     * @attention   When STORFS_INLINE_FILES is defined, an inline file is first moved onto a page of its own if size is
+     *              larger than STORFS_INLINE_FILE_SIZE, otherwise nothing is reserved and it stays inline
+     *              
+     * @param       storfsInst  Instance used for the STORfs
+     * @param       stream      File to reserve the pages for
+     * @param       size        Total length of data to be written to the file
+     * @return      STORFS_OK   Succeed
+*/
+#ifdef STORFS_FALLOCATE
+storfs_err_t storfs_fallocate(storfs_t *storfsInst, STORFS_FILE *stream, storfs_file_size_t size);
+#endif
+
 /**
      * @brief       rm
      *              Used to remove a file
@@ -360,6 +884,139 @@ storfs_err_t storfs_rm(storfs_t *storfsInst, char *pathToFile, STORFS_FILE *stre
 */
 storfs_err_t storfs_rewind(storfs_t *storfsInst, STORFS_FILE *stream);
 
+/**
+     * @brief       fclose
+     *              Closes a stream, the headers it left within the open file table may then be used by other streams
+     * 
+     * @attention   The open file table holds copies of headers rather than the stream, a stream is only closed to give
+     *              back its entries sooner
+     *              
+     * @param       storfsInst  Instance used for the STORfs
+     * @param       stream      File to close
+     * @return      STORFS_OK   Succeed
+*/
+storfs_err_t storfs_fclose(storfs_t *storfsInst, STORFS_FILE *stream);
+
+/**
+     * @brief       checkpoint
+     *              Writes every update held within the journal into the file tree and clears the journal
+     * 
+     * @attention   Only available when STORFS_JOURNAL is defined, the journal is otherwise checkpointed once full
+     *              
+     * @param       storfsInst  Instance used for the STORfs
+     * @return      STORFS_OK   Succeed
+*/
+#ifdef STORFS_JOURNAL
+storfs_err_t storfs_checkpoint(storfs_t *storfsInst);
+
+/**
+     * @brief       begin
+     *              Starts a transaction, root and header link updates are held in memory until committed
+     * 
+     * @attention   Only available when STORFS_JOURNAL is defined
+     * @attention   Items created within a transaction are not linked into the tree until storfs_commit is called
+     *              
+     * @param       storfsInst  Instance used for the STORfs
+     * @return      STORFS_OK   Succeed
+*/
+storfs_err_t storfs_begin(storfs_t *storfsInst);
+
+/**
+     * @brief       commit
+     *              Writes the updates held since storfs_begin to the journal in a single pass
+     * 
+     * @attention   Only available when STORFS_JOURNAL is defined
+     *              
+     * @param       storfsInst  Instance used for the STORfs
+     * @return      STORFS_OK   Succeed
+*/
+storfs_err_t storfs_commit(storfs_t *storfsInst);
+#endif
+
+#ifdef STORFS_ASYNC
+/** @brief Operations which may be queued by the asynchronous functions */ 
+typedef enum {
+    STORFS_ASYNC_MKDIR = 0x0UL,
+    STORFS_ASYNC_TOUCH,
+    STORFS_ASYNC_FOPEN,
+    STORFS_ASYNC_FPUTS,
+    STORFS_ASYNC_FGETS,
+    STORFS_ASYNC_RM,
+} storfs_async_op_t;
+
+/** @brief Handle of a queued operation, it must remain valid until the operation has completed */ 
+typedef struct storfs_async{
+    storfs_async_op_t       operation;
+    uint8_t                 pending;
+    storfs_err_t            status;
+    char                    *path;
+    const char              *mode;
+    const char              *writeBuf;
+    char                    *readBuf;
+    int                     n;
+    STORFS_FILE             *stream;
+    storfs_write_t          write;
+    uint8_t                 started;
+    uint8_t                 done;
+    void                    (*callback)(storfs_t *storfsInst, struct storfs_async *handle);
+    void                    *userData;
+    struct storfs_async     *next;
+} storfs_async_t;
+
+/** @brief Completion callback of a queued operation */ 
+typedef void (*storfs_async_cb_t)(storfs_t *storfsInst, storfs_async_t *handle);
+
+/**
+     * @brief       Asynchronous functions
+     *              Queue the operation of the matching synchronous function and return immediately
+     * 
+     * @attention   Only available when STORFS_ASYNC is defined
+     * @attention   The handle and every buffer given must remain valid until the callback is called
+     *              
+     * @param       storfsInst  Instance used for the STORfs
+     * @param       handle      Handle used to hold the queued operation, pending is cleared and status set once completed
+     * @param       callback    Called once the operation has completed, may be NULL
+     * @return      STORFS_OK   Succeed
+*/
+storfs_err_t storfs_mkdir_async(storfs_t *storfsInst, char *pathToDir, storfs_async_t *handle, storfs_async_cb_t callback);
+storfs_err_t storfs_touch_async(storfs_t *storfsInst, char *pathToFile, storfs_async_t *handle, storfs_async_cb_t callback);
+storfs_err_t storfs_fopen_async(storfs_t *storfsInst, char *pathToFile, const char * mode, STORFS_FILE *stream, storfs_async_t *handle, storfs_async_cb_t callback);
+storfs_err_t storfs_fputs_async(storfs_t *storfsInst, const char *str, const int n, STORFS_FILE *stream, storfs_async_t *handle, storfs_async_cb_t callback);
+storfs_err_t storfs_fgets_async(storfs_t *storfsInst, char *str, int n, STORFS_FILE *stream, storfs_async_t *handle, storfs_async_cb_t callback);
+storfs_err_t storfs_rm_async(storfs_t *storfsInst, char *pathToFile, STORFS_FILE *stream, storfs_async_t *handle, storfs_async_cb_t callback);
+
+/**
+     * @brief       poll
+     *              Runs the next queued operation if the device is ready and calls its callback
+     * 
+     * @attention   Only available when STORFS_ASYNC is defined
+     * @attention   Returns immediately if nothing is queued or the device is not ready, it should be called from the main loop
+     * @attention   A queued fputs programs a single page on each call, every other call writing to the file system returns an
+     *              error from its first page until it has completed
+     * @attention   Pages freed by a queued operation are erased one on each following call before it completes, unless
+     *              STORFS_LAZY_DELETE is defined
+     *              
+     * @param       storfsInst  Instance used for the STORfs
+     * @return      STORFS_OK   Succeed
+*/
+storfs_err_t storfs_poll(storfs_t *storfsInst);
+#endif
+
+/**
+     * @brief       idle
+     *              Performs deferred work such as erasing freed pages and checkpointing the journal within a time budget
+     * 
+     * @attention   Only available when STORFS_IDLE is defined
+     * @attention   Work is done in single page erases or checkpoints, the budget may be exceeded by the last of them
+     *              
+     * @param       storfsInst  Instance used for the STORfs
+     * @param       budgetUs    Time in microseconds that may be spent
+     * @return      STORFS_OK   Succeed
+*/
+#ifdef STORFS_IDLE
+storfs_err_t storfs_idle(storfs_t *storfsInst, uint32_t budgetUs);
+#endif
+
 storfs_err_t storfs_display_header(storfs_t *storfsInst, storfs_loc_t loc);
 
 #endif
\ No newline at end of file
@@ -5,9 +5,32 @@
 
 #define IS_EMPTY_FILE(info)
 
-#define LOCATION_TO_PAGE(location, storfsInst)              (location / storfsInst->pageSize)
-#define LOCATION_TO_BYTE(location, storfsInst)              ((location + storfsInst->pageSize) % storfsInst->pageSize)
-#define BYTEPAGE_TO_LOCATION(byte,page,storfsInst)          ((page * storfsInst->pageSize) + byte)
+//A geometry fixed at compile time turns the location math into shifts and masks
+#ifdef STORFS_PAGE_SIZE_LOG2
+    #define STORFS_INST_PAGE_SIZE(storfsInst)                   ((storfs_size_t)STORFS_PAGE_SIZE)
+    #define LOCATION_TO_PAGE(location, storfsInst)              ((location) >> STORFS_PAGE_SIZE_LOG2)
+    #define LOCATION_TO_BYTE(location, storfsInst)              ((location) & (STORFS_PAGE_SIZE - 1))
+    #define BYTEPAGE_TO_LOCATION(byte,page,storfsInst)          (((storfs_size_t)(page) << STORFS_PAGE_SIZE_LOG2) + (byte))
+#else
+    #define STORFS_INST_PAGE_SIZE(storfsInst)                   (storfsInst->pageSize)
+    #define LOCATION_TO_PAGE(location, storfsInst)              (location / storfsInst->pageSize)
+    #define LOCATION_TO_BYTE(location, storfsInst)              ((location + storfsInst->pageSize) % storfsInst->pageSize)
+    #define BYTEPAGE_TO_LOCATION(byte,page,storfsInst)          ((page * storfsInst->pageSize) + byte)
+#endif
+
+#ifdef STORFS_PAGE_COUNT
+    #define STORFS_INST_PAGE_COUNT(storfsInst)                  ((storfs_size_t)STORFS_PAGE_COUNT)
+#else
+    #define STORFS_INST_PAGE_COUNT(storfsInst)                  (storfsInst->pageCount)
+#endif
+
+#define STORFS_BLOCK_PAGES(storfsInst)                      \
+    ((storfsInst->eraseSize > STORFS_INST_PAGE_SIZE(storfsInst)) ? (storfsInst->eraseSize / STORFS_INST_PAGE_SIZE(storfsInst)) : 1)
+
+//64 bit fields are only held by full size links and by the tables storing page numbers
+#if !defined(STORFS_COMPACT_LINKS) || defined(STORFS_BAD_BLOCK_TABLE) || defined(STORFS_L2P_MAP) || defined(STORFS_JOURNAL)
+    #define STORFS_UINT64_FIELDS
+#endif
 
 #define SET_NULL(ptr)                                       (ptr = NULL)
 
@@ -26,6 +49,9 @@ typedef struct {
     storfs_file_header_t    storfsInfo;
     storfs_loc_t            storfsInfoLoc;
     storfs_file_flags_t     storfsFlags;
+#ifdef STORFS_WRITEV
+    const uint8_t           *payloadBuf;
+#endif
 } wear_level_t;
 
 /** @brief Wear handling enum */ 
@@ -69,8 +95,82 @@ typedef enum {
 #define STORFS_FILE_HEADER_WRITE                0x00000040
 #define STORFS_FILE_WRITE_INIT_FLAG             0x00000080
 #define STORFS_FILE_REWIND_FLAG                 0x00000100
+#define STORFS_FILE_WRITEV_FLAG                 0x00000200
+#define STORFS_FILE_UNLINKED_FLAG               0x00000400
 #define STORFS_FILE_DELETED_FLAG                0xF1
 
+/** @brief Journal record types */
+#define STORFS_JOURNAL_ROOT                     0x01
+#define STORFS_JOURNAL_CHILD                    0x02
+#define STORFS_JOURNAL_SIBLING                  0x03
+#define STORFS_JOURNAL_DROP                     0x04
+#define STORFS_JOURNAL_EMPTY                    0xFF
+
+/** @brief Offsets of the fields read straight from the buffer of a header */
+#define STORFS_HEADER_NAME_OFFSET               STORFS_INFO_REG_SIZE
+#define STORFS_HEADER_CHILD_OFFSET              STORFS_MAX_FILE_NAME
+#define STORFS_HEADER_SIBLING_OFFSET            (STORFS_HEADER_CHILD_OFFSET + STORFS_CHILD_DIR_REG_SIZE)
+#define STORFS_HEADER_FRAGMENT_OFFSET           (STORFS_HEADER_SIBLING_OFFSET + STORFS_SIBLING_DIR_SIZE + STORFS_RESERVED_SIZE)
+#define STORFS_FRAGMENT_HEADER_FRAGMENT_OFFSET  (STORFS_INFO_REG_SIZE + STORFS_RESERVED_SIZE)
+
+//Header fields are stored big endian, targets of a known byte order load each field with a single copy
+#if defined(__GNUC__) && defined(__BYTE_ORDER__)
+    #if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        #define STORFS_BE16(val)                __builtin_bswap16(val)
+        #define STORFS_BE32(val)                __builtin_bswap32(val)
+        #define STORFS_BE64(val)                __builtin_bswap64(val)
+    #elif __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        #define STORFS_BE16(val)                (val)
+        #define STORFS_BE32(val)                (val)
+        #define STORFS_BE64(val)                (val)
+    #endif
+#endif
+
+#ifdef STORFS_LINK_IN_PLACE
+    //Child and sibling links that are not set are left erased so they may be programmed later without an erase
+    #define STORFS_LINK_ERASED                  0xFFFFFFFFFFFFFFFF
+    #define LINK_TO_FLASH(link)                 (((link) == 0) ? STORFS_LINK_ERASED : (link))
+    //A header's erased link has not been set, an erased page keeps its erased value
+    #define LINK_FROM_FLASH(fileInfo, link)     ((((fileInfo) != 0xFF) && ((link) == STORFS_LINK_ERASED)) ? 0 : (link))
+#else
+    #define LINK_TO_FLASH(link)                 (link)
+    #define LINK_FROM_FLASH(fileInfo, link)     (link)
+#endif
+
+//A page is free to be allocated while the registers of the header at its start are erased
+#define STORFS_HEADER_ERASED(storfsInfo)        (((storfsInfo).fragmentLocation == 0xFFFFFFFFFFFFFFFF) && ((storfsInfo).siblingLocation == 0xFFFFFFFFFFFFFFFF) && \
+                                                ((storfsInfo).childLocation == 0xFFFFFFFFFFFFFFFF) && ((storfsInfo).fileInfo == 0xFF))
+
+#if defined(STORFS_LAZY_DELETE) || defined(STORFS_METADATA_PACK)
+    //Removed headers are kept with the valid bit cleared until their page is erased
+    #define STORFS_HEADER_INVALID(fileInfo)     (((fileInfo) != 0xFF) && (((fileInfo) & STORFS_INFO_REG_VALID_BIT) == 0))
+#endif
+
+//Headers of directories and inline files may share their page with other headers
+#ifdef STORFS_INLINE_FILES
+    #define STORFS_HEADER_PACKED(fileInfo)      ((((fileInfo) & STORFS_INFO_REG_FILE_TYPE_FILE) == STORFS_INFO_REG_FILE_TYPE_DIRECTORY) || \
+                                                ((fileInfo) & STORFS_INFO_REG_INLINE_BIT))
+#else
+    #define STORFS_HEADER_PACKED(fileInfo)      (((fileInfo) & STORFS_INFO_REG_FILE_TYPE_FILE) == STORFS_INFO_REG_FILE_TYPE_DIRECTORY)
+#endif
+
+#ifdef STORFS_INLINE_FILES
+    //Inline versions are linked through the fragment location of the header and of each version, left erased until set
+    #define STORFS_INLINE_LINK_ERASED           0xFFFFFFFFFFFFFFFF
+    #define STORFS_INLINE_HEADER_LINK           STORFS_HEADER_FRAGMENT_OFFSET
+    #define STORFS_INLINE_VERSION_LINK          STORFS_FRAGMENT_HEADER_FRAGMENT_OFFSET
+#endif
+
+#ifdef STORFS_LAZY_DELETE
+    //A removed page may only be reclaimed once none of the headers packed within it are valid
+    #ifdef STORFS_METADATA_PACK
+        #define STORFS_PAGE_INVALID(storfsInst, page, buf, size) \
+            (STORFS_HEADER_INVALID((buf)[0]) && meta_page_live(storfsInst, page, buf, size) != STORFS_OK)
+    #else
+        #define STORFS_PAGE_INVALID(storfsInst, page, buf, size) STORFS_HEADER_INVALID((buf)[0])
+    #endif
+#endif
+
 #ifdef STORFS_USE_CRC
     #define STORFS_CRC_CALC(storfsInst, buf, buflen)    \
         (storfsInst->crc(storfsInst, buf, buflen))
@@ -106,34 +206,231 @@ typedef enum {
         
 #endif
 
+static storfs_err_t device_erase_helper(storfs_t *storfsInst, storfs_page_t page);
+
+#ifdef STORFS_LAZY_SYNC
+    //Reads never leave the device busy, so the device is only waited on before the operation following a program or erase
+    //Only programs and erases record the busy state, readers sharing the lock find it clear and never write it
+    static storfs_err_t busy_wait(storfs_t *storfsInst);
+    #define STORFS_SYNC(storfsInst)                             \
+        (busy_wait(storfsInst))
+    #define STORFS_DEVICE_OP(storfsInst, busy, op)              \
+        (busy_wait(storfsInst) != STORFS_OK ? STORFS_ERROR : ((storfsInst)->cachedInfo.deviceBusy = (busy), (op)))
+    #define STORFS_DEVICE_READ_OP(storfsInst, op)               \
+        (busy_wait(storfsInst) != STORFS_OK ? STORFS_ERROR : (op))
+#else
+    #define STORFS_SYNC(storfsInst)                             \
+        (storfsInst->sync(storfsInst))
+    #define STORFS_DEVICE_OP(storfsInst, busy, op)              \
+        (op)
+    #define STORFS_DEVICE_READ_OP(storfsInst, op)               \
+        (op)
+#endif
+
+#ifdef STORFS_SPARE_HEADERS
+    //The first bytes of every page are held within the spare area, so the data of fragments fills the page itself
+    static storfs_err_t spare_read_helper(storfs_t *storfsInst, storfs_page_t page, storfs_byte_t byte, uint8_t *buf, storfs_size_t size);
+    static storfs_err_t spare_write_helper(storfs_t *storfsInst, storfs_page_t page, storfs_byte_t byte, uint8_t *buf, storfs_size_t size);
+    #define STORFS_DEVICE_READ(storfsInst, page, byte, buf, size)   \
+        (spare_read_helper(storfsInst, page, byte, buf, size))
+    #define STORFS_DEVICE_WRITE(storfsInst, page, byte, buf, size)  \
+        (spare_write_helper(storfsInst, page, byte, buf, size))
+#else
+    #define STORFS_DEVICE_READ(storfsInst, page, byte, buf, size)   \
+        (STORFS_DEVICE_READ_OP(storfsInst, storfsInst->read(storfsInst, page, byte, buf, size)))
+    #define STORFS_DEVICE_WRITE(storfsInst, page, byte, buf, size)  \
+        (STORFS_DEVICE_OP(storfsInst, STORFS_BUSY_PROGRAM, storfsInst->write(storfsInst, page, byte, buf, size)))
+#endif
+
+#ifdef STORFS_OPEN_FILE_TABLE
+    //The open file table holds copies of the headers streams last read or wrote, keyed by their location, each is
+    //dropped once the page holding it is programmed or erased
+    static storfs_page_t open_file_touch(storfs_t *storfsInst, storfs_page_t page);
+    static storfs_err_t open_file_load(storfs_t *storfsInst, storfs_file_header_t *storfsInfo, storfs_loc_t storfsLoc, const char *fileType);
+    static void open_file_hold(storfs_t *storfsInst, storfs_loc_t storfsLoc, const storfs_file_header_t *storfsInfo);
+    #define STORFS_TOUCH(storfsInst, page)                      \
+        (open_file_touch(storfsInst, page))
+    #define STORFS_HEADER_LOAD(storfsInst, storfsInfo, storfsLoc, fileType)     \
+        (open_file_load(storfsInst, storfsInfo, storfsLoc, fileType))
+#else
+    #define STORFS_TOUCH(storfsInst, page)                      \
+        (page)
+    #define STORFS_HEADER_LOAD(storfsInst, storfsInfo, storfsLoc, fileType)     \
+        (file_header_store_helper(storfsInst, storfsInfo, storfsLoc, fileType))
+#endif
+
+#ifdef STORFS_L2P_MAP
+    static storfs_page_t l2p_translate(storfs_t *storfsInst, storfs_page_t page);
+    #define STORFS_READ(storfsInst, page, byte, buf, size)      \
+        (STORFS_DEVICE_READ(storfsInst, l2p_translate(storfsInst, page), byte, buf, size))
+    #define STORFS_WRITE(storfsInst, page, byte, buf, size)     \
+        (STORFS_DEVICE_WRITE(storfsInst, l2p_translate(storfsInst, STORFS_TOUCH(storfsInst, page)), byte, buf, size))
+    #define STORFS_WRITE_VEC(storfsInst, page, byte, header, headerLen, payload, payloadLen)      \
+        (STORFS_DEVICE_OP(storfsInst, STORFS_BUSY_PROGRAM, storfsInst->writev(storfsInst, l2p_translate(storfsInst, STORFS_TOUCH(storfsInst, page)), \
+            byte, header, headerLen, payload, payloadLen)))
+    #define STORFS_DEVICE_ERASE(storfsInst, page)               \
+        (device_erase_helper(storfsInst, l2p_translate(storfsInst, STORFS_TOUCH(storfsInst, page))))
+    #define STORFS_LOGICAL_PAGE_COUNT(storfsInst)               \
+        (STORFS_INST_PAGE_COUNT(storfsInst) - STORFS_L2P_SPARE_PAGES)
+#else
+    #define STORFS_READ(storfsInst, page, byte, buf, size)      \
+        (STORFS_DEVICE_READ(storfsInst, page, byte, buf, size))
+    #define STORFS_WRITE(storfsInst, page, byte, buf, size)     \
+        (STORFS_DEVICE_WRITE(storfsInst, STORFS_TOUCH(storfsInst, page), byte, buf, size))
+    #define STORFS_WRITE_VEC(storfsInst, page, byte, header, headerLen, payload, payloadLen)      \
+        (STORFS_DEVICE_OP(storfsInst, STORFS_BUSY_PROGRAM, storfsInst->writev(storfsInst, STORFS_TOUCH(storfsInst, page), \
+            byte, header, headerLen, payload, payloadLen)))
+    #define STORFS_DEVICE_ERASE(storfsInst, page)               \
+        (device_erase_helper(storfsInst, STORFS_TOUCH(storfsInst, page)))
+    #define STORFS_LOGICAL_PAGE_COUNT(storfsInst)               \
+        (STORFS_INST_PAGE_COUNT(storfsInst))
+#endif
+
+#ifdef STORFS_JOURNAL
+    static storfs_err_t journal_erase(storfs_t *storfsInst, storfs_page_t page);
+    #define STORFS_ERASE(storfsInst, page)                      \
+        (journal_erase(storfsInst, page))
+#else
+    #define STORFS_ERASE(storfsInst, page)                      \
+        STORFS_DEVICE_ERASE(storfsInst, page)
+#endif
+
+#ifdef STORFS_WORK_BUF
+    //Page sized buffers are taken from the work buffer and given back before returning, in the reverse order
+    static uint8_t *work_buf_take(storfs_t *storfsInst, storfs_size_t size);
+    static void work_buf_give(storfs_t *storfsInst, uint8_t *buf);
+    #define STORFS_WORK_BUF_TAKE(storfsInst, name, size)        \
+        uint8_t *name = work_buf_take(storfsInst, size)
+    #define STORFS_WORK_BUF_FAILED(name)                        \
+        (name == NULL)
+    #define STORFS_WORK_BUF_GIVE(storfsInst, name)              \
+        (work_buf_give(storfsInst, name))
+    #define STORFS_WORK_BUF_RETURN(storfsInst, name, status)    \
+        do { storfs_err_t workStatus = (status); work_buf_give(storfsInst, name); return workStatus; } while(0)
+#else
+    #define STORFS_WORK_BUF_TAKE(storfsInst, name, size)        \
+        uint8_t name[size]
+    #define STORFS_WORK_BUF_FAILED(name)                        \
+        (0)
+    #define STORFS_WORK_BUF_GIVE(storfsInst, name)
+    #define STORFS_WORK_BUF_RETURN(storfsInst, name, status)    \
+        return (status)
+#endif
+
+#ifdef STORFS_THREADSAFE
+    #define STORFS_LOCK(storfsInst, lockType)                   \
+        (storfsInst->lock(storfsInst, lockType))
+    #define STORFS_UNLOCK(storfsInst, lockType)                 \
+        (storfsInst->unlock(storfsInst, lockType))
+#else
+    #define STORFS_LOCK(storfsInst, lockType)                   \
+        (STORFS_OK)
+    #define STORFS_UNLOCK(storfsInst, lockType)                 \
+        ((void)0)
+#endif
+
+#if defined(STORFS_THREADSAFE) && defined(STORFS_LAZY_SYNC)
+    //Writers wait on the device before releasing the lock so that readers sharing it never find it busy
+    #undef STORFS_UNLOCK
+    #define STORFS_UNLOCK(storfsInst, lockType)                 \
+        ((lockType) == STORFS_LOCK_EXCLUSIVE ? (void)busy_wait(storfsInst) : (void)0, storfsInst->unlock(storfsInst, lockType))
+#endif
+
+#ifdef STORFS_WORK_BUF
+    //Streamed pages are read into the work buffer, which may only be taken while holding the lock exclusively
+    #define STORFS_STREAM_LOCK                                  \
+        STORFS_LOCK_EXCLUSIVE
+#else
+    #define STORFS_STREAM_LOCK                                  \
+        STORFS_LOCK_SHARED
+#endif
+
+#ifdef STORFS_OPEN_FILE_TABLE
+    //The headers read by storfs_fgets are placed within the open file table, which may only be changed while holding the lock exclusively
+    #define STORFS_READ_LOCK                                    \
+        STORFS_LOCK_EXCLUSIVE
+#else
+    #define STORFS_READ_LOCK                                    \
+        STORFS_LOCK_SHARED
+#endif
+
+#ifdef STORFS_ASYNC
+    //Calls writing to the file system are refused while a queued write is part way through, it holds its locations between polls
+    #define STORFS_WRITE_LOCK(storfsInst)                       \
+        (STORFS_LOCK(storfsInst, STORFS_LOCK_EXCLUSIVE) != STORFS_OK ? STORFS_ERROR : async_write_check(storfsInst))
+#else
+    #define STORFS_WRITE_LOCK(storfsInst)                       \
+        (STORFS_LOCK(storfsInst, STORFS_LOCK_EXCLUSIVE))
+#endif
+
+#if defined(STORFS_ASYNC) && !defined(STORFS_LAZY_DELETE)
+    //Pages freed by a queued operation are not erased until a later poll, they may not be handed out before then
+    #define STORFS_ASYNC_ERASE_CHECK(storfsInst, page)          \
+        (async_erase_check(storfsInst, page))
+#else
+    #define STORFS_ASYNC_ERASE_CHECK(storfsInst, page)          \
+        (STORFS_OK)
+#endif
+
 static const char* TAG = "STORfs";
 
 /** @brief Used to compare crc code from a file and a buffer */
-static storfs_err_t crc_compare(storfs_t *storfsInst, storfs_file_header_t storfsInfo, const uint8_t *buf, uint32_t bufLen);
+static storfs_err_t crc_compare(storfs_t *storfsInst, const storfs_file_header_t *storfsInfo, const uint8_t *buf, uint32_t bufLen);
 static storfs_err_t crc_header_check(storfs_t *storfsInst, storfs_loc_t storfsLoc);
 static storfs_err_t crc_file_check(storfs_t *storfsInst, storfs_loc_t storfsLoc, uint32_t len);
 
 /** @brief Functions to turn a uint8_t buffer to proper struct used by the file header */
-static uint16_t uint8_t_to_uint16_t(uint8_t *buf, uint32_t *index);
-static uint32_t uint8_t_to_uint32_t(uint8_t *buf, uint32_t *index);
-static uint64_t uint8_t_to_uint64_t(uint8_t *buf, uint32_t *index);
-static void buf_to_info(uint8_t *buf, storfs_file_header_t *storfsInfo);
+static uint16_t uint8_t_to_uint16_t(const uint8_t *buf, uint32_t *index);
+static uint32_t uint8_t_to_uint32_t(const uint8_t *buf, uint32_t *index);
+#ifdef STORFS_UINT64_FIELDS
+static uint64_t uint8_t_to_uint64_t(const uint8_t *buf, uint32_t *index);
+#endif
+static storfs_size_t uint8_t_to_link(const uint8_t *buf, uint32_t *index);
+static void buf_to_info(const uint8_t *buf, storfs_file_header_t *storfsInfo);
+
+/** @brief Functions to read a single field straight from the buffer of a header without decoding the whole header */
+static const storfs_name_t *header_view_name(const uint8_t *buf);
+static storfs_size_t header_view_sibling(const uint8_t *buf);
+static storfs_size_t header_view_fragment(const uint8_t *buf);
 
 /** @brief Functions to turn file header into a writeable buffer */
 static void uint16_t_to_uint8_t(uint8_t *buf, uint16_t uint16Val, uint32_t *index);
 static void uint32_t_to_uint8_t(uint8_t *buf, uint32_t uint32Val, uint32_t *index);
+#ifdef STORFS_UINT64_FIELDS
 static void uint64_t_to_uint8_t(uint8_t *buf, uint64_t uint64Val, uint32_t *index);
+#endif
+static void link_to_uint8_t(uint8_t *buf, storfs_size_t location, uint32_t *index);
 static void info_to_buf(uint8_t *buf, storfs_file_header_t *storfsInfo);
 
 /** @brief Header creation/storage/display functions */
 static storfs_err_t file_header_create_helper(storfs_t *storfsInst, storfs_file_header_t *storfsInfo, storfs_loc_t storfsLoc, const char *string);
+static storfs_err_t file_header_view_helper(storfs_t *storfsInst, uint8_t *headerBuf, storfs_loc_t storfsLoc, const char *string);
 static storfs_err_t file_header_store_helper(storfs_t *storfsInst, storfs_file_header_t *storfsInfo, storfs_loc_t storfsLoc, const char *string);
-static void file_info_display_helper(storfs_file_header_t storfsInfo);
+static void file_info_display_helper(const storfs_file_header_t *storfsInfo);
 
 /** @brief Functions to find the next available page to write to and to update the next available byte for the user cache */
+static storfs_err_t root_write_helper(storfs_t *storfsInst);
 static storfs_err_t update_root(storfs_t *storfsInst);
 static storfs_err_t update_root_next_open_byte(storfs_t *storfsInst, storfs_size_t fileLocation);
 static storfs_err_t find_next_open_byte_helper (storfs_t *storfsInst, storfs_loc_t *storfsLoc);
+#ifdef STORFS_EXTENT_ALLOC
+static storfs_err_t extent_alloc_helper(storfs_t *storfsInst, storfs_loc_t *storfsLoc, storfs_size_t pageNum);
+#endif
+#ifdef STORFS_FALLOCATE
+static storfs_err_t falloc_check(storfs_t *storfsInst, storfs_page_t page);
+static storfs_err_t falloc_take(storfs_t *storfsInst, storfs_page_t filePage, storfs_loc_t *storfsLoc, storfs_size_t *pageNum);
+static void falloc_release(storfs_t *storfsInst, storfs_page_t filePage);
+static void falloc_move(storfs_t *storfsInst, storfs_page_t filePage, storfs_page_t newFilePage);
+    #define STORFS_FALLOC_TAKE(storfsInst, filePage, storfsLoc, pageNum)    \
+        (falloc_take(storfsInst, filePage, storfsLoc, pageNum))
+    #define STORFS_FALLOC_MOVE(storfsInst, filePage, newFilePage)           \
+        (falloc_move(storfsInst, filePage, newFilePage))
+#else
+    #define STORFS_FALLOC_TAKE(storfsInst, filePage, storfsLoc, pageNum)    \
+        (STORFS_ERROR)
+    #define STORFS_FALLOC_MOVE(storfsInst, filePage, newFilePage)           \
+        ((void)0)
+#endif
 
 /** @brief Function to handle opening/creating new files, most important function of STORfs */
 static storfs_err_t file_handling_helper(storfs_t *storfsInst, storfs_name_t *pathToDir, file_action_t actionFlag, void *buff);
@@ -141,18 +438,128 @@ static storfs_err_t file_handling_helper(storfs_t *storfsInst, storfs_name_t *pa
 /** @brief File open helper function for w or w+ modes */
 static storfs_err_t fopen_write_flag_helper(storfs_t *storfsInst, char *pathToFile, STORFS_FILE *currentOpenFile);
 
+/** @brief Bodies of the public functions, called with the lock held */
+static storfs_err_t mount_helper(storfs_t *storfsInst, char *partName);
+static storfs_err_t fopen_helper(storfs_t *storfsInst, char *pathToFile, const char * mode, STORFS_FILE *stream);
+static storfs_err_t write_helper(storfs_t *storfsInst, const char *str, storfs_producer_cb_t producer, void *ctx, const int n, STORFS_FILE *stream);
+static storfs_err_t fgets_helper(storfs_t *storfsInst, char *str, int n, STORFS_FILE *stream);
+static storfs_err_t fread_stream_helper(storfs_t *storfsInst, STORFS_FILE *stream, storfs_consumer_cb_t consumer, void *ctx);
+static storfs_err_t rm_helper(storfs_t *storfsInst, char *pathToFile, STORFS_FILE *stream);
+static storfs_err_t fclose_helper(storfs_t *storfsInst, STORFS_FILE *stream);
+#ifdef STORFS_FALLOCATE
+static storfs_err_t fallocate_helper(storfs_t *storfsInst, STORFS_FILE *stream, storfs_file_size_t size);
+#endif
+
 /** @brief Helper functions to delete directories and files */
-static storfs_err_t file_delete_helper(storfs_t *storfsInst, storfs_loc_t storfsLoc, storfs_file_header_t storfsInfo);
-static storfs_err_t directory_delete_helper(storfs_t *storfsInst, storfs_loc_t rmParentLoc, storfs_file_header_t rmParentHeader);
+static storfs_err_t file_delete_helper(storfs_t *storfsInst, storfs_loc_t storfsLoc, const storfs_file_header_t *storfsInfo, uint8_t deferErase);
+static storfs_err_t directory_delete_helper(storfs_t *storfsInst, storfs_loc_t rmParentLoc, const storfs_file_header_t *rmParentHeader);
+static storfs_err_t page_free_helper(storfs_t *storfsInst, storfs_page_t page);
+static storfs_err_t file_replace_helper(storfs_t *storfsInst, storfs_loc_t oldLoc, storfs_loc_t newLoc);
+
+/** @brief Steps of a write, each page is programmed by a call of its own so a queued write may be resumed by storfs_poll */
+static storfs_err_t write_begin_helper(storfs_t *storfsInst, const char *str, storfs_producer_cb_t producer, void *ctx, const int n, STORFS_FILE *stream, storfs_write_t *write);
+static storfs_err_t write_setup_helper(storfs_t *storfsInst, storfs_write_t *write, uint8_t *sendBuf);
+static storfs_err_t write_page_helper(storfs_t *storfsInst, storfs_write_t *write);
+static storfs_err_t write_end_helper(storfs_t *storfsInst, storfs_write_t *write);
+static void write_abort_helper(storfs_t *storfsInst, storfs_write_t *write);
+
+/** @brief Functions used to determine which pages of an erase block larger than a page still hold data */
+static storfs_err_t block_page_check(storfs_t *storfsInst, storfs_page_t page, uint8_t *buf, storfs_size_t size);
+static storfs_err_t block_reclaim_check(storfs_t *storfsInst, storfs_page_t page);
 
 /** @brief Functions used for wear levelling */
 static storfs_err_t find_prev_file_loc(storfs_t* storfsInst,  storfs_loc_t storfsCurrLoc, storfs_loc_t storfsItrLoc, storfs_loc_t* storfsPrevLoc);
 static storfs_err_t wear_level_act(storfs_t* storfsInst, wear_level_t *wearLevelInfo);
 static storfs_err_t write_wear_level_helper(storfs_t* storfsInst, wear_level_t *wearLevelInfo);
+static storfs_err_t link_update_helper(storfs_t* storfsInst, wear_level_t *wearLevelInfo);
+static storfs_err_t page_relocate_helper(storfs_t* storfsInst, wear_level_t *wearLevelInfo, storfs_loc_t storfsLoc);
+
+#ifdef STORFS_BAD_BLOCK_TABLE
+/** @brief Functions used to load, check and record pages that failed to program */
+static storfs_err_t bad_block_load(storfs_t *storfsInst);
+static storfs_err_t bad_block_store(storfs_t *storfsInst);
+static storfs_err_t bad_block_check(storfs_t *storfsInst, storfs_page_t page);
+static storfs_err_t bad_block_mark(storfs_t *storfsInst, storfs_page_t page);
+#endif
+
+#ifdef STORFS_L2P_MAP
+/** @brief Functions used to load, store and update the logical to physical page map */
+static storfs_err_t l2p_load(storfs_t *storfsInst, storfs_err_t format);
+static storfs_err_t l2p_store(storfs_t *storfsInst);
+static storfs_err_t l2p_remap(storfs_t *storfsInst, storfs_page_t page);
+#endif
+
+#ifdef STORFS_JOURNAL
+/** @brief Functions used to append, replay and checkpoint the metadata updates held within the journal */
+static storfs_err_t journal_load(storfs_t *storfsInst, storfs_err_t format);
+static storfs_err_t journal_append(storfs_t *storfsInst, uint8_t type, storfs_size_t location, storfs_size_t value);
+static void journal_replay(storfs_t *storfsInst, uint8_t type, storfs_size_t location, storfs_size_t value);
+static void journal_apply(storfs_t *storfsInst, storfs_loc_t storfsLoc, storfs_file_header_t *storfsInfo);
+static void journal_link_apply(storfs_t *storfsInst, storfs_loc_t storfsLoc, uint8_t type, storfs_size_t *link);
+static storfs_err_t journal_link_update(storfs_t *storfsInst, wear_level_t *wearLevelInfo);
+static storfs_err_t journal_drop(storfs_t *storfsInst, storfs_page_t page);
+static storfs_err_t journal_checkpoint(storfs_t *storfsInst);
+static uint32_t journal_records_left(storfs_t *storfsInst);
+static storfs_err_t commit_helper(storfs_t *storfsInst);
+#endif
+
+#if defined(STORFS_LAZY_DELETE) && defined(STORFS_IDLE)
+/** @brief Function used to hold pages marked invalid until they are erased by storfs_idle */
+static storfs_err_t idle_erase_defer(storfs_t *storfsInst, storfs_page_t page);
+#endif
+
+#ifdef STORFS_ERASE_POOL
+/** @brief Functions used to keep a pool of erased pages ahead of the next open byte */
+static storfs_err_t erase_pool_fill(storfs_t *storfsInst, uint8_t eraseInvalid);
+static storfs_err_t erase_pool_add(storfs_t *storfsInst, storfs_page_t page);
+static storfs_err_t erase_pool_find(storfs_t *storfsInst, storfs_page_t page, storfs_page_t *poolPage);
+static storfs_err_t erase_pool_remove(storfs_t *storfsInst, storfs_page_t page);
+#endif
+
+#ifdef STORFS_METADATA_PACK
+/** @brief Functions used to pack directory headers together within metadata pages */
+static storfs_err_t meta_slot_take(storfs_t *storfsInst, storfs_loc_t *storfsLoc);
+static storfs_err_t meta_slot_remove(storfs_t *storfsInst, storfs_loc_t storfsLoc, const storfs_file_header_t *storfsInfo);
+static storfs_err_t meta_page_live(storfs_t *storfsInst, storfs_page_t page, const uint8_t *buf, storfs_size_t size);
+static storfs_err_t meta_page_read(storfs_t *storfsInst, storfs_page_t page, uint8_t *pageBuf);
+static storfs_err_t meta_page_write(storfs_t *storfsInst, storfs_page_t page, uint8_t *pageBuf);
+static storfs_err_t meta_header_rewrite(storfs_t *storfsInst, storfs_file_header_t *storfsInfo, storfs_loc_t storfsLoc);
+#endif
+
+#ifdef STORFS_INLINE_FILES
+/** @brief Functions used to hold the data of small files as versions within metadata pages */
+static storfs_err_t inline_find_helper(storfs_t *storfsInst, storfs_file_header_t *storfsInfo, storfs_loc_t *versionLoc, storfs_file_header_t *versionInfo, uint32_t *versions);
+static storfs_err_t inline_write_helper(storfs_t *storfsInst, const char *str, const int n, STORFS_FILE *stream);
+static storfs_err_t inline_read_helper(storfs_t *storfsInst, char *str, int n, STORFS_FILE *stream);
+static storfs_err_t inline_size_helper(storfs_t *storfsInst, STORFS_FILE *stream);
+static storfs_err_t inline_promote_helper(storfs_t *storfsInst, STORFS_FILE *stream);
+static storfs_err_t inline_delete_helper(storfs_t *storfsInst, storfs_loc_t storfsLoc, const storfs_file_header_t *storfsInfo);
+static storfs_err_t inline_link_program(storfs_t *storfsInst, storfs_loc_t storfsLoc, storfs_byte_t linkOffset, storfs_size_t location);
+#endif
 
-static storfs_err_t crc_compare(storfs_t *storfsInst, storfs_file_header_t storfsInfo, const uint8_t *buf, uint32_t bufLen)
+#ifdef STORFS_ASYNC
+/** @brief Functions used to add an operation to the queue run by storfs_poll */
+static storfs_err_t async_check_helper(storfs_t *storfsInst, storfs_async_t *handle);
+static storfs_err_t async_queue_helper(storfs_t *storfsInst, storfs_async_t *handle, storfs_async_op_t operation, storfs_async_cb_t callback);
+static storfs_err_t async_write_helper(storfs_t *storfsInst, storfs_async_t *handle);
+static storfs_err_t async_step_helper(storfs_t *storfsInst, storfs_async_t *handle);
+static storfs_err_t async_write_check(storfs_t *storfsInst);
+#ifndef STORFS_LAZY_DELETE
+/** @brief Functions used to leave the pages freed by a queued operation to be erased by the following polls */
+static storfs_err_t async_erase_defer(storfs_t *storfsInst, storfs_page_t page);
+static storfs_err_t async_erase_check(storfs_t *storfsInst, storfs_page_t page);
+static storfs_err_t async_erase_helper(storfs_t *storfsInst);
+#endif
+#endif
+
+#ifdef STORFS_LINK_IN_PLACE
+/** @brief Function used to program an unset link of the previous file without erasing its page */
+static storfs_err_t link_program_helper(storfs_t *storfsInst, wear_level_t *wearLevelInfo);
+#endif
+
+static storfs_err_t crc_compare(storfs_t *storfsInst, const storfs_file_header_t *storfsInfo, const uint8_t *buf, uint32_t bufLen)
 {
-    if(storfsInfo.crc == (STORFS_CRC_CALC(storfsInst, buf, bufLen)))
+    if(storfsInfo->crc == (STORFS_CRC_CALC(storfsInst, buf, bufLen)))
     {
         STORFS_LOGD(TAG, "CRC Code Correct");
         return STORFS_OK;
@@ -171,14 +578,18 @@ static storfs_err_t crc_header_check(storfs_t *storfsInst, storfs_loc_t storfsLo
 
     while(storfsInfo.fileName[strLen++] != '\0');
 
-    return crc_compare(storfsInst, storfsInfo, (uint8_t *)storfsInfo.fileName, strLen);
+    return crc_compare(storfsInst, &storfsInfo, (uint8_t *)storfsInfo.fileName, strLen);
 }
 
 static storfs_err_t crc_file_check(storfs_t *storfsInst, storfs_loc_t storfsLoc, uint32_t len)
 {
     storfs_file_header_t storfsInfo;
     uint32_t headerLen = STORFS_HEADER_TOTAL_SIZE;
-    uint8_t buf[len];
+    STORFS_WORK_BUF_TAKE(storfsInst, buf, len);
+    if(STORFS_WORK_BUF_FAILED(buf))
+    {
+        return STORFS_ERROR;
+    }
 
     file_header_store_helper(storfsInst, &storfsInfo, storfsLoc, "CRC File Check");
     if((storfsInfo.fileInfo & STORFS_INFO_REG_FILE_TYPE_FILE) == 0)
@@ -186,42 +597,57 @@ static storfs_err_t crc_file_check(storfs_t *storfsInst, storfs_loc_t storfsLoc,
         headerLen = STORFS_FRAGMENT_HEADER_TOTAL_SIZE;
     }
 
-    if(storfsInst->read(storfsInst, storfsLoc.pageLoc, headerLen, buf, len) != STORFS_OK)
+    if(STORFS_READ(storfsInst, storfsLoc.pageLoc, headerLen, buf, len) != STORFS_OK)
     {
-        return STORFS_READ_FAILED;
+        STORFS_WORK_BUF_RETURN(storfsInst, buf, STORFS_READ_FAILED);
     }
 
-    return crc_compare(storfsInst, storfsInfo, buf, len);
+    STORFS_WORK_BUF_RETURN(storfsInst, buf, crc_compare(storfsInst, &storfsInfo, buf, len));
 }
 
-static uint16_t uint8_t_to_uint16_t(uint8_t *buf, uint32_t *index)
+static uint16_t uint8_t_to_uint16_t(const uint8_t *buf, uint32_t *index)
 {
     uint16_t result = 0;
+#ifdef STORFS_BE16
+    memcpy(&result, &buf[*index], sizeof(result));
+    result = STORFS_BE16(result);
+#else
     result |= (uint16_t)buf[*(index)+1];
     result |= (uint16_t)buf[*(index)] << 8;
+#endif
 
     *index = *index + 2;
 
     return result;
 }
 
-static uint32_t uint8_t_to_uint32_t(uint8_t *buf, uint32_t *index)
+static uint32_t uint8_t_to_uint32_t(const uint8_t *buf, uint32_t *index)
 {
     uint32_t result = 0;
 
+#ifdef STORFS_BE32
+    memcpy(&result, &buf[*index], sizeof(result));
+    result = STORFS_BE32(result);
+#else
     result |= (uint32_t)buf[*(index)+3];
     result |= (uint32_t)buf[*(index)+2] << 8;
     result |= (uint32_t)buf[*(index)+1] << 16;
     result |= (uint32_t)buf[*(index)] << 24;
+#endif
 
     *index = *index + 4;
 
     return result;
 }
 
-static uint64_t uint8_t_to_uint64_t(uint8_t *buf, uint32_t *index)
+#ifdef STORFS_UINT64_FIELDS
+static uint64_t uint8_t_to_uint64_t(const uint8_t *buf, uint32_t *index)
 {
     uint64_t result = 0;
+#ifdef STORFS_BE64
+    memcpy(&result, &buf[*index], sizeof(result));
+    result = STORFS_BE64(result);
+#else
     result |= (uint64_t)buf[*(index)+7];
     result |= (uint64_t)buf[*(index)+6] << 8;
     result |= (uint64_t)buf[*(index)+5] << 16;
@@ -230,13 +656,27 @@ static uint64_t uint8_t_to_uint64_t(uint8_t *buf, uint32_t *index)
     result |= (uint64_t)buf[*(index)+2] << 40;
     result |= (uint64_t)buf[*(index)+1] << 48;
     result |= (uint64_t)buf[*(index)] << 56;
+#endif
 
     *index = *index + 8;
 
     return result;
 }
+#endif
+
+static storfs_size_t uint8_t_to_link(const uint8_t *buf, uint32_t *index)
+{
+#ifdef STORFS_COMPACT_LINKS
+    //An erased 32 bit location is read as an erased 64 bit location
+    uint32_t location = uint8_t_to_uint32_t(buf, index);
+
+    return (location == 0xFFFFFFFF) ? 0xFFFFFFFFFFFFFFFF : location;
+#else
+    return uint8_t_to_uint64_t(buf, index);
+#endif
+}
 
-static void buf_to_info(uint8_t *buf, storfs_file_header_t *storfsInfo)
+static void buf_to_info(const uint8_t *buf, storfs_file_header_t *storfsInfo)
 {
     uint32_t i = 0;
     storfsInfo->fileInfo = buf[i++];
@@ -244,7 +684,7 @@ static void buf_to_info(uint8_t *buf, storfs_file_header_t *storfsInfo)
     if((storfsInfo->fileInfo & STORFS_INFO_REG_FILE_TYPE_FILE) == 0)
     {
         storfsInfo->reserved = uint8_t_to_uint16_t(buf, &i);
-        storfsInfo->fragmentLocation = uint8_t_to_uint64_t(buf, &i);
+        storfsInfo->fragmentLocation = uint8_t_to_link(buf, &i);
         storfsInfo->crc = uint8_t_to_uint16_t(buf, &i);
         //Set all other information equal to zero
         for(int j = 0; j < STORFS_MAX_FILE_NAME; j++)
@@ -262,15 +702,38 @@ static void buf_to_info(uint8_t *buf, storfs_file_header_t *storfsInfo)
             storfsInfo->fileName[i - STORFS_INFO_REG_SIZE] = buf[i];
             i++;
         }
-        storfsInfo->childLocation = uint8_t_to_uint64_t(buf, &i);
-        storfsInfo->siblingLocation = uint8_t_to_uint64_t(buf, &i);
+        storfsInfo->childLocation = uint8_t_to_link(buf, &i);
+        storfsInfo->childLocation = LINK_FROM_FLASH(storfsInfo->fileInfo, storfsInfo->childLocation);
+        storfsInfo->siblingLocation = uint8_t_to_link(buf, &i);
+        storfsInfo->siblingLocation = LINK_FROM_FLASH(storfsInfo->fileInfo, storfsInfo->siblingLocation);
         storfsInfo->reserved = uint8_t_to_uint16_t(buf, &i);
-        storfsInfo->fragmentLocation = uint8_t_to_uint64_t(buf, &i);
+        storfsInfo->fragmentLocation = uint8_t_to_link(buf, &i);
         storfsInfo->fileSize = uint8_t_to_uint32_t(buf, &i);
         storfsInfo->crc = uint8_t_to_uint16_t(buf, &i);
     }
 }
 
+static const storfs_name_t *header_view_name(const uint8_t *buf)
+{
+    return &buf[STORFS_HEADER_NAME_OFFSET];
+}
+
+static storfs_size_t header_view_sibling(const uint8_t *buf)
+{
+    uint32_t i = STORFS_HEADER_SIBLING_OFFSET;
+    storfs_size_t siblingLocation = uint8_t_to_link(buf, &i);
+
+    return LINK_FROM_FLASH(buf[0], siblingLocation);
+}
+
+static storfs_size_t header_view_fragment(const uint8_t *buf)
+{
+    //Fragment headers hold their fragment location directly after the info register
+    uint32_t i = ((buf[0] & STORFS_INFO_REG_FILE_TYPE_FILE) == 0) ? STORFS_FRAGMENT_HEADER_FRAGMENT_OFFSET : STORFS_HEADER_FRAGMENT_OFFSET;
+
+    return uint8_t_to_link(buf, &i);
+}
+
 static void uint16_t_to_uint8_t(uint8_t *buf, uint16_t uint16Val, uint32_t *index)
 {
     buf[*(index)+1] = (uint8_t)(uint16Val);
@@ -289,6 +752,7 @@ static void uint32_t_to_uint8_t(uint8_t *buf, uint32_t uint32Val, uint32_t *inde
     *index = *index + 4;
 }
 
+#ifdef STORFS_UINT64_FIELDS
 static void uint64_t_to_uint8_t(uint8_t *buf, uint64_t uint64Val, uint32_t *index)
 {
     buf[*(index)+7] = (uint8_t)(uint64Val);
@@ -302,17 +766,31 @@ static void uint64_t_to_uint8_t(uint8_t *buf, uint64_t uint64Val, uint32_t *inde
 
     *index = *index + 8;
 }
+#endif
+
+static void link_to_uint8_t(uint8_t *buf, storfs_size_t location, uint32_t *index)
+{
+#ifdef STORFS_COMPACT_LINKS
+    uint32_t_to_uint8_t(buf, (uint32_t)location, index);
+#else
+    uint64_t_to_uint8_t(buf, location, index);
+#endif
+}
 
 static void info_to_buf(uint8_t *buf, storfs_file_header_t *storfsInfo)
 {
     uint32_t i = 0;
     buf[i] = storfsInfo->fileInfo;
+#if defined(STORFS_LAZY_DELETE) || defined(STORFS_METADATA_PACK)
+    //Headers are written valid, the bit is cleared once the header is removed
+    buf[i] |= STORFS_INFO_REG_VALID_BIT;
+#endif
     i++;
 
     if((storfsInfo->fileInfo & STORFS_INFO_REG_FILE_TYPE_FILE) == 0)
     {
         uint16_t_to_uint8_t(buf, storfsInfo->reserved, &i);
-        uint64_t_to_uint8_t(buf, storfsInfo->fragmentLocation, &i);
+        link_to_uint8_t(buf, storfsInfo->fragmentLocation, &i);
         uint16_t_to_uint8_t(buf, storfsInfo->crc, &i);
     }
     else
@@ -322,17 +800,17 @@ static void info_to_buf(uint8_t *buf, storfs_file_header_t *storfsInfo)
             buf[i] = storfsInfo->fileName[i - STORFS_INFO_REG_SIZE];
             i++;
         }
-        uint64_t_to_uint8_t(buf, storfsInfo->childLocation, &i);
-        uint64_t_to_uint8_t(buf, storfsInfo->siblingLocation, &i);
+        link_to_uint8_t(buf, LINK_TO_FLASH(storfsInfo->childLocation), &i);
+        link_to_uint8_t(buf, LINK_TO_FLASH(storfsInfo->siblingLocation), &i);
         uint16_t_to_uint8_t(buf, storfsInfo->reserved, &i);
-        uint64_t_to_uint8_t(buf, storfsInfo->fragmentLocation, &i);
+        link_to_uint8_t(buf, storfsInfo->fragmentLocation, &i);
         uint32_t_to_uint8_t(buf, storfsInfo->fileSize, &i);
         uint16_t_to_uint8_t(buf, storfsInfo->crc, &i);
     }
 }
 
 #ifdef STORFS_LOG_DISPLAY_HEADER
-    static void file_info_display_helper(storfs_file_header_t storfsInfo)
+    static void file_info_display_helper(const storfs_file_header_t *storfsInfo)
     {
         STORFS_LOGI(TAG, "\t fileInfo %x \r\n \
         fileName %s \r\n \
@@ -341,14 +819,14 @@ static void info_to_buf(uint8_t *buf, storfs_file_header_t *storfsInfo)
         reserved %x \r\n \
         fragmentLocation/nextOpenByte %lx%lx \r\n \
         fileSize %lx \r\n \
-        crc %x", storfsInfo.fileInfo, storfsInfo.fileName,\
-        (uint32_t)(storfsInfo.childLocation >> 32), (uint32_t)storfsInfo.childLocation, \
-        (uint32_t)(storfsInfo.siblingLocation >> 32), (uint32_t)storfsInfo.siblingLocation, \
-        storfsInfo.reserved, (uint32_t)(storfsInfo.fragmentLocation >> 32), (uint32_t)storfsInfo.fragmentLocation, \
-        storfsInfo.fileSize, storfsInfo.crc);
+        crc %x", storfsInfo->fileInfo, storfsInfo->fileName,\
+        (uint32_t)(storfsInfo->childLocation >> 32), (uint32_t)storfsInfo->childLocation, \
+        (uint32_t)(storfsInfo->siblingLocation >> 32), (uint32_t)storfsInfo->siblingLocation, \
+        storfsInfo->reserved, (uint32_t)(storfsInfo->fragmentLocation >> 32), (uint32_t)storfsInfo->fragmentLocation, \
+        storfsInfo->fileSize, storfsInfo->crc);
     }
 #else
-    static void file_info_display_helper(storfs_file_header_t storfsInfo)
+    static void file_info_display_helper(const storfs_file_header_t *storfsInfo)
     {
         return 0;
     }
@@ -360,7 +838,7 @@ static storfs_err_t file_header_create_helper(storfs_t *storfsInst, storfs_file_
     uint8_t headerBuf[STORFS_HEADER_TOTAL_SIZE];
 
     //If header to create is overflowing the user defined page size or there is no space left in the storage device return an error
-    if(((storfsLoc.byteLoc + STORFS_HEADER_TOTAL_SIZE) > storfsInst->pageSize))
+    if(((storfsLoc.byteLoc + STORFS_HEADER_TOTAL_SIZE) > STORFS_INST_PAGE_SIZE(storfsInst)))
     {
         status = STORFS_WRITE_FAILED;
         goto FUNEND;
@@ -370,87 +848,155 @@ static storfs_err_t file_header_create_helper(storfs_t *storfsInst, storfs_file_
     STORFS_LOGD(TAG, "Writing %s Header at %ld%ld, %ld", string, (uint32_t)(storfsLoc.pageLoc >> 32), \
                 (uint32_t)(storfsLoc.pageLoc),  storfsLoc.byteLoc);
     info_to_buf(headerBuf, storfsInfo);
-    if(storfsInst->write(storfsInst, storfsLoc.pageLoc, storfsLoc.byteLoc, headerBuf, STORFS_HEADER_TOTAL_SIZE) != STORFS_OK)
+    if(STORFS_WRITE(storfsInst, storfsLoc.pageLoc, storfsLoc.byteLoc, headerBuf, STORFS_HEADER_TOTAL_SIZE) != STORFS_OK)
     {
         status = STORFS_WRITE_FAILED;
         goto FUNEND;
     }
-    status = storfsInst->sync(storfsInst);
+    status = STORFS_SYNC(storfsInst);
 
     FUNEND:
         return status;
 }
 
+static storfs_err_t file_header_view_helper(storfs_t *storfsInst, uint8_t *headerBuf, storfs_loc_t storfsLoc, const char *string)
+{
+    STORFS_LOGD(TAG, "Storing %s Header at %ld%ld, %ld", string, (uint32_t)(storfsLoc.pageLoc >> 32), \
+                (uint32_t)(storfsLoc.pageLoc), storfsLoc.byteLoc);
+    if(STORFS_READ(storfsInst, storfsLoc.pageLoc, storfsLoc.byteLoc, headerBuf, STORFS_HEADER_TOTAL_SIZE) != STORFS_OK)
+    {
+        return STORFS_READ_FAILED;
+    }
+
+    return STORFS_SYNC(storfsInst);
+}
+
 static storfs_err_t file_header_store_helper(storfs_t *storfsInst, storfs_file_header_t *storfsInfo, storfs_loc_t storfsLoc, const char *string)
 {
     storfs_err_t status = STORFS_OK;
     uint8_t headerBuf[STORFS_HEADER_TOTAL_SIZE];
 
-    STORFS_LOGD(TAG, "Storing %s Header at %ld%ld, %ld", string, (uint32_t)(storfsLoc.pageLoc >> 32), \
-                (uint32_t)(storfsLoc.pageLoc), storfsLoc.byteLoc);
-    if(storfsInst->read(storfsInst, storfsLoc.pageLoc, storfsLoc.byteLoc, headerBuf, STORFS_HEADER_TOTAL_SIZE) != STORFS_OK)
+    status = file_header_view_helper(storfsInst, headerBuf, storfsLoc, string);
+    if(status == STORFS_READ_FAILED)
     {
-        status = STORFS_READ_FAILED;
         goto FUNEND;
     }
-    status = storfsInst->sync(storfsInst);
 
     buf_to_info(headerBuf, storfsInfo);
+#ifdef STORFS_JOURNAL
+    //Apply any link updates that have not yet been checkpointed
+    journal_apply(storfsInst, storfsLoc, storfsInfo);
+#endif
 
     FUNEND:
         return status;
 }
 
-static storfs_err_t update_root(storfs_t *storfsInst)
+#ifdef STORFS_BAD_BLOCK_TABLE
+static storfs_err_t bad_block_load(storfs_t *storfsInst)
 {
-    //Update both root registers
-    if(storfsInst->erase(storfsInst, storfsInst->cachedInfo.rootLocation[0].pageLoc) != STORFS_OK)
-    {
-        return STORFS_ERROR;
-    }
-    file_header_create_helper(storfsInst, &storfsInst->cachedInfo.rootHeaderInfo[0], storfsInst->cachedInfo.rootLocation[0], "Root Header 1");
-    if(storfsInst->erase(storfsInst, storfsInst->cachedInfo.rootLocation[1].pageLoc) != STORFS_OK)
+    uint8_t tableBuf[STORFS_BAD_BLOCK_TABLE_TOTAL_SIZE(STORFS_BAD_BLOCK_TABLE_SIZE)];
+    uint32_t i;
+    uint32_t crcIndex;
+    uint16_t count;
+    uint16_t sequence;
+    uint8_t found = 0;
+
+    //The next table is stored to the first copy unless a later one is found
+    storfsInst->cachedInfo.badBlockCount = 0;
+    storfsInst->cachedInfo.badBlockSequence = 0;
+    storfsInst->cachedInfo.badBlockCurrent = 1;
+
+    //The table is held twice, the valid copy with the later sequence number holds the latest table
+    for(uint8_t copy = 0; copy < 2; copy++)
     {
-        return STORFS_ERROR;
+        if(STORFS_READ(storfsInst, storfsInst->cachedInfo.badBlockLocation[copy], 0, tableBuf, sizeof(tableBuf)) != STORFS_OK)
+        {
+            return STORFS_READ_FAILED;
+        }
+        if(STORFS_SYNC(storfsInst) != STORFS_OK)
+        {
+            return STORFS_ERROR;
+        }
+
+        //An erased copy has no bad pages recorded
+        i = 0;
+        count = uint8_t_to_uint16_t(tableBuf, &i);
+        sequence = uint8_t_to_uint16_t(tableBuf, &i);
+        if(count == 0xFFFF)
+        {
+            continue;
+        }
+
+        //Verify the copy before trusting it, a copy left part way through being written is passed over
+        crcIndex = STORFS_BAD_BLOCK_TABLE_TOTAL_SIZE(count) - STORFS_CRC_SIZE;
+        if(count > STORFS_BAD_BLOCK_TABLE_SIZE || 
+            uint8_t_to_uint16_t(tableBuf, &crcIndex) != (storfs_crc_t)STORFS_CRC_CALC(storfsInst, tableBuf, (STORFS_BAD_BLOCK_TABLE_TOTAL_SIZE(count) - STORFS_CRC_SIZE)))
+        {
+            STORFS_LOGW(TAG, "Copy %d of the bad block table is corrupted", copy);
+            continue;
+        }
+        if(found && (int16_t)(sequence - storfsInst->cachedInfo.badBlockSequence) <= 0)
+        {
+            continue;
+        }
+
+        for(int j = 0; j < count; j++)
+        {
+            storfsInst->cachedInfo.badBlockTable[j] = uint8_t_to_uint64_t(tableBuf, &i);
+        }
+        storfsInst->cachedInfo.badBlockCount = count;
+        storfsInst->cachedInfo.badBlockSequence = sequence;
+        storfsInst->cachedInfo.badBlockCurrent = copy;
+        found = 1;
     }
-    file_header_create_helper(storfsInst, &storfsInst->cachedInfo.rootHeaderInfo[1], storfsInst->cachedInfo.rootLocation[1], "Root Header 2");
+
+    STORFS_LOGD(TAG, "Loaded %d bad pages from the bad block table", storfsInst->cachedInfo.badBlockCount);
 
     return STORFS_OK;
 }
 
-static storfs_err_t update_root_next_open_byte(storfs_t *storfsInst, storfs_size_t fileLocation)
+static storfs_err_t bad_block_store(storfs_t *storfsInst)
 {
-    //Update the cached information with the next open byte
-    storfsInst->cachedInfo.nextOpenByte = fileLocation;
-
-    //Update the next open byte info in the cached rootInfo
-    storfsInst->cachedInfo.rootHeaderInfo[0].fragmentLocation = fileLocation;
-    storfsInst->cachedInfo.rootHeaderInfo[1].fragmentLocation = fileLocation;
+    uint8_t tableBuf[STORFS_BAD_BLOCK_TABLE_TOTAL_SIZE(STORFS_BAD_BLOCK_TABLE_SIZE)];
+    uint32_t i = 0;
+    uint16_t count = storfsInst->cachedInfo.badBlockCount;
+    uint16_t sequence = storfsInst->cachedInfo.badBlockSequence + 1;
+    uint8_t copy = !storfsInst->cachedInfo.badBlockCurrent;
+
+    //Convert the cached table to a buffer to be written to memory
+    uint16_t_to_uint8_t(tableBuf, count, &i);
+    uint16_t_to_uint8_t(tableBuf, sequence, &i);
+    for(int j = 0; j < count; j++)
+    {
+        uint64_t_to_uint8_t(tableBuf, storfsInst->cachedInfo.badBlockTable[j], &i);
+    }
+    uint16_t_to_uint8_t(tableBuf, STORFS_CRC_CALC(storfsInst, tableBuf, i), &i);
 
-    if(update_root(storfsInst) != STORFS_OK)
+    //Overwrite the older copy, the latest is left intact until the new one has been written
+    if(STORFS_ERASE(storfsInst, storfsInst->cachedInfo.badBlockLocation[copy]) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+    if(STORFS_WRITE(storfsInst, storfsInst->cachedInfo.badBlockLocation[copy], 0, tableBuf, i) != STORFS_OK)
+    {
+        return STORFS_WRITE_FAILED;
+    }
+    if(STORFS_SYNC(storfsInst) != STORFS_OK)
     {
         return STORFS_ERROR;
     }
+    storfsInst->cachedInfo.badBlockSequence = sequence;
+    storfsInst->cachedInfo.badBlockCurrent = copy;
 
     return STORFS_OK;
 }
 
-static storfs_err_t find_next_open_byte_helper (storfs_t *storfsInst, storfs_loc_t *storfsLoc)
+static storfs_err_t bad_block_check(storfs_t *storfsInst, storfs_page_t page)
 {
-    storfs_file_header_t nextHeaderInfo;
-    nextHeaderInfo.fragmentLocation = 0;
-    nextHeaderInfo.fileInfo = 0x80;
-
-    //Determine where the next open byte within the system is
-    while(nextHeaderInfo.fragmentLocation != 0xFFFFFFFFFFFFFFFF || nextHeaderInfo.siblingLocation != 0xFFFFFFFFFFFFFFFF || \
-    nextHeaderInfo.childLocation != 0xFFFFFFFFFFFFFFFF || nextHeaderInfo.fileInfo != 0xFF)
+    for(int i = 0; i < storfsInst->cachedInfo.badBlockCount; i++)
     {
-        storfsLoc->pageLoc += 1;
-        if(storfsLoc->byteLoc != 0)
-        {
-            storfsLoc->byteLoc = 0;
-        }
-        if(file_header_store_helper(storfsInst, &nextHeaderInfo, *storfsLoc, "Next") != STORFS_OK)
+        if(storfsInst->cachedInfo.badBlockTable[i] == page)
         {
             return STORFS_ERROR;
         }
@@ -459,1487 +1005,5071 @@ static storfs_err_t find_next_open_byte_helper (storfs_t *storfsInst, storfs_loc
     return STORFS_OK;
 }
 
-static storfs_err_t find_update_next_open_byte(storfs_t *storfsInst, storfs_loc_t storfsLoc)
+static storfs_err_t bad_block_mark(storfs_t *storfsInst, storfs_page_t page)
 {
-    STORFS_LOGD(TAG, "Finding and updating next open byte");
-    if(find_next_open_byte_helper(storfsInst, &storfsLoc) != STORFS_OK)
+    //Page is already known to be bad
+    if(bad_block_check(storfsInst, page) != STORFS_OK)
+    {
+        return STORFS_OK;
+    }
+
+    if(storfsInst->cachedInfo.badBlockCount >= STORFS_BAD_BLOCK_TABLE_SIZE)
     {
+        STORFS_LOGW(TAG, "Bad block table is full, page %ld%ld will not be recorded", (uint32_t)(page >> 32), (uint32_t)(page));
         return STORFS_ERROR;
     }
-    
-    //Update the next open byte available
-    update_root_next_open_byte(storfsInst, BYTEPAGE_TO_LOCATION(0, storfsLoc.pageLoc, storfsInst));
 
-    return STORFS_OK;
+    STORFS_LOGW(TAG, "Marking page %ld%ld as bad", (uint32_t)(page >> 32), (uint32_t)(page));
+    storfsInst->cachedInfo.badBlockTable[storfsInst->cachedInfo.badBlockCount++] = page;
+
+    return bad_block_store(storfsInst);
 }
+#endif
 
-static storfs_err_t file_handling_helper(storfs_t *storfsInst, storfs_name_t *pathToDir, file_action_t actionFlag, void *buff)
+#ifdef STORFS_L2P_MAP
+static storfs_err_t l2p_load(storfs_t *storfsInst, storfs_err_t format)
 {
-    int strLen = 0;                                                         //String length of the path used
-    int currStr;                                                            //String length to hold the current file/directory in the path          
-    storfs_loc_t currentLocation = storfsInst->cachedInfo.rootLocation[0];  //Location of the current directory to obtain information
-    STORFS_FILE previousFile;                                               //Information and location of the previous file
-    uint8_t fileSepCnt = 0;                                                 //File separator count to ensure files do no have children
-    path_flag_t pathFlag = PATH_LEFT;
-    wear_level_t wearLevelInfo;
-    uint8_t updatedHeader[STORFS_HEADER_TOTAL_SIZE];
+    uint8_t mapBuf[STORFS_L2P_MAP_TOTAL_SIZE(STORFS_L2P_MAP_SIZE)];
+    uint32_t i = 0;
+    uint32_t crcIndex;
+    uint16_t count;
 
-    while(1)
+    //Spare pages are taken from the end of the storage device
+    storfsInst->cachedInfo.l2pCount = 0;
+    storfsInst->cachedInfo.l2pNextSpare = STORFS_LOGICAL_PAGE_COUNT(storfsInst);
+
+    //When creating the file system, start with an empty map
+    if(format == STORFS_OK)
     {
-        storfs_name_t currentFileName[STORFS_MAX_FILE_NAME];
-        currStr = 0;
-        while((pathToDir[strLen] != '/') && (pathToDir[strLen] != '\0'))
+        if(STORFS_DEVICE_OP(storfsInst, STORFS_BUSY_ERASE, storfsInst->erase(storfsInst, storfsInst->cachedInfo.l2pLocation)) != STORFS_OK)
         {
-            if(pathToDir[strLen] == '.')
-            {
-                if(actionFlag == DIR_CREATE)
-                {
-                    STORFS_LOGE(TAG, "Directory name cannot have an extension");
-                    return STORFS_ERROR; 
-                }
-                fileSepCnt++;
-            }
-            currentFileName[currStr++] = pathToDir[strLen++];
+            return STORFS_ERROR;
         }
-        currentFileName[currStr] = '\0';
-        STORFS_LOGD(TAG, "File name %s", currentFileName);
+        return STORFS_OK;
+    }
 
-        if(pathToDir[strLen] == '\0')
+    if(STORFS_DEVICE_READ(storfsInst, storfsInst->cachedInfo.l2pLocation, 0, mapBuf, sizeof(mapBuf)) != STORFS_OK)
+    {
+        return STORFS_READ_FAILED;
+    }
+    if(STORFS_SYNC(storfsInst) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+
+    //An erased map has no pages remapped
+    count = uint8_t_to_uint16_t(mapBuf, &i);
+    if(count == 0xFFFF)
+    {
+        return STORFS_OK;
+    }
+
+    //A corrupted map cannot be recovered from, the remapped data would be lost
+    crcIndex = STORFS_L2P_MAP_TOTAL_SIZE(count) - STORFS_CRC_SIZE;
+    if(count > STORFS_L2P_MAP_SIZE || 
+        uint8_t_to_uint16_t(mapBuf, &crcIndex) != (storfs_crc_t)STORFS_CRC_CALC(storfsInst, mapBuf, (STORFS_L2P_MAP_TOTAL_SIZE(count) - STORFS_CRC_SIZE)))
+    {
+        STORFS_LOGE(TAG, "Logical to physical map is corrupted");
+        return STORFS_CRC_ERR;
+    }
+
+    for(int j = 0; j < count; j++)
+    {
+        storfsInst->cachedInfo.l2pLogical[j] = uint8_t_to_uint64_t(mapBuf, &i);
+        storfsInst->cachedInfo.l2pPhysical[j] = uint8_t_to_uint64_t(mapBuf, &i);
+
+        //Spares are handed out in order, the next spare follows the highest one used
+        if(storfsInst->cachedInfo.l2pPhysical[j] >= storfsInst->cachedInfo.l2pNextSpare)
         {
-            pathFlag = PATH_LAST;
+            storfsInst->cachedInfo.l2pNextSpare = storfsInst->cachedInfo.l2pPhysical[j] + 1;
         }
+    }
+    storfsInst->cachedInfo.l2pCount = count;
 
-        do
-        {
-            //Store the current file header
-            if(file_header_store_helper(storfsInst,  &wearLevelInfo.storfsInfo, currentLocation, "Directory") != STORFS_OK)
-            {
-                return STORFS_ERROR;
-            }
+    STORFS_LOGD(TAG, "Loaded %d remapped pages from the logical to physical map", count);
 
-            //Does the current file header name equal to the name in the path?
-            if(strcmp((const char *)wearLevelInfo.storfsInfo.fileName, (const char *)currentFileName) == 0)
-            {
-                //If the filename is matched it is a parent directory, update the previous file information with the current
-                STORFS_LOGD(TAG, "File name matched: %s", currentFileName);
-
-                if(pathFlag == PATH_LAST)
-                {
-                    break;
-                }
+    return STORFS_OK;
+}
 
-                //If there is no child location update the child's location to the next open byte
-                if(wearLevelInfo.storfsInfo.childLocation == 0x0)
-                {
-                    wearLevelInfo.storfsInfo.childLocation = storfsInst->cachedInfo.nextOpenByte;
-                }
+static storfs_err_t l2p_store(storfs_t *storfsInst)
+{
+    uint8_t mapBuf[STORFS_L2P_MAP_TOTAL_SIZE(STORFS_L2P_MAP_SIZE)];
+    uint32_t i = 0;
+    uint16_t count = storfsInst->cachedInfo.l2pCount;
 
-                previousFile.fileLoc = currentLocation;
-                previousFile.filePrevLoc = currentLocation;
-                previousFile.fileInfo = wearLevelInfo.storfsInfo;
-                previousFile.filePrevFlags = STORFS_FILE_PARENT_FLAG;
+    //Convert the cached map to a buffer to be written to memory
+    uint16_t_to_uint8_t(mapBuf, count, &i);
+    for(int j = 0; j < count; j++)
+    {
+        uint64_t_to_uint8_t(mapBuf, storfsInst->cachedInfo.l2pLogical[j], &i);
+        uint64_t_to_uint8_t(mapBuf, storfsInst->cachedInfo.l2pPhysical[j], &i);
+    }
+    uint16_t_to_uint8_t(mapBuf, STORFS_CRC_CALC(storfsInst, mapBuf, i), &i);
 
-                //Continue to search the child's location if it is not the last line throughout the path
-                currentLocation.pageLoc = LOCATION_TO_PAGE(wearLevelInfo.storfsInfo.childLocation, storfsInst);
-                currentLocation.byteLoc = LOCATION_TO_BYTE(wearLevelInfo.storfsInfo.childLocation, storfsInst);
-            }
-            else if (wearLevelInfo.storfsInfo.siblingLocation != 0xFFFFFFFFFFFFFFFF)
-            {
-                //If there is no sibling location update the sibling's location to the next open byte
-                if(wearLevelInfo.storfsInfo.siblingLocation == 0x0)
-                {
-                    wearLevelInfo.storfsInfo.siblingLocation = storfsInst->cachedInfo.nextOpenByte;
-                }
+    //The map itself is never remapped, access it directly
+    if(STORFS_DEVICE_OP(storfsInst, STORFS_BUSY_ERASE, storfsInst->erase(storfsInst, storfsInst->cachedInfo.l2pLocation)) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+    if(STORFS_DEVICE_WRITE(storfsInst, storfsInst->cachedInfo.l2pLocation, 0, mapBuf, i) != STORFS_OK)
+    {
+        return STORFS_WRITE_FAILED;
+    }
 
-                //If the filename is not matched and the sibling location exists, it is a sibling directory
-                //Update the previous file information with the current
-                STORFS_LOGD(TAG, "Name not matched, searching siblings");
-                previousFile.fileLoc = currentLocation;
-                previousFile.filePrevLoc = currentLocation;
-                previousFile.filePrevFlags = STORFS_FILE_SIBLING_FLAG;
-                previousFile.fileInfo = wearLevelInfo.storfsInfo;
+    return STORFS_SYNC(storfsInst);
+}
 
-                //Continue to search the siblings's location
-                currentLocation.pageLoc = LOCATION_TO_PAGE(wearLevelInfo.storfsInfo.siblingLocation, storfsInst);
-                currentLocation.byteLoc = LOCATION_TO_BYTE(wearLevelInfo.storfsInfo.siblingLocation, storfsInst);
-            }
-            else
-            {
-                STORFS_LOGD(TAG, "Name not matched, and no siblings, creating file/directory at next open location");
+static storfs_page_t l2p_translate(storfs_t *storfsInst, storfs_page_t page)
+{
+    for(int i = 0; i < storfsInst->cachedInfo.l2pCount; i++)
+    {
+        if(storfsInst->cachedInfo.l2pLogical[i] == page)
+        {
+            return storfsInst->cachedInfo.l2pPhysical[i];
+        }
+    }
 
-                //Error is next write is larger than the page count
-                if(LOCATION_TO_PAGE(storfsInst->cachedInfo.nextOpenByte, storfsInst) >= storfsInst->pageCount)
-                {
-                    STORFS_LOGE(TAG, "Cannot write any more data to the file system");
-                }
+    return page;
+}
 
-                //Files cannot be children of other files
-                if(fileSepCnt > 1)
-                {
-                    STORFS_LOGE(TAG, "File/directory cannot be a child of another file");
-                    return STORFS_ERROR;
-                }
+static storfs_err_t l2p_remap(storfs_t *storfsInst, storfs_page_t page)
+{
+    int entry = 0;
 
-                //Set information for the header of the current file directory
-                for(int i = 0; i <= currStr; i++)
-                {
-                    wearLevelInfo.storfsInfo.fileName[i] = currentFileName[i];
-                }
-                wearLevelInfo.storfsInfo.reserved = 0xFFFF;
-                wearLevelInfo.storfsInfo.fileSize = STORFS_HEADER_TOTAL_SIZE;
+    //Determine if the page has been remapped before, if so the spare it is on has failed as well
+    while(entry < storfsInst->cachedInfo.l2pCount && storfsInst->cachedInfo.l2pLogical[entry] != page)
+    {
+        entry++;
+    }
 
-                //Set the current directory fragment, sibling and child location registers to zero
-                //These locations will never be zero as long as the file system exists, it is a safe value to set these
-                wearLevelInfo.storfsInfo.siblingLocation = 0;
-                wearLevelInfo.storfsInfo.childLocation = 0;
-                wearLevelInfo.storfsInfo.fragmentLocation = 0;
+    if(storfsInst->cachedInfo.l2pNextSpare < STORFS_LOGICAL_PAGE_COUNT(storfsInst) || 
+        storfsInst->cachedInfo.l2pNextSpare >= STORFS_INST_PAGE_COUNT(storfsInst) || entry >= STORFS_L2P_MAP_SIZE)
+    {
+        STORFS_LOGW(TAG, "No spare pages left to remap page %ld%ld", (uint32_t)(page >> 32), (uint32_t)(page));
+        return STORFS_ERROR;
+    }
 
-                //Compute CRC of the filename given
-                wearLevelInfo.storfsInfo.crc = STORFS_CRC_CALC(storfsInst, wearLevelInfo.storfsInfo.fileName, (currStr+1));
+    //Ensure the spare is ready to be programmed
+    if(STORFS_DEVICE_OP(storfsInst, STORFS_BUSY_ERASE, storfsInst->erase(storfsInst, storfsInst->cachedInfo.l2pNextSpare)) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
 
-                //If the file size will be the size of the page size, ensure the file info sets the information for the file to full
-                if(actionFlag == DIR_CREATE)
-                {
-                    wearLevelInfo.storfsInfo.fileInfo = STORFS_INFO_REG_FILE_TYPE_DIRECTORY | STORFS_INFO_REG_BLOCK_SIGN_FULL;
-                }
-                else
-                {
-                    wearLevelInfo.storfsInfo.fileInfo = STORFS_INFO_REG_FILE_TYPE_FILE | STORFS_INFO_REG_BLOCK_SIGN_PART_FULL;
-                }
+    STORFS_LOGW(TAG, "Remapping page %ld%ld to spare page %ld%ld", (uint32_t)(page >> 32), (uint32_t)(page), \
+                (uint32_t)(storfsInst->cachedInfo.l2pNextSpare >> 32), (uint32_t)(storfsInst->cachedInfo.l2pNextSpare));
+    storfsInst->cachedInfo.l2pLogical[entry] = page;
+    storfsInst->cachedInfo.l2pPhysical[entry] = storfsInst->cachedInfo.l2pNextSpare++;
+    if(entry == storfsInst->cachedInfo.l2pCount)
+    {
+        storfsInst->cachedInfo.l2pCount++;
+    }
 
-                info_to_buf(updatedHeader, &wearLevelInfo.storfsInfo);
-                wearLevelInfo.sendBuf = updatedHeader;
-                wearLevelInfo.headerLen = STORFS_HEADER_TOTAL_SIZE;
-                wearLevelInfo.sendDataLen = STORFS_HEADER_TOTAL_SIZE;
-                wearLevelInfo.storfsCurrLoc = &currentLocation;
-                wearLevelInfo.storfsInfoLoc = currentLocation;
-                wearLevelInfo.storfsOrigLoc = currentLocation;
-                wearLevelInfo.storfsPrevLoc = previousFile.fileLoc;
-                wearLevelInfo.storfsFlags = STORFS_FILE_INIT_HEADER_WRITE | previousFile.filePrevFlags;
+    return l2p_store(storfsInst);
+}
+#endif
 
-                //Write the new header to the needed location in flash
-                write_wear_level_helper(storfsInst, &wearLevelInfo);
+#ifdef STORFS_JOURNAL
+static storfs_err_t journal_load(storfs_t *storfsInst, storfs_err_t format)
+{
+    uint8_t recordBuf[STORFS_JOURNAL_RECORD_SIZE];
+    storfs_loc_t *head = &storfsInst->cachedInfo.journalHead;
+    uint32_t i;
+    uint8_t type;
+    storfs_size_t location;
+    storfs_size_t value;
+
+    storfsInst->cachedInfo.journalCount = 0;
+    head->pageLoc = storfsInst->cachedInfo.journalLocation;
+    head->byteLoc = 0;
+
+    //When creating the file system, start with an empty journal
+    if(format == STORFS_OK)
+    {
+        for(int j = 0; j < STORFS_JOURNAL_PAGES; j++)
+        {
+            if(STORFS_DEVICE_ERASE(storfsInst, storfsInst->cachedInfo.journalLocation + j) != STORFS_OK)
+            {
+                return STORFS_ERROR;
+            }
+        }
+        return STORFS_OK;
+    }
 
-                //Display the newly created file information
-                file_info_display_helper(wearLevelInfo.storfsInfo);
+    //Replay each record in the order it was appended until an empty record is found
+    while(head->pageLoc < (storfsInst->cachedInfo.journalLocation + STORFS_JOURNAL_PAGES))
+    {
+        if((head->byteLoc + STORFS_JOURNAL_RECORD_SIZE) > STORFS_INST_PAGE_SIZE(storfsInst))
+        {
+            head->pageLoc++;
+            head->byteLoc = 0;
+            continue;
+        }
 
-                //Determine the next open byte for the cache and update root header if needed
-                if(find_update_next_open_byte(storfsInst, currentLocation) != STORFS_OK)
-                {
-                    return STORFS_ERROR;
-                }
-                break;
-            }
-        } while(previousFile.filePrevFlags == STORFS_FILE_SIBLING_FLAG);
+        if(STORFS_READ(storfsInst, head->pageLoc, head->byteLoc, recordBuf, STORFS_JOURNAL_RECORD_SIZE) != STORFS_OK)
+        {
+            return STORFS_READ_FAILED;
+        }
+        if(STORFS_SYNC(storfsInst) != STORFS_OK)
+        {
+            return STORFS_ERROR;
+        }
 
-        if(pathFlag == PATH_LAST)
+        i = 0;
+        type = recordBuf[i++];
+        if(type == STORFS_JOURNAL_EMPTY)
         {
             break;
         }
+        location = uint8_t_to_uint64_t(recordBuf, &i);
+        value = uint8_t_to_uint64_t(recordBuf, &i);
 
-        strLen += 1;
+        //A record torn by a power loss is skipped, it was never acknowledged
+        if(uint8_t_to_uint16_t(recordBuf, &i) == (storfs_crc_t)STORFS_CRC_CALC(storfsInst, recordBuf, (STORFS_JOURNAL_RECORD_SIZE - STORFS_CRC_SIZE)))
+        {
+            journal_replay(storfsInst, type, location, value);
+        }
+        else
+        {
+            STORFS_LOGW(TAG, "Skipping corrupted journal record");
+        }
+        head->byteLoc += STORFS_JOURNAL_RECORD_SIZE;
     }
 
-    //If action is to open the file and store the memory location to the buffer passed in
-    if(actionFlag == FILE_OPEN)
-    {
-        //If the file was just created and file action is FILE_OPEN ensure that the current location is used as the previous location
-        previousFile.fileLoc = currentLocation;
-        previousFile.fileInfo = wearLevelInfo.storfsInfo;
-        *(STORFS_FILE *)buff = previousFile;
-    }
+    STORFS_LOGD(TAG, "Replayed journal, %d link updates pending", storfsInst->cachedInfo.journalCount);
 
     return STORFS_OK;
 }
 
-static storfs_err_t fopen_write_flag_helper(storfs_t *storfsInst, char *pathToFile, STORFS_FILE *currentOpenFile)
+static storfs_err_t journal_append(storfs_t *storfsInst, uint8_t type, storfs_size_t location, storfs_size_t value)
 {
-    STORFS_FILE newOpenFile = *currentOpenFile;
-    uint32_t strLen = 0;
+    uint8_t recordBuf[STORFS_JOURNAL_RECORD_SIZE];
+    storfs_loc_t recordLoc = storfsInst->cachedInfo.journalHead;
+    uint8_t newEntry = 0;
+    uint32_t i = 0;
+    storfs_err_t status;
 
-    //Remove the file since it exists 
-    if(file_delete_helper(storfsInst, currentOpenFile->fileLoc, currentOpenFile->fileInfo) != STORFS_OK)
+    //Determine whether a link update needs a new entry within the cache
+    if(type == STORFS_JOURNAL_CHILD || type == STORFS_JOURNAL_SIBLING)
     {
-        STORFS_LOGE(TAG, "Cannot delete the old file");
-        return STORFS_ERROR;
+        newEntry = 1;
+        for(int j = 0; j < storfsInst->cachedInfo.journalCount; j++)
+        {
+            if(storfsInst->cachedInfo.journalEntries[j].location == location && storfsInst->cachedInfo.journalEntries[j].type == type)
+            {
+                newEntry = 0;
+            }
+        }
+#ifdef STORFS_OPEN_FILE_TABLE
+        //The header held by an open stream no longer matches once the journal updates its links
+        open_file_touch(storfsInst, LOCATION_TO_PAGE(location, storfsInst));
+#endif
     }
-    
-    //Recreate file header
-    currentOpenFile->fileInfo.fileSize = STORFS_HEADER_TOTAL_SIZE;
-    currentOpenFile->fileInfo.fragmentLocation = 0x00;
-    while(currentOpenFile->fileInfo.fileName[strLen++] != '\0');
-    currentOpenFile->fileInfo.crc = STORFS_CRC_CALC(storfsInst, currentOpenFile->fileInfo.fileName, strLen);
-    while(1)
+
+    //Records never cross a page boundary
+    if((recordLoc.byteLoc + STORFS_JOURNAL_RECORD_SIZE) > STORFS_INST_PAGE_SIZE(storfsInst))
     {
-        if(file_header_create_helper(storfsInst, &currentOpenFile->fileInfo, currentOpenFile->fileLoc, "Deleting old file and opening new") != STORFS_OK)
+        recordLoc.pageLoc++;
+        recordLoc.byteLoc = 0;
+    }
+
+    //Within a transaction nothing is written into the tree before the commit, so fail the update rather than checkpoint,
+    //room is kept within the journal for the commit to append every cached link update followed by the root
+    if(storfsInst->cachedInfo.journalTransaction && (newEntry || type == STORFS_JOURNAL_DROP))
+    {
+        if((storfsInst->cachedInfo.journalCount + newEntry) > STORFS_JOURNAL_ENTRIES || 
+            (storfsInst->cachedInfo.journalCount + newEntry + (type == STORFS_JOURNAL_DROP) + 1) > journal_records_left(storfsInst))
         {
-            STORFS_LOGE(TAG, "Cannot create the old file");
-            return STORFS_ERROR;
+            STORFS_LOGE(TAG, "The transaction has filled the journal");
+            return STORFS_WRITE_FAILED;
         }
-        if(crc_header_check(storfsInst, currentOpenFile->fileLoc) == STORFS_OK)
+    }
+
+    //If the journal is full write everything into the tree
+    if(recordLoc.pageLoc >= (storfsInst->cachedInfo.journalLocation + STORFS_JOURNAL_PAGES) || 
+        (newEntry && storfsInst->cachedInfo.journalCount >= STORFS_JOURNAL_ENTRIES))
+    {
+        status = journal_checkpoint(storfsInst);
+
+        //The checkpoint has written the current root and cleared the updates of erased pages
+        if(status != STORFS_OK || !newEntry)
         {
-                break;
+            return status;
         }
-        find_next_open_byte_helper(storfsInst, &currentOpenFile->fileLoc);
+        recordLoc = storfsInst->cachedInfo.journalHead;
     }
-    
 
-    //Find the next available open byte
-    if(find_update_next_open_byte(storfsInst, newOpenFile.fileLoc) != STORFS_OK)
+    //Within a transaction root and link updates are only held in the cache until committed
+    if(storfsInst->cachedInfo.journalTransaction && type != STORFS_JOURNAL_DROP)
+    {
+        journal_replay(storfsInst, type, location, value);
+        return STORFS_OK;
+    }
+
+    recordBuf[i++] = type;
+    uint64_t_to_uint8_t(recordBuf, location, &i);
+    uint64_t_to_uint8_t(recordBuf, value, &i);
+    uint16_t_to_uint8_t(recordBuf, STORFS_CRC_CALC(storfsInst, recordBuf, i), &i);
+
+    //Program the record after the previous one, no erase is needed
+    if(STORFS_WRITE(storfsInst, recordLoc.pageLoc, recordLoc.byteLoc, recordBuf, STORFS_JOURNAL_RECORD_SIZE) != STORFS_OK)
+    {
+        return STORFS_WRITE_FAILED;
+    }
+    if(STORFS_SYNC(storfsInst) != STORFS_OK)
     {
         return STORFS_ERROR;
-    }   
+    }
+
+    recordLoc.byteLoc += STORFS_JOURNAL_RECORD_SIZE;
+    storfsInst->cachedInfo.journalHead = recordLoc;
+    journal_replay(storfsInst, type, location, value);
 
     return STORFS_OK;
 }
 
-static storfs_err_t file_delete_helper(storfs_t *storfsInst, storfs_loc_t storfsLoc, storfs_file_header_t storfsInfo)
+static void journal_replay(storfs_t *storfsInst, uint8_t type, storfs_size_t location, storfs_size_t value)
 {
-    int32_t delDataItr = 0;
-    storfs_loc_t delDataHeaderLoc = storfsLoc;            //Location of the file to be removed
-    storfs_file_header_t currHeaderInfo = storfsInfo;     //Information of the file to be removed
+    storfs_cached_info_t *cache = &storfsInst->cachedInfo;
+    int j;
 
-    //Determine the number of iterations for deletion of files 
-    delDataItr = (storfsInfo.fileSize + storfsInst->pageSize) / storfsInst->pageSize;
-    delDataHeaderLoc.byteLoc = 0;
-
-    do
+    switch(type)
     {
-        STORFS_LOGD(TAG, "Deleting File/Fragment At %ld%ld, %ld", (uint32_t)(delDataHeaderLoc.pageLoc >> 32),(uint32_t)(delDataHeaderLoc.pageLoc),  delDataHeaderLoc.byteLoc);
-
-        //Erase the current page
-        if(storfsInst->erase(storfsInst, delDataHeaderLoc.pageLoc) != STORFS_OK)
-        {
-            STORFS_LOGE(TAG, "Erasing page failed in function remove");
-            return STORFS_ERROR;
-        }
+        case STORFS_JOURNAL_ROOT:
+            //The root stores its child location and the next open byte
+            cache->rootHeaderInfo[0].childLocation = location;
+            cache->rootHeaderInfo[1].childLocation = location;
+            cache->rootHeaderInfo[0].fragmentLocation = value;
+            cache->rootHeaderInfo[1].fragmentLocation = value;
+            cache->nextOpenByte = value;
+            break;
 
-        delDataItr--;
-        if(delDataItr > 0)
-        {
-            //Set the next location to what is in the erased page's header
-            delDataHeaderLoc.pageLoc = LOCATION_TO_PAGE(currHeaderInfo.fragmentLocation, storfsInst);
+        case STORFS_JOURNAL_CHILD:
+        case STORFS_JOURNAL_SIBLING:
+            //Update the entry for the header if it exists, if not add it
+            for(j = 0; j < cache->journalCount; j++)
+            {
+                if(cache->journalEntries[j].location == location && cache->journalEntries[j].type == type)
+                {
+                    break;
+                }
+            }
+            if(j == cache->journalCount)
+            {
+                if(cache->journalCount >= STORFS_JOURNAL_ENTRIES)
+                {
+                    STORFS_LOGE(TAG, "Journal cache overflow");
+                    break;
+                }
+                cache->journalCount++;
+            }
+            cache->journalEntries[j].location = location;
+            cache->journalEntries[j].value = value;
+            cache->journalEntries[j].type = type;
+            break;
 
-            //Store the next locations header information
-            if(file_header_store_helper(storfsInst, &currHeaderInfo, delDataHeaderLoc, "") != STORFS_OK)
+        case STORFS_JOURNAL_DROP:
+            //Remove the entries of every header within the erased page
+            j = 0;
+            while(j < cache->journalCount)
             {
-                STORFS_LOGE(TAG, "Could not read from the current header");
-                return STORFS_ERROR;
+                if(LOCATION_TO_PAGE(cache->journalEntries[j].location, storfsInst) == LOCATION_TO_PAGE(location, storfsInst))
+                {
+                    cache->journalEntries[j] = cache->journalEntries[--cache->journalCount];
+                }
+                else
+                {
+                    j++;
+                }
             }
-        }
-    } while (delDataItr > 0);
+            break;
 
-    return STORFS_OK;
+        default:
+            break;
+    }
 }
 
-static storfs_err_t directory_delete_helper(storfs_t *storfsInst, storfs_loc_t rmParentLoc, storfs_file_header_t rmParentHeader)
+static void journal_apply(storfs_t *storfsInst, storfs_loc_t storfsLoc, storfs_file_header_t *storfsInfo)
 {
-    STORFS_LOGI(TAG, "Deleting directory and all of it's containing files");
-
-    //Remove the directory
-    if(file_delete_helper(storfsInst, rmParentLoc, rmParentHeader) != STORFS_OK)
+    //Link updates are only held for file, directory and root headers
+    if((storfsInfo->fileInfo & STORFS_INFO_REG_FILE_TYPE_FILE) == STORFS_INFO_REG_FILE_TYPE_FILE_FRAGMENT)
     {
-        return STORFS_ERROR;
+        return;
     }
 
-    //If the parent header has a child location, ensure the children get deleted
-    if(rmParentHeader.childLocation != 0x00)
+    journal_link_apply(storfsInst, storfsLoc, STORFS_JOURNAL_CHILD, &storfsInfo->childLocation);
+    journal_link_apply(storfsInst, storfsLoc, STORFS_JOURNAL_SIBLING, &storfsInfo->siblingLocation);
+}
+
+static void journal_link_apply(storfs_t *storfsInst, storfs_loc_t storfsLoc, uint8_t type, storfs_size_t *link)
+{
+    storfs_size_t location = BYTEPAGE_TO_LOCATION(storfsLoc.byteLoc, storfsLoc.pageLoc, storfsInst);
+
+    for(int j = 0; j < storfsInst->cachedInfo.journalCount; j++)
+    {
+        if(storfsInst->cachedInfo.journalEntries[j].location == location && storfsInst->cachedInfo.journalEntries[j].type == type)
         {
-            storfs_file_header_t rmChildHeader;
-            storfs_loc_t rmChildFileLoc;
-            rmChildFileLoc.pageLoc = LOCATION_TO_PAGE(rmParentHeader.childLocation, storfsInst);
-            rmChildFileLoc.byteLoc = LOCATION_TO_BYTE(rmParentHeader.childLocation, storfsInst);
+            *link = storfsInst->cachedInfo.journalEntries[j].value;
+        }
+    }
+}
 
-            file_header_store_helper(storfsInst, &rmChildHeader, rmChildFileLoc, "Remove");
-            while(1)
-            {
-                //If a directory needs to be deleted, iterate through this
-                if(rmChildHeader.childLocation != 0x00)
-                {
-                    if(directory_delete_helper(storfsInst, rmChildFileLoc, rmChildHeader) != STORFS_OK)
-                    {
-                        return STORFS_ERROR;
-                    }
-                    rmChildFileLoc.pageLoc = LOCATION_TO_PAGE(rmChildHeader.childLocation, storfsInst);
-                    rmChildFileLoc.byteLoc = LOCATION_TO_BYTE(rmChildHeader.childLocation, storfsInst);
+static storfs_err_t journal_link_update(storfs_t *storfsInst, wear_level_t *wearLevelInfo)
+{
+    storfs_file_header_t prevInfo;
+    storfs_size_t prevLocation = BYTEPAGE_TO_LOCATION(wearLevelInfo->storfsPrevLoc.byteLoc, wearLevelInfo->storfsPrevLoc.pageLoc, storfsInst);
+    storfs_size_t origLocation = BYTEPAGE_TO_LOCATION(wearLevelInfo->storfsOrigLoc.byteLoc, wearLevelInfo->storfsOrigLoc.pageLoc, storfsInst);
+    storfs_size_t currLocation = BYTEPAGE_TO_LOCATION(wearLevelInfo->storfsCurrLoc->byteLoc, wearLevelInfo->storfsCurrLoc->pageLoc, storfsInst);
+
+    if(file_header_store_helper(storfsInst, &prevInfo, wearLevelInfo->storfsPrevLoc, "Previous File") != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+
+    //Fragment headers share a page with the file's data and are rewritten along with it
+    if((prevInfo.fileInfo & STORFS_INFO_REG_FILE_TYPE_FILE) == STORFS_INFO_REG_FILE_TYPE_FILE_FRAGMENT)
+    {
+        return STORFS_ERROR;
+    }
+
+    //Determine if the child location or sibling location of the previous file must be updated
+    if(prevInfo.childLocation == origLocation || wearLevelInfo->storfsFlags & STORFS_FILE_PARENT_FLAG)
+    {
+        STORFS_LOGD(TAG, "Journalling previous file child location");
+        return journal_append(storfsInst, STORFS_JOURNAL_CHILD, prevLocation, currLocation);
+    }
+    else if(prevInfo.siblingLocation == origLocation || wearLevelInfo->storfsFlags & STORFS_FILE_SIBLING_FLAG)
+    {
+        STORFS_LOGD(TAG, "Journalling previous file sibling location");
+        return journal_append(storfsInst, STORFS_JOURNAL_SIBLING, prevLocation, currLocation);
+    }
+
+    return STORFS_ERROR;
+}
+
+static storfs_err_t journal_erase(storfs_t *storfsInst, storfs_page_t page)
+{
+    //Updates to headers within the page are invalid once it is erased, record that before erasing
+    if(journal_drop(storfsInst, page) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+
+    return STORFS_DEVICE_ERASE(storfsInst, page);
+}
+
+static storfs_err_t journal_drop(storfs_t *storfsInst, storfs_page_t page)
+{
+    for(int j = 0; j < storfsInst->cachedInfo.journalCount; j++)
+    {
+        if(LOCATION_TO_PAGE(storfsInst->cachedInfo.journalEntries[j].location, storfsInst) == page)
+        {
+            if(journal_append(storfsInst, STORFS_JOURNAL_DROP, BYTEPAGE_TO_LOCATION(0, page, storfsInst), 0) != STORFS_OK)
+            {
+                return STORFS_ERROR;
+            }
+            break;
+        }
+    }
+
+    return STORFS_OK;
+}
+
+static storfs_err_t journal_checkpoint(storfs_t *storfsInst)
+{
+    STORFS_WORK_BUF_TAKE(storfsInst, pageBuf, STORFS_INST_PAGE_SIZE(storfsInst));
+    storfs_file_header_t storfsInfo;
+    storfs_page_t page;
+    storfs_byte_t byte;
+    if(STORFS_WORK_BUF_FAILED(pageBuf))
+    {
+        return STORFS_ERROR;
+    }
+
+    STORFS_LOGD(TAG, "Checkpointing %d journal entries", storfsInst->cachedInfo.journalCount);
+
+    //Write the updates of each page into the tree, each page is only rewritten once
+    while(storfsInst->cachedInfo.journalCount > 0)
+    {
+        page = LOCATION_TO_PAGE(storfsInst->cachedInfo.journalEntries[0].location, storfsInst);
+        if(STORFS_READ(storfsInst, page, 0, pageBuf, STORFS_INST_PAGE_SIZE(storfsInst)) != STORFS_OK)
+        {
+            STORFS_WORK_BUF_RETURN(storfsInst, pageBuf, STORFS_READ_FAILED);
+        }
+        if(STORFS_SYNC(storfsInst) != STORFS_OK)
+        {
+            STORFS_WORK_BUF_RETURN(storfsInst, pageBuf, STORFS_ERROR);
+        }
+
+        for(int j = 0; j < storfsInst->cachedInfo.journalCount; j++)
+        {
+            if(LOCATION_TO_PAGE(storfsInst->cachedInfo.journalEntries[j].location, storfsInst) == page)
+            {
+                byte = LOCATION_TO_BYTE(storfsInst->cachedInfo.journalEntries[j].location, storfsInst);
+                buf_to_info(pageBuf + byte, &storfsInfo);
+                if(storfsInst->cachedInfo.journalEntries[j].type == STORFS_JOURNAL_CHILD)
+                {
+                    storfsInfo.childLocation = storfsInst->cachedInfo.journalEntries[j].value;
                 }
                 else
                 {
-                    if(file_delete_helper(storfsInst, rmChildFileLoc, rmChildHeader) != STORFS_OK)
-                    {
-                        return STORFS_ERROR;
-                    }
-                    rmChildFileLoc.pageLoc = LOCATION_TO_PAGE(rmChildHeader.siblingLocation, storfsInst);
-                    rmChildFileLoc.byteLoc = LOCATION_TO_BYTE(rmChildHeader.siblingLocation, storfsInst);
+                    storfsInfo.siblingLocation = storfsInst->cachedInfo.journalEntries[j].value;
                 }
+                info_to_buf(pageBuf + byte, &storfsInfo);
+            }
+        }
+
+        if(STORFS_DEVICE_ERASE(storfsInst, page) != STORFS_OK)
+        {
+            STORFS_WORK_BUF_RETURN(storfsInst, pageBuf, STORFS_ERROR);
+        }
+        if(STORFS_WRITE(storfsInst, page, 0, pageBuf, STORFS_INST_PAGE_SIZE(storfsInst)) != STORFS_OK)
+        {
+            STORFS_WORK_BUF_RETURN(storfsInst, pageBuf, STORFS_WRITE_FAILED);
+        }
+        if(STORFS_SYNC(storfsInst) != STORFS_OK)
+        {
+            STORFS_WORK_BUF_RETURN(storfsInst, pageBuf, STORFS_ERROR);
+        }
+
+        journal_replay(storfsInst, STORFS_JOURNAL_DROP, BYTEPAGE_TO_LOCATION(0, page, storfsInst), 0);
+    }
+
+    //Write the cached root information
+    if(root_write_helper(storfsInst) != STORFS_OK)
+    {
+        STORFS_WORK_BUF_RETURN(storfsInst, pageBuf, STORFS_ERROR);
+    }
+
+    //Everything has been written to the tree, clear the journal
+    STORFS_WORK_BUF_RETURN(storfsInst, pageBuf, journal_load(storfsInst, STORFS_OK));
+}
+
+static uint32_t journal_records_left(storfs_t *storfsInst)
+{
+    uint32_t recordsPerPage = STORFS_INST_PAGE_SIZE(storfsInst) / STORFS_JOURNAL_RECORD_SIZE;
+    uint32_t recordsUsed = ((storfsInst->cachedInfo.journalHead.pageLoc - storfsInst->cachedInfo.journalLocation) * recordsPerPage) + \
+                            (storfsInst->cachedInfo.journalHead.byteLoc / STORFS_JOURNAL_RECORD_SIZE);
+
+    return (recordsPerPage * STORFS_JOURNAL_PAGES) - recordsUsed;
+}
+#endif
+
+static storfs_err_t root_write_helper(storfs_t *storfsInst)
+{
+    //Update both root registers
+    if(STORFS_ERASE(storfsInst, storfsInst->cachedInfo.rootLocation[0].pageLoc) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+    file_header_create_helper(storfsInst, &storfsInst->cachedInfo.rootHeaderInfo[0], storfsInst->cachedInfo.rootLocation[0], "Root Header 1");
+    if(STORFS_ERASE(storfsInst, storfsInst->cachedInfo.rootLocation[1].pageLoc) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+    file_header_create_helper(storfsInst, &storfsInst->cachedInfo.rootHeaderInfo[1], storfsInst->cachedInfo.rootLocation[1], "Root Header 2");
+
+    return STORFS_OK;
+}
+
+static storfs_err_t update_root(storfs_t *storfsInst)
+{
+#ifdef STORFS_JOURNAL
+    //Append the root's child location and next open byte to the journal, the root headers are written when checkpointed
+    return journal_append(storfsInst, STORFS_JOURNAL_ROOT, storfsInst->cachedInfo.rootHeaderInfo[0].childLocation, \
+                            storfsInst->cachedInfo.rootHeaderInfo[0].fragmentLocation);
+#else
+    return root_write_helper(storfsInst);
+#endif
+}
+
+static storfs_err_t update_root_next_open_byte(storfs_t *storfsInst, storfs_size_t fileLocation)
+{
+    //Update the cached information with the next open byte
+    storfsInst->cachedInfo.nextOpenByte = fileLocation;
+
+    //Update the next open byte info in the cached rootInfo
+    storfsInst->cachedInfo.rootHeaderInfo[0].fragmentLocation = fileLocation;
+    storfsInst->cachedInfo.rootHeaderInfo[1].fragmentLocation = fileLocation;
+
+    if(update_root(storfsInst) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+
+    return STORFS_OK;
+}
+
+static storfs_err_t find_next_open_byte_helper (storfs_t *storfsInst, storfs_loc_t *storfsLoc)
+{
+    storfs_file_header_t nextHeaderInfo;
+    storfs_page_t startPage = storfsLoc->pageLoc;
+    uint8_t wrapped = 0;
+    nextHeaderInfo.fragmentLocation = 0;
+    nextHeaderInfo.fileInfo = 0x80;
+#ifdef STORFS_ERASE_POOL
+    storfs_page_t poolPage;
+    uint8_t poolFound = (erase_pool_find(storfsInst, storfsLoc->pageLoc, &poolPage) == STORFS_OK);
+#endif
+
+    //Determine where the next open byte within the system is
+    while(!STORFS_HEADER_ERASED(nextHeaderInfo))
+    {
+        storfsLoc->pageLoc += 1;
+        if(storfsLoc->byteLoc != 0)
+        {
+            storfsLoc->byteLoc = 0;
+        }
+
+        //Pages freed behind the search are found by continuing from the first page of files, up to where the search started
+        if(storfsLoc->pageLoc >= STORFS_LOGICAL_PAGE_COUNT(storfsInst) && !wrapped)
+        {
+            storfsLoc->pageLoc = storfsInst->cachedInfo.dataPageLoc;
+            wrapped = 1;
+        }
+
+        //Pages past the end of the storage device, or reserved as spares for the L2P map, are never allocated
+        if(storfsLoc->pageLoc >= STORFS_LOGICAL_PAGE_COUNT(storfsInst) || (wrapped && storfsLoc->pageLoc >= startPage))
+        {
+            STORFS_LOGW(TAG, "No free pages left within the file system");
+            storfsLoc->pageLoc = STORFS_LOGICAL_PAGE_COUNT(storfsInst);
+            return STORFS_ERROR;
+        }
+#ifdef STORFS_ERASE_POOL
+        //A page within the pool is known to be erased, take it without reading
+        if(poolFound && storfsLoc->pageLoc == poolPage)
+        {
+            return erase_pool_remove(storfsInst, poolPage);
+        }
+#endif
+#ifdef STORFS_BAD_BLOCK_TABLE
+        //Known bad pages are never allocated, skip them without reading
+        if(bad_block_check(storfsInst, storfsLoc->pageLoc) != STORFS_OK)
+        {
+            continue;
+        }
+#endif
+#ifdef STORFS_FALLOCATE
+        //Pages reserved for a file are only taken by its own writes
+        if(falloc_check(storfsInst, storfsLoc->pageLoc) != STORFS_OK)
+        {
+            continue;
+        }
+#endif
+        if(file_header_store_helper(storfsInst, &nextHeaderInfo, *storfsLoc, "Next") != STORFS_OK)
+        {
+            return STORFS_ERROR;
+        }
+#ifdef STORFS_LAZY_DELETE
+        //Pages of removed files are only erased once they are allocated again
+        if(STORFS_PAGE_INVALID(storfsInst, storfsLoc->pageLoc, &nextHeaderInfo.fileInfo, STORFS_INFO_REG_SIZE))
+        {
+#ifdef STORFS_ERASE_POOL
+            //While an erased page is available ahead, leave the removed page to be erased by storfs_idle
+            if(poolFound)
+            {
+                continue;
+            }
+#endif
+            //On devices erased in blocks, a removed page is passed over while its block still holds data
+            if(block_reclaim_check(storfsInst, storfsLoc->pageLoc) != STORFS_OK)
+            {
+                continue;
+            }
+            STORFS_LOGD(TAG, "Reclaiming removed page %ld%ld", (uint32_t)(storfsLoc->pageLoc >> 32), (uint32_t)(storfsLoc->pageLoc));
+            return STORFS_ERASE(storfsInst, storfsLoc->pageLoc);
+        }
+#endif
+    }
+
+    return STORFS_OK;
+}
+
+static storfs_err_t find_update_next_open_byte(storfs_t *storfsInst, storfs_loc_t storfsLoc)
+{
+    STORFS_LOGD(TAG, "Finding and updating next open byte");
+
+    //Once every page is in use the next open byte is left at the end of the file system, any further write is refused
+    if(find_next_open_byte_helper(storfsInst, &storfsLoc) != STORFS_OK && storfsLoc.pageLoc < STORFS_LOGICAL_PAGE_COUNT(storfsInst))
+    {
+        return STORFS_ERROR;
+    }
+    
+    //Update the next open byte available
+    update_root_next_open_byte(storfsInst, BYTEPAGE_TO_LOCATION(0, storfsLoc.pageLoc, storfsInst));
+
+    return STORFS_OK;
+}
+
+#ifdef STORFS_EXTENT_ALLOC
+static storfs_err_t extent_alloc_helper(storfs_t *storfsInst, storfs_loc_t *storfsLoc, storfs_size_t pageNum)
+{
+    storfs_file_header_t pageInfo;
+    storfs_loc_t pageLoc = {.pageLoc = storfsLoc->pageLoc, .byteLoc = 0};
+    storfs_size_t runLen = 0;                                                 //Number of free pages found one after another
+    storfs_size_t passedNum = 0;                                              //Number of pages passed over outside of the run
+
+    //Search the pages following the location for a run of free pages, giving up once too many have been passed over
+    while(runLen < pageNum)
+    {
+        pageLoc.pageLoc += 1;
+        if(pageLoc.pageLoc >= STORFS_LOGICAL_PAGE_COUNT(storfsInst) || passedNum >= STORFS_EXTENT_SCAN_PAGES)
+        {
+            STORFS_LOGD(TAG, "No run of %ld free pages found", (uint32_t)pageNum);
+            return STORFS_ERROR;
+        }
+#ifdef STORFS_BAD_BLOCK_TABLE
+        //Known bad pages end the run without being read
+        if(bad_block_check(storfsInst, pageLoc.pageLoc) != STORFS_OK)
+        {
+            passedNum += runLen + 1;
+            runLen = 0;
+            continue;
+        }
+#endif
+#ifdef STORFS_FALLOCATE
+        //As do pages reserved for another file
+        if(falloc_check(storfsInst, pageLoc.pageLoc) != STORFS_OK)
+        {
+            passedNum += runLen + 1;
+            runLen = 0;
+            continue;
+        }
+#endif
+        if(file_header_store_helper(storfsInst, &pageInfo, pageLoc, "Extent") != STORFS_OK)
+        {
+            return STORFS_ERROR;
+        }
+        if(STORFS_HEADER_ERASED(pageInfo))
+        {
+            runLen++;
+        }
+        else
+        {
+            passedNum += runLen + 1;
+            runLen = 0;
+        }
+    }
+
+    //The run ends at the last page read
+    storfsLoc->pageLoc = pageLoc.pageLoc - pageNum + 1;
+    storfsLoc->byteLoc = 0;
+    STORFS_LOGD(TAG, "Reserved %ld pages from page %ld%ld", (uint32_t)pageNum, (uint32_t)(storfsLoc->pageLoc >> 32), (uint32_t)(storfsLoc->pageLoc));
+
+#ifdef STORFS_ERASE_POOL
+    //Pages of the run held within the erased page pool must no longer be handed out by it
+    for(storfs_size_t i = 0; i < pageNum; i++)
+    {
+        erase_pool_remove(storfsInst, storfsLoc->pageLoc + i);
+    }
+#endif
+
+    return STORFS_OK;
+}
+#endif
+
+#ifdef STORFS_FALLOCATE
+static storfs_err_t falloc_check(storfs_t *storfsInst, storfs_page_t page)
+{
+    for(int j = 0; j < storfsInst->cachedInfo.fallocCount; j++)
+    {
+        if(page >= storfsInst->cachedInfo.fallocFiles[j].page && 
+            page < (storfsInst->cachedInfo.fallocFiles[j].page + storfsInst->cachedInfo.fallocFiles[j].pageNum))
+        {
+            return STORFS_ERROR;
+        }
+    }
+
+    return STORFS_OK;
+}
+
+static storfs_err_t falloc_take(storfs_t *storfsInst, storfs_page_t filePage, storfs_loc_t *storfsLoc, storfs_size_t *pageNum)
+{
+    storfs_falloc_t *fallocFile;
+
+    for(int j = 0; j < storfsInst->cachedInfo.fallocCount; j++)
+    {
+        fallocFile = &storfsInst->cachedInfo.fallocFiles[j];
+        if(fallocFile->filePage == filePage)
+        {
+            //Take up to the number of pages asked for from the start of the run
+            if(*pageNum > fallocFile->pageNum)
+            {
+                *pageNum = fallocFile->pageNum;
+            }
+            storfsLoc->pageLoc = fallocFile->page;
+            storfsLoc->byteLoc = 0;
+            fallocFile->page += *pageNum;
+            fallocFile->pageNum -= *pageNum;
+
+            //Once every page has been taken the file no longer holds a reservation
+            if(fallocFile->pageNum == 0)
+            {
+                falloc_release(storfsInst, filePage);
+            }
+            return STORFS_OK;
+        }
+    }
+
+    return STORFS_ERROR;
+}
+
+static void falloc_release(storfs_t *storfsInst, storfs_page_t filePage)
+{
+    for(int j = 0; j < storfsInst->cachedInfo.fallocCount; j++)
+    {
+        if(storfsInst->cachedInfo.fallocFiles[j].filePage == filePage)
+        {
+            storfsInst->cachedInfo.fallocFiles[j] = storfsInst->cachedInfo.fallocFiles[--storfsInst->cachedInfo.fallocCount];
+            return;
+        }
+    }
+}
+
+static void falloc_move(storfs_t *storfsInst, storfs_page_t filePage, storfs_page_t newFilePage)
+{
+    //The reservation follows the file's header when it is written onto a new page
+    for(int j = 0; j < storfsInst->cachedInfo.fallocCount; j++)
+    {
+        if(storfsInst->cachedInfo.fallocFiles[j].filePage == filePage)
+        {
+            storfsInst->cachedInfo.fallocFiles[j].filePage = newFilePage;
+            return;
+        }
+    }
+}
+#endif
+
+static storfs_err_t file_handling_helper(storfs_t *storfsInst, storfs_name_t *pathToDir, file_action_t actionFlag, void *buff)
+{
+    int strLen = 0;                                                         //String length of the path used
+    int currStr;                                                            //String length to hold the current file/directory in the path          
+    storfs_loc_t currentLocation = storfsInst->cachedInfo.rootLocation[0];  //Location of the current directory to obtain information
+    STORFS_FILE previousFile;                                               //Information and location of the previous file
+    uint8_t fileSepCnt = 0;                                                 //File separator count to ensure files do no have children
+    path_flag_t pathFlag = PATH_LEFT;
+    wear_level_t wearLevelInfo;
+    uint8_t updatedHeader[STORFS_HEADER_TOTAL_SIZE];
+    uint8_t headerBuf[STORFS_HEADER_TOTAL_SIZE];                            //Header of the current file, decoded only once its name is matched
+    storfs_size_t siblingLocation;
+    storfs_err_t headerStatus = STORFS_OK;                                  //Status of writing and linking a newly created header
+
+    while(1)
+    {
+        storfs_name_t currentFileName[STORFS_MAX_FILE_NAME];
+        currStr = 0;
+        while((pathToDir[strLen] != '/') && (pathToDir[strLen] != '\0'))
+        {
+            if(pathToDir[strLen] == '.')
+            {
+                if(actionFlag == DIR_CREATE)
+                {
+                    STORFS_LOGE(TAG, "Directory name cannot have an extension");
+                    return STORFS_ERROR; 
+                }
+                fileSepCnt++;
+            }
+            currentFileName[currStr++] = pathToDir[strLen++];
+        }
+        currentFileName[currStr] = '\0';
+        STORFS_LOGD(TAG, "File name %s", currentFileName);
+
+        if(pathToDir[strLen] == '\0')
+        {
+            pathFlag = PATH_LAST;
+        }
+
+        do
+        {
+            //Read the current file header, siblings that are passed over only have their name and sibling location read
+            if(file_header_view_helper(storfsInst, headerBuf, currentLocation, "Directory") != STORFS_OK)
+            {
+                return STORFS_ERROR;
+            }
+            siblingLocation = header_view_sibling(headerBuf);
+#ifdef STORFS_JOURNAL
+            //Apply a sibling update that has not yet been checkpointed
+            journal_link_apply(storfsInst, currentLocation, STORFS_JOURNAL_SIBLING, &siblingLocation);
+#endif
+
+            //Does the current file header name equal to the name in the path?
+            if(strncmp((const char *)header_view_name(headerBuf), (const char *)currentFileName, (STORFS_MAX_FILE_NAME - STORFS_INFO_REG_SIZE)) == 0)
+            {
+                //If the filename is matched it is a parent directory, update the previous file information with the current
+                STORFS_LOGD(TAG, "File name matched: %s", currentFileName);
+                buf_to_info(headerBuf, &wearLevelInfo.storfsInfo);
+#ifdef STORFS_JOURNAL
+                journal_apply(storfsInst, currentLocation, &wearLevelInfo.storfsInfo);
+#endif
+
+                if(pathFlag == PATH_LAST)
+                {
+                    break;
+                }
+
+                //If there is no child location update the child's location to the next open byte
+                if(wearLevelInfo.storfsInfo.childLocation == 0x0)
+                {
+                    wearLevelInfo.storfsInfo.childLocation = storfsInst->cachedInfo.nextOpenByte;
+                }
+
+                previousFile.fileLoc = currentLocation;
+                previousFile.filePrevLoc = currentLocation;
+                previousFile.fileInfo = wearLevelInfo.storfsInfo;
+                previousFile.filePrevFlags = STORFS_FILE_PARENT_FLAG;
+
+                //Continue to search the child's location if it is not the last line throughout the path
+                currentLocation.pageLoc = LOCATION_TO_PAGE(wearLevelInfo.storfsInfo.childLocation, storfsInst);
+                currentLocation.byteLoc = LOCATION_TO_BYTE(wearLevelInfo.storfsInfo.childLocation, storfsInst);
+            }
+            else if (siblingLocation != 0xFFFFFFFFFFFFFFFF)
+            {
+                //If there is no sibling location update the sibling's location to the next open byte
+                if(siblingLocation == 0x0)
+                {
+                    siblingLocation = storfsInst->cachedInfo.nextOpenByte;
+                }
+
+                //If the filename is not matched and the sibling location exists, it is a sibling directory
+                //Update the previous file information with the current
+                STORFS_LOGD(TAG, "Name not matched, searching siblings");
+                previousFile.fileLoc = currentLocation;
+                previousFile.filePrevLoc = currentLocation;
+                previousFile.filePrevFlags = STORFS_FILE_SIBLING_FLAG;
+
+                //Continue to search the siblings's location
+                currentLocation.pageLoc = LOCATION_TO_PAGE(siblingLocation, storfsInst);
+                currentLocation.byteLoc = LOCATION_TO_BYTE(siblingLocation, storfsInst);
+            }
+            else
+            {
+                STORFS_LOGD(TAG, "Name not matched, and no siblings, creating file/directory at next open location");
+                buf_to_info(headerBuf, &wearLevelInfo.storfsInfo);
+
+                //Error is next write is larger than the page count
+                if(LOCATION_TO_PAGE(storfsInst->cachedInfo.nextOpenByte, storfsInst) >= STORFS_LOGICAL_PAGE_COUNT(storfsInst))
+                {
+                    STORFS_LOGE(TAG, "Cannot write any more data to the file system");
+                    return STORFS_ERROR;
+                }
+
+                //Files cannot be children of other files
+                if(fileSepCnt > 1)
+                {
+                    STORFS_LOGE(TAG, "File/directory cannot be a child of another file");
+                    return STORFS_ERROR;
+                }
+
+                //Set information for the header of the current file directory
+                for(int i = 0; i <= currStr; i++)
+                {
+                    wearLevelInfo.storfsInfo.fileName[i] = currentFileName[i];
+                }
+                wearLevelInfo.storfsInfo.reserved = 0xFFFF;
+                wearLevelInfo.storfsInfo.fileSize = STORFS_HEADER_TOTAL_SIZE;
+
+                //Set the current directory fragment, sibling and child location registers to zero
+                //These locations will never be zero as long as the file system exists, it is a safe value to set these
+                wearLevelInfo.storfsInfo.siblingLocation = 0;
+                wearLevelInfo.storfsInfo.childLocation = 0;
+                wearLevelInfo.storfsInfo.fragmentLocation = 0;
+
+                //Compute CRC of the filename given
+                wearLevelInfo.storfsInfo.crc = STORFS_CRC_CALC(storfsInst, wearLevelInfo.storfsInfo.fileName, (currStr+1));
+
+                //If the file size will be the size of the page size, ensure the file info sets the information for the file to full
+                if(actionFlag == DIR_CREATE)
+                {
+                    wearLevelInfo.storfsInfo.fileInfo = STORFS_INFO_REG_FILE_TYPE_DIRECTORY | STORFS_INFO_REG_BLOCK_SIGN_FULL;
+                }
+                else
+                {
+                    wearLevelInfo.storfsInfo.fileInfo = STORFS_INFO_REG_FILE_TYPE_FILE | STORFS_INFO_REG_BLOCK_SIGN_PART_FULL;
+                }
+
+#ifdef STORFS_INLINE_FILES
+                //Files start out inline, the link to their first version is programmed once it is written
+                if(actionFlag != DIR_CREATE && storfsInst->partialProgram)
+                {
+                    wearLevelInfo.storfsInfo.fileInfo |= STORFS_INFO_REG_INLINE_BIT;
+                    wearLevelInfo.storfsInfo.fragmentLocation = STORFS_INLINE_LINK_ERASED;
+                }
+#endif
+#ifdef STORFS_METADATA_PACK
+                //Packed headers are placed after the last one created while its page has space left
+                if(STORFS_HEADER_PACKED(wearLevelInfo.storfsInfo.fileInfo))
+                {
+                    meta_slot_take(storfsInst, &currentLocation);
+                }
+#endif
+
+                info_to_buf(updatedHeader, &wearLevelInfo.storfsInfo);
+                wearLevelInfo.sendBuf = updatedHeader;
+                wearLevelInfo.headerLen = STORFS_HEADER_TOTAL_SIZE;
+                wearLevelInfo.sendDataLen = STORFS_HEADER_TOTAL_SIZE;
+                wearLevelInfo.storfsCurrLoc = &currentLocation;
+                wearLevelInfo.storfsInfoLoc = currentLocation;
+                wearLevelInfo.storfsOrigLoc = currentLocation;
+                wearLevelInfo.storfsPrevLoc = previousFile.fileLoc;
+                wearLevelInfo.storfsFlags = STORFS_FILE_INIT_HEADER_WRITE | previousFile.filePrevFlags;
+
+                //Write the new header to the needed location in flash
+                headerStatus = write_wear_level_helper(storfsInst, &wearLevelInfo);
+
+                //Display the newly created file information
+                file_info_display_helper(&wearLevelInfo.storfsInfo);
+
+#ifdef STORFS_METADATA_PACK
+                if(STORFS_HEADER_PACKED(wearLevelInfo.storfsInfo.fileInfo))
+                {
+                    storfsInst->cachedInfo.metaLoc.pageLoc = currentLocation.pageLoc;
+                    storfsInst->cachedInfo.metaLoc.byteLoc = currentLocation.byteLoc + STORFS_HEADER_TOTAL_SIZE;
+                }
+
+                //A header packed into a page already in use does not move the next open byte
+                if(currentLocation.byteLoc != 0)
+                {
+                    break;
+                }
+#endif
+
+                //Determine the next open byte for the cache and update root header if needed
+                if(find_update_next_open_byte(storfsInst, currentLocation) != STORFS_OK)
+                {
+                    return STORFS_ERROR;
+                }
+                break;
+            }
+        } while(previousFile.filePrevFlags == STORFS_FILE_SIBLING_FLAG);
+
+        //The header is written but could not be linked to the previous file
+        if(headerStatus != STORFS_OK)
+        {
+            STORFS_LOGE(TAG, "Cannot link the new header");
+            return STORFS_ERROR;
+        }
+
+        if(pathFlag == PATH_LAST)
+        {
+            break;
+        }
+
+        strLen += 1;
+    }
+
+    //If action is to open the file and store the memory location to the buffer passed in
+    if(actionFlag == FILE_OPEN)
+    {
+        //If the file was just created and file action is FILE_OPEN ensure that the current location is used as the previous location
+        previousFile.fileLoc = currentLocation;
+        previousFile.fileInfo = wearLevelInfo.storfsInfo;
+        *(STORFS_FILE *)buff = previousFile;
+    }
+
+    return STORFS_OK;
+}
+
+static storfs_err_t fopen_write_flag_helper(storfs_t *storfsInst, char *pathToFile, STORFS_FILE *currentOpenFile)
+{
+    STORFS_FILE newOpenFile = *currentOpenFile;
+    uint32_t strLen = 0;
+
+#ifdef STORFS_INLINE_FILES
+    //An inline file is truncated by writing an empty version
+    if(currentOpenFile->fileInfo.fileInfo & STORFS_INFO_REG_INLINE_BIT)
+    {
+        currentOpenFile->fileFlags = STORFS_FILE_WRITE_FLAG;
+        return inline_write_helper(storfsInst, "", 0, currentOpenFile);
+    }
+#endif
+
+    //On devices erased in blocks the old file's header cannot be erased to be written again, the empty file is created at the next open byte
+    if(STORFS_BLOCK_PAGES(storfsInst) > 1)
+    {
+        currentOpenFile->fileLoc.pageLoc = LOCATION_TO_PAGE(storfsInst->cachedInfo.nextOpenByte, storfsInst);
+        currentOpenFile->fileLoc.byteLoc = 0;
+    }
+    //Remove the file since it exists 
+    else if(file_delete_helper(storfsInst, currentOpenFile->fileLoc, &currentOpenFile->fileInfo, 0) != STORFS_OK)
+    {
+        STORFS_LOGE(TAG, "Cannot delete the old file");
+        return STORFS_ERROR;
+    }
+    
+    //Recreate file header
+    currentOpenFile->fileInfo.fileSize = STORFS_HEADER_TOTAL_SIZE;
+    currentOpenFile->fileInfo.fragmentLocation = 0x00;
+    while(currentOpenFile->fileInfo.fileName[strLen++] != '\0');
+    currentOpenFile->fileInfo.crc = STORFS_CRC_CALC(storfsInst, currentOpenFile->fileInfo.fileName, strLen);
+    while(1)
+    {
+        if(file_header_create_helper(storfsInst, &currentOpenFile->fileInfo, currentOpenFile->fileLoc, "Deleting old file and opening new") != STORFS_OK)
+        {
+            STORFS_LOGE(TAG, "Cannot create the old file");
+            return STORFS_ERROR;
+        }
+        if(crc_header_check(storfsInst, currentOpenFile->fileLoc) == STORFS_OK)
+        {
+                break;
+        }
+#ifdef STORFS_BAD_BLOCK_TABLE
+        bad_block_mark(storfsInst, currentOpenFile->fileLoc.pageLoc);
+#endif
+        if(find_next_open_byte_helper(storfsInst, &currentOpenFile->fileLoc) != STORFS_OK)
+        {
+            return STORFS_ERROR;
+        }
+    }
+
+    //The empty file then takes the place of the old file
+    if(STORFS_BLOCK_PAGES(storfsInst) > 1)
+    {
+        STORFS_FALLOC_MOVE(storfsInst, newOpenFile.fileLoc.pageLoc, currentOpenFile->fileLoc.pageLoc);
+        if(file_replace_helper(storfsInst, newOpenFile.fileLoc, currentOpenFile->fileLoc) != STORFS_OK)
+        {
+            return STORFS_ERROR;
+        }
+    }
+
+    //Find the next available open byte
+    if(find_update_next_open_byte(storfsInst, newOpenFile.fileLoc) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }   
+
+    return STORFS_OK;
+}
+
+#ifdef STORFS_WORK_BUF
+#if STORFS_WORK_BUF_SIZE > 0
+//Shared by every instance without a work buffer of its own
+static uint8_t workBufPool[STORFS_WORK_BUF_SIZE];
+#endif
+
+static uint8_t *work_buf_take(storfs_t *storfsInst, storfs_size_t size)
+{
+    uint8_t *buf;
+
+#if STORFS_WORK_BUF_SIZE > 0
+    if(storfsInst->workBuf == NULL)
+    {
+        storfsInst->workBuf = workBufPool;
+        storfsInst->workBufSize = STORFS_WORK_BUF_SIZE;
+    }
+#endif
+    if(storfsInst->workBuf == NULL || (storfsInst->cachedInfo.workBufUsed + size) > storfsInst->workBufSize)
+    {
+        STORFS_LOGE(TAG, "Work buffer too small, %ld bytes needed", (uint32_t)(storfsInst->cachedInfo.workBufUsed + size));
+        return NULL;
+    }
+
+    buf = storfsInst->workBuf + storfsInst->cachedInfo.workBufUsed;
+    storfsInst->cachedInfo.workBufUsed += size;
+    if(storfsInst->cachedInfo.workBufUsed > storfsInst->cachedInfo.workBufPeak)
+    {
+        storfsInst->cachedInfo.workBufPeak = storfsInst->cachedInfo.workBufUsed;
+    }
+
+    return buf;
+}
+
+static void work_buf_give(storfs_t *storfsInst, uint8_t *buf)
+{
+    //Buffers are given back in the reverse order they were taken, anything taken after this buffer is given back with it
+    storfsInst->cachedInfo.workBufUsed = buf - storfsInst->workBuf;
+}
+#endif
+
+#ifdef STORFS_LAZY_SYNC
+static storfs_err_t busy_wait(storfs_t *storfsInst)
+{
+    storfs_busy_t busy = storfsInst->cachedInfo.deviceBusy;
+
+    //Nothing to wait on after a read, the busy state is then only read so readers sharing the lock may all check it
+    if(busy == STORFS_BUSY_NONE)
+    {
+        return STORFS_OK;
+    }
+    storfsInst->cachedInfo.deviceBusy = STORFS_BUSY_NONE;
+
+    if(storfsInst->waitReady != NULL)
+    {
+        return storfsInst->waitReady(storfsInst, busy);
+    }
+    return storfsInst->sync(storfsInst);
+}
+#endif
+
+static storfs_err_t device_erase_helper(storfs_t *storfsInst, storfs_page_t page)
+{
+    storfs_page_t blockPages = STORFS_BLOCK_PAGES(storfsInst);
+    storfs_page_t firstPage = page - (page % blockPages);
+
+    //Erasing a page of a file erases its whole block, which is only done once every other page within it is free
+    //System pages each have a block of their own
+    if(blockPages > 1 && page >= storfsInst->cachedInfo.dataPageLoc && block_reclaim_check(storfsInst, page) != STORFS_OK)
+    {
+        STORFS_LOGE(TAG, "Cannot erase page %ld%ld, its block still holds data", (uint32_t)(page >> 32), (uint32_t)(page));
+        return STORFS_ERROR;
+    }
+
+    return STORFS_DEVICE_OP(storfsInst, STORFS_BUSY_ERASE, storfsInst->erase(storfsInst, firstPage));
+}
+
+#ifdef STORFS_SPARE_HEADERS
+static storfs_err_t spare_read_helper(storfs_t *storfsInst, storfs_page_t page, storfs_byte_t byte, uint8_t *buf, storfs_size_t size)
+{
+    storfs_size_t spareLen = 0;
+
+    //Bytes below the fragment header size are read from the spare area, the rest from the page shifted down by it
+    if(byte < STORFS_FRAGMENT_HEADER_TOTAL_SIZE)
+    {
+        spareLen = STORFS_FRAGMENT_HEADER_TOTAL_SIZE - byte;
+        if(spareLen > size)
+        {
+            spareLen = size;
+        }
+        if(STORFS_DEVICE_READ_OP(storfsInst, storfsInst->readSpare(storfsInst, page, byte, buf, spareLen)) != STORFS_OK)
+        {
+            return STORFS_READ_FAILED;
+        }
+        byte += spareLen;
+    }
+    if(size == spareLen)
+    {
+        return STORFS_OK;
+    }
+
+    return STORFS_DEVICE_READ_OP(storfsInst, storfsInst->read(storfsInst, page, (byte - STORFS_FRAGMENT_HEADER_TOTAL_SIZE), (buf + spareLen), (size - spareLen)));
+}
+
+static storfs_err_t spare_write_helper(storfs_t *storfsInst, storfs_page_t page, storfs_byte_t byte, uint8_t *buf, storfs_size_t size)
+{
+    storfs_size_t spareLen = 0;
+
+    //Bytes below the fragment header size are written to the spare area, the rest to the page shifted down by it
+    if(byte < STORFS_FRAGMENT_HEADER_TOTAL_SIZE)
+    {
+        spareLen = STORFS_FRAGMENT_HEADER_TOTAL_SIZE - byte;
+        if(spareLen > size)
+        {
+            spareLen = size;
+        }
+        if(STORFS_DEVICE_OP(storfsInst, STORFS_BUSY_PROGRAM, storfsInst->writeSpare(storfsInst, page, byte, buf, spareLen)) != STORFS_OK)
+        {
+            return STORFS_WRITE_FAILED;
+        }
+        byte += spareLen;
+    }
+    if(size == spareLen)
+    {
+        return STORFS_OK;
+    }
+
+    return STORFS_DEVICE_OP(storfsInst, STORFS_BUSY_PROGRAM, storfsInst->write(storfsInst, page, (byte - STORFS_FRAGMENT_HEADER_TOTAL_SIZE), (buf + spareLen), (size - spareLen)));
+}
+#endif
+
+static storfs_err_t block_page_check(storfs_t *storfsInst, storfs_page_t page, uint8_t *buf, storfs_size_t size)
+{
+    storfs_size_t i;
+
+#ifdef STORFS_LAZY_DELETE
+    //Removed pages of files do not need to be kept, system pages are never marked invalid
+    if(page >= storfsInst->cachedInfo.dataPageLoc && STORFS_PAGE_INVALID(storfsInst, page, buf, size))
+    {
+        return STORFS_OK;
+    }
+#endif
+
+    //The page holds no data if it is still erased
+    for(i = 0; i < size && buf[i] == 0xFF; i++);
+
+    return (i == size) ? STORFS_OK : STORFS_ERROR;
+}
+
+static storfs_err_t block_reclaim_check(storfs_t *storfsInst, storfs_page_t page)
+{
+    storfs_page_t blockPages = STORFS_BLOCK_PAGES(storfsInst);
+    storfs_page_t firstPage = page - (page % blockPages);
+    uint8_t headerBuf[STORFS_HEADER_TOTAL_SIZE];
+
+    //Only erase a page if no other page within its block holds data
+    for(storfs_page_t j = 0; j < blockPages && blockPages > 1; j++)
+    {
+        if((firstPage + j) == page)
+        {
+            continue;
+        }
+        if(STORFS_READ(storfsInst, firstPage + j, 0, headerBuf, STORFS_HEADER_TOTAL_SIZE) != STORFS_OK || 
+            block_page_check(storfsInst, firstPage + j, headerBuf, STORFS_HEADER_TOTAL_SIZE) != STORFS_OK)
+        {
+            return STORFS_ERROR;
+        }
+    }
+
+    return STORFS_OK;
+}
+
+static storfs_err_t page_free_helper(storfs_t *storfsInst, storfs_page_t page)
+{
+#ifdef STORFS_LAZY_DELETE
+    //Clear the valid bit of the page's header, the page is erased once it is allocated again or by storfs_idle
+    uint8_t infoReg = (uint8_t)~STORFS_INFO_REG_VALID_BIT;
+    if(STORFS_WRITE(storfsInst, page, 0, &infoReg, STORFS_INFO_REG_SIZE) != STORFS_OK || STORFS_SYNC(storfsInst) != STORFS_OK)
+    {
+        return STORFS_WRITE_FAILED;
+    }
+#ifdef STORFS_JOURNAL
+    //The page may be erased along with its block without passing through the journal
+    if(journal_drop(storfsInst, page) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+#endif
+#endif
+
+#if defined(STORFS_LAZY_DELETE) && defined(STORFS_IDLE)
+    return idle_erase_defer(storfsInst, page);
+#elif defined(STORFS_LAZY_DELETE)
+    return STORFS_OK;
+#elif defined(STORFS_ASYNC)
+    return async_erase_defer(storfsInst, page);
+#else
+    return STORFS_ERASE(storfsInst, page);
+#endif
+}
+
+static storfs_err_t file_delete_helper(storfs_t *storfsInst, storfs_loc_t storfsLoc, const storfs_file_header_t *storfsInfo, uint8_t deferErase)
+{
+    int32_t delDataItr = 0;
+    storfs_loc_t delDataHeaderLoc = storfsLoc;                        //Location of the file to be removed
+    storfs_size_t fragmentLocation = storfsInfo->fragmentLocation;    //Location of the next fragment of the file to be removed
+    uint8_t headerBuf[STORFS_HEADER_TOTAL_SIZE];
+
+#ifdef STORFS_FALLOCATE
+    //Removed files give back the pages reserved for them
+    if(deferErase)
+    {
+        falloc_release(storfsInst, storfsLoc.pageLoc);
+    }
+#endif
+#ifdef STORFS_INLINE_FILES
+    //The versions of an inline file are removed along with its header
+    if(storfsInfo->fileInfo & STORFS_INFO_REG_INLINE_BIT)
+    {
+        return inline_delete_helper(storfsInst, storfsLoc, storfsInfo);
+    }
+#endif
+#ifdef STORFS_METADATA_PACK
+    //Directory headers share their page, only the header is removed while other headers remain
+    if((storfsInfo->fileInfo & STORFS_INFO_REG_FILE_TYPE_FILE) == STORFS_INFO_REG_FILE_TYPE_DIRECTORY)
+    {
+        return meta_slot_remove(storfsInst, storfsLoc, storfsInfo);
+    }
+#endif
+
+    //Determine the number of iterations for deletion of files 
+    delDataItr = (storfsInfo->fileSize + STORFS_INST_PAGE_SIZE(storfsInst)) / STORFS_INST_PAGE_SIZE(storfsInst);
+    delDataHeaderLoc.byteLoc = 0;
+
+    do
+    {
+        STORFS_LOGD(TAG, "Deleting File/Fragment At %ld%ld, %ld", (uint32_t)(delDataHeaderLoc.pageLoc >> 32),(uint32_t)(delDataHeaderLoc.pageLoc),  delDataHeaderLoc.byteLoc);
+
+        //A removed header that is re-written straight away must be erased, every other page is freed
+        if(!deferErase && delDataHeaderLoc.pageLoc == storfsLoc.pageLoc)
+        {
+            if(STORFS_ERASE(storfsInst, delDataHeaderLoc.pageLoc) != STORFS_OK)
+            {
+                STORFS_LOGE(TAG, "Erasing page failed in function remove");
+                return STORFS_ERROR;
+            }
+        }
+        else if(page_free_helper(storfsInst, delDataHeaderLoc.pageLoc) != STORFS_OK)
+        {
+            STORFS_LOGE(TAG, "Freeing page failed in function remove");
+            return STORFS_ERROR;
+        }
+
+        delDataItr--;
+        if(delDataItr > 0)
+        {
+            //Set the next location to what is in the erased page's header
+            delDataHeaderLoc.pageLoc = LOCATION_TO_PAGE(fragmentLocation, storfsInst);
+
+            //Only the fragment location of the next header is needed
+            if(file_header_view_helper(storfsInst, headerBuf, delDataHeaderLoc, "") != STORFS_OK)
+            {
+                STORFS_LOGE(TAG, "Could not read from the current header");
+                return STORFS_ERROR;
+            }
+            fragmentLocation = header_view_fragment(headerBuf);
+        }
+    } while (delDataItr > 0);
+
+    return STORFS_OK;
+}
+
+static storfs_err_t file_replace_helper(storfs_t *storfsInst, storfs_loc_t oldLoc, storfs_loc_t newLoc)
+{
+    wear_level_t wearLevelInfo;
+
+    //The file linking to the old header is found from the root, as it may have been moved since the file was opened
+    if(file_header_store_helper(storfsInst, &wearLevelInfo.storfsInfo, oldLoc, "Replaced") != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+    //The search stops early when the location it returns equals the one searched for, start it past the last page instead
+    wearLevelInfo.storfsPrevLoc.pageLoc = storfsInst->pageCount;
+    wearLevelInfo.storfsPrevLoc.byteLoc = 0;
+    if(find_prev_file_loc(storfsInst, oldLoc, storfsInst->cachedInfo.rootLocation[0], &wearLevelInfo.storfsPrevLoc) != STORFS_OK ||
+        wearLevelInfo.storfsPrevLoc.pageLoc == storfsInst->pageCount)
+    {
+        STORFS_LOGE(TAG, "Cannot find the file linking to the old file");
+        return STORFS_ERROR;
+    }
+
+    //Link the previous file to the new header
+    wearLevelInfo.storfsOrigLoc = oldLoc;
+    wearLevelInfo.storfsCurrLoc = &newLoc;
+    wearLevelInfo.storfsInfoLoc = oldLoc;
+    wearLevelInfo.storfsFlags = 0;
+    if(link_update_helper(storfsInst, &wearLevelInfo) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+
+    //The old file is only removed once nothing links to it
+    return file_delete_helper(storfsInst, oldLoc, &wearLevelInfo.storfsInfo, 1);
+}
+
+static storfs_err_t directory_delete_helper(storfs_t *storfsInst, storfs_loc_t rmParentLoc, const storfs_file_header_t *rmParentHeader)
+{
+    STORFS_LOGI(TAG, "Deleting directory and all of it's containing files");
+
+    //Remove the directory
+    if(file_delete_helper(storfsInst, rmParentLoc, rmParentHeader, 1) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+
+    //If the parent header has a child location, ensure the children get deleted
+    if(rmParentHeader->childLocation != 0x00)
+        {
+            storfs_file_header_t rmChildHeader;
+            storfs_loc_t rmChildFileLoc;
+            rmChildFileLoc.pageLoc = LOCATION_TO_PAGE(rmParentHeader->childLocation, storfsInst);
+            rmChildFileLoc.byteLoc = LOCATION_TO_BYTE(rmParentHeader->childLocation, storfsInst);
+
+            file_header_store_helper(storfsInst, &rmChildHeader, rmChildFileLoc, "Remove");
+            while(1)
+            {
+                //If a directory needs to be deleted, iterate through this
+                if(rmChildHeader.childLocation != 0x00)
+                {
+                    if(directory_delete_helper(storfsInst, rmChildFileLoc, &rmChildHeader) != STORFS_OK)
+                    {
+                        return STORFS_ERROR;
+                    }
+                    rmChildFileLoc.pageLoc = LOCATION_TO_PAGE(rmChildHeader.childLocation, storfsInst);
+                    rmChildFileLoc.byteLoc = LOCATION_TO_BYTE(rmChildHeader.childLocation, storfsInst);
+                }
+                else
+                {
+                    if(file_delete_helper(storfsInst, rmChildFileLoc, &rmChildHeader, 1) != STORFS_OK)
+                    {
+                        return STORFS_ERROR;
+                    }
+                    rmChildFileLoc.pageLoc = LOCATION_TO_PAGE(rmChildHeader.siblingLocation, storfsInst);
+                    rmChildFileLoc.byteLoc = LOCATION_TO_BYTE(rmChildHeader.siblingLocation, storfsInst);
+                }
+
+                //If no siblings, this will be the last file within the directory
+                if(rmChildHeader.siblingLocation == 0x00)
+                {
+                    break;
+                }
+                file_header_store_helper(storfsInst, &rmChildHeader, rmChildFileLoc, "Remove");
+            }
+        }
+       
+    return STORFS_OK;
+}
+
+static storfs_err_t find_prev_file_loc(storfs_t* storfsInst,  storfs_loc_t storfsCurrLoc, storfs_loc_t storfsItrLoc, storfs_loc_t* storfsPrevLoc)
+{
+    storfs_file_header_t prevFileHeader;
+    storfs_loc_t storfsNextChildLoc;
+    storfs_loc_t storfsNextSibLoc;
+    
+    //Store the iterator header and determine if the child or sibling location is equal to the the current location
+    if(file_header_store_helper(storfsInst, &prevFileHeader, storfsItrLoc, "Previous File") != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+    if( prevFileHeader.childLocation == BYTEPAGE_TO_LOCATION(storfsCurrLoc.byteLoc, storfsCurrLoc.pageLoc, storfsInst) ||
+        prevFileHeader.siblingLocation == BYTEPAGE_TO_LOCATION(storfsCurrLoc.byteLoc, storfsCurrLoc.pageLoc, storfsInst))
+    {
+        *storfsPrevLoc = storfsItrLoc;
+        return STORFS_OK;
+    }
+
+    //Determine whether the previous file has a child
+    if(prevFileHeader.childLocation != 0x00)
+    {
+        storfsNextChildLoc.byteLoc = LOCATION_TO_BYTE(prevFileHeader.childLocation, storfsInst);
+        storfsNextChildLoc.pageLoc = LOCATION_TO_PAGE(prevFileHeader.childLocation, storfsInst);
+
+        //If the previous file has a child re-iterate through find_prev_file_loc
+        if(find_prev_file_loc(storfsInst, storfsCurrLoc, storfsNextChildLoc, storfsPrevLoc) != STORFS_OK)
+        {
+            return STORFS_ERROR;
+        }
+
+        //If the previously found location is the same as the 
+        if(BYTEPAGE_TO_LOCATION(storfsPrevLoc->byteLoc, storfsPrevLoc->pageLoc, storfsInst) == BYTEPAGE_TO_LOCATION(storfsCurrLoc.byteLoc, storfsCurrLoc.pageLoc, storfsInst))
+        {
+            return STORFS_OK;
+        }
+    }
+
+    //Determine whether the previous file has a sibling
+    if(prevFileHeader.siblingLocation != 0x00)
+    {
+        //If the current header has a sibling location, continuously iterate through the siblings until the wanted location is found or not
+        while(prevFileHeader.siblingLocation != 0x00)
+        {
+            storfsNextSibLoc.byteLoc = LOCATION_TO_BYTE(prevFileHeader.siblingLocation, storfsInst);
+            storfsNextSibLoc.pageLoc = LOCATION_TO_PAGE(prevFileHeader.siblingLocation, storfsInst);
+            if(file_header_store_helper(storfsInst, &prevFileHeader, storfsNextSibLoc, "Previous File") != STORFS_OK)
+            {
+                return STORFS_ERROR;
+            }
+
+            //If either the child location of the sibling location is equivalent to the wanted location, place that
+            if( prevFileHeader.childLocation == BYTEPAGE_TO_LOCATION(storfsCurrLoc.byteLoc, storfsCurrLoc.pageLoc, storfsInst) ||
+                prevFileHeader.siblingLocation == BYTEPAGE_TO_LOCATION(storfsCurrLoc.byteLoc, storfsCurrLoc.pageLoc, storfsInst))
+            {
+                *storfsPrevLoc = storfsNextSibLoc;
+                return STORFS_OK;
+            }
+
+            //If there is a child location, iterate through it with the prev_file_loc function
+            if(prevFileHeader.childLocation != 0x00)
+            {
+                storfsNextChildLoc.byteLoc = LOCATION_TO_BYTE(prevFileHeader.childLocation, storfsInst);
+                storfsNextChildLoc.pageLoc = LOCATION_TO_PAGE(prevFileHeader.childLocation, storfsInst);
+                if(find_prev_file_loc(storfsInst, storfsCurrLoc, storfsNextChildLoc, storfsPrevLoc) != STORFS_OK)
+                {
+                    return STORFS_ERROR;
+                }
+                if(BYTEPAGE_TO_LOCATION(storfsPrevLoc->byteLoc, storfsPrevLoc->pageLoc, storfsInst) == BYTEPAGE_TO_LOCATION(storfsCurrLoc.byteLoc, storfsCurrLoc.pageLoc, storfsInst))
+                {
+                    return STORFS_OK;
+                }
+            }
+        }
+    }
+
+    return STORFS_OK;
+}
+
+storfs_err_t wear_level_act(storfs_t* storfsInst, wear_level_t *wearLevelInfo)
+{
+    wear_level_t prevWearLevelInfo;
+
+    //Store the previous header, determine if it was a fragment header or a file/directory/root header
+    file_header_store_helper(storfsInst, &prevWearLevelInfo.storfsInfo, wearLevelInfo->storfsPrevLoc, "Previous File");
+
+    //If the previous file information is a file, the root or a directory... else if it is a fragment
+    if((prevWearLevelInfo.storfsInfo.fileInfo & STORFS_INFO_REG_FILE_TYPE_FILE) == STORFS_INFO_REG_FILE_TYPE_FILE || 
+        (prevWearLevelInfo.storfsInfo.fileInfo & STORFS_INFO_REG_FILE_TYPE_FILE) == STORFS_INFO_REG_FILE_TYPE_ROOT || 
+        (prevWearLevelInfo.storfsInfo.fileInfo & STORFS_INFO_REG_FILE_TYPE_FILE) == STORFS_INFO_REG_FILE_TYPE_DIRECTORY)
+    {
+        //Determine the parent/sibling location of the previous file in order to prepare it for another iteration of wear-level writing
+        if(find_prev_file_loc(storfsInst, wearLevelInfo->storfsPrevLoc, storfsInst->cachedInfo.rootLocation[0], &prevWearLevelInfo.storfsPrevLoc) != STORFS_OK)
+        {
+            STORFS_LOGE(TAG, "Error determining the previous file's parent/sibling location");
+            return STORFS_ERROR;
+        }
+
+        //The header info location will be the same as the previous location
+        prevWearLevelInfo.storfsInfoLoc = prevWearLevelInfo.storfsPrevLoc;
+        
+        //Set the previous header length
+        prevWearLevelInfo.headerLen = STORFS_HEADER_TOTAL_SIZE;
+
+        //Set the page size that must be re-written
+        if(prevWearLevelInfo.storfsInfo.fileSize > STORFS_INST_PAGE_SIZE(storfsInst))
+        {
+            prevWearLevelInfo.sendDataLen  = STORFS_INST_PAGE_SIZE(storfsInst);
+        }
+        else
+        {
+            prevWearLevelInfo.sendDataLen  = prevWearLevelInfo.storfsInfo.fileSize;
+        }
+
+        //Determine if the child location or sibling location must be re-written
+        if(prevWearLevelInfo.storfsInfo.childLocation == BYTEPAGE_TO_LOCATION(wearLevelInfo->storfsOrigLoc.byteLoc, wearLevelInfo->storfsOrigLoc.pageLoc, storfsInst) ||
+            wearLevelInfo->storfsFlags & STORFS_FILE_PARENT_FLAG)
+        {
+            STORFS_LOGI(TAG, "Updating previous file child location");
+            prevWearLevelInfo.storfsInfo.childLocation = BYTEPAGE_TO_LOCATION(wearLevelInfo->storfsCurrLoc->byteLoc, wearLevelInfo->storfsCurrLoc->pageLoc, storfsInst);
+        }
+        else if(prevWearLevelInfo.storfsInfo.siblingLocation == BYTEPAGE_TO_LOCATION(wearLevelInfo->storfsOrigLoc.byteLoc, wearLevelInfo->storfsOrigLoc.pageLoc, storfsInst) ||
+                wearLevelInfo->storfsFlags & STORFS_FILE_SIBLING_FLAG)
+        {
+            STORFS_LOGI(TAG, "Updating previous file sibling location");
+            prevWearLevelInfo.storfsInfo.siblingLocation = BYTEPAGE_TO_LOCATION(wearLevelInfo->storfsCurrLoc->byteLoc, wearLevelInfo->storfsCurrLoc->pageLoc, storfsInst);
+        }
+    }
+    else
+    {
+        storfs_file_header_t tempHeader = wearLevelInfo->storfsInfo;
+
+        //If the current head file header's fragment location is equal to the previous files fragment location
+        if(tempHeader.fragmentLocation == BYTEPAGE_TO_LOCATION(wearLevelInfo->storfsPrevLoc.byteLoc, wearLevelInfo->storfsPrevLoc.pageLoc, storfsInst))
+        {
+            //The previous location will be equivalent to the main header's location
+            prevWearLevelInfo.storfsPrevLoc = wearLevelInfo->storfsInfoLoc;
+        }
+        else
+        {
+            //Iterate through fragment header locations until the previous fragment header is found
+            while(tempHeader.fragmentLocation != BYTEPAGE_TO_LOCATION(wearLevelInfo->storfsPrevLoc.byteLoc, wearLevelInfo->storfsPrevLoc.pageLoc, storfsInst))
+            {
+                prevWearLevelInfo.storfsPrevLoc.pageLoc = LOCATION_TO_PAGE(tempHeader.fragmentLocation, storfsInst);
+                prevWearLevelInfo.storfsPrevLoc.byteLoc = LOCATION_TO_BYTE(tempHeader.fragmentLocation, storfsInst);
+
+                //Update the prevWearLevel header information while iterating
+                file_header_store_helper(storfsInst, &tempHeader, prevWearLevelInfo.storfsPrevLoc, "Previous Fragment");
+            }
+        }
+
+        STORFS_LOGI(TAG, "Updating previous file fragment location");
+
+        //Set the previous header length to be a fragment header length
+        prevWearLevelInfo.headerLen = STORFS_FRAGMENT_HEADER_TOTAL_SIZE;
+
+        //Set the previous header's info location to the original
+        prevWearLevelInfo.storfsInfoLoc = wearLevelInfo->storfsInfoLoc;
+
+        //Set the page size that must be re-written, must be a full page if there is a fragment
+        prevWearLevelInfo.sendDataLen  = STORFS_INST_PAGE_SIZE(storfsInst);
+
+        //Update the fragment location
+        prevWearLevelInfo.storfsInfo.fragmentLocation = BYTEPAGE_TO_LOCATION(wearLevelInfo->storfsCurrLoc->byteLoc, wearLevelInfo->storfsCurrLoc->pageLoc, storfsInst);
+    }
+
+    //Determine if the previous file is a directory or the root and ensure that the correct flag is applied to the next iteration
+    if((prevWearLevelInfo.storfsInfo.fileInfo & STORFS_INFO_REG_FILE_TYPE_FILE) == STORFS_INFO_REG_FILE_TYPE_DIRECTORY || 
+    (prevWearLevelInfo.storfsInfo.fileInfo & STORFS_INFO_REG_FILE_TYPE_FILE) == STORFS_INFO_REG_FILE_TYPE_ROOT || 
+    (((prevWearLevelInfo.storfsInfo.fileInfo & STORFS_INFO_REG_FILE_TYPE_FILE) == STORFS_INFO_REG_FILE_TYPE_FILE) && (prevWearLevelInfo.sendDataLen == STORFS_HEADER_TOTAL_SIZE)))
+    {
+        prevWearLevelInfo.storfsFlags = STORFS_FILE_HEADER_WRITE;
+    }
+    else
+    {
+        prevWearLevelInfo.storfsFlags = STORFS_FILE_WRITE_FLAG;
+    }
+
+    STORFS_LOGI(TAG, "Previous file's, previous file location %ld%ld", (uint32_t)(BYTEPAGE_TO_LOCATION(prevWearLevelInfo.storfsPrevLoc.byteLoc, prevWearLevelInfo.storfsPrevLoc.pageLoc, storfsInst) >> 32), (uint32_t)(BYTEPAGE_TO_LOCATION(prevWearLevelInfo.storfsPrevLoc.byteLoc, prevWearLevelInfo.storfsPrevLoc.pageLoc, storfsInst)));
+
+    //On devices erased in blocks the previous file's page cannot be erased on its own, it is moved onto a free page instead
+    if(STORFS_BLOCK_PAGES(storfsInst) > 1)
+    {
+        return page_relocate_helper(storfsInst, &prevWearLevelInfo, wearLevelInfo->storfsPrevLoc);
+    }
+
+    STORFS_WORK_BUF_TAKE(storfsInst, relocateBuf, STORFS_INST_PAGE_SIZE(storfsInst));
+    if(STORFS_WORK_BUF_FAILED(relocateBuf))
+    {
+        return STORFS_ERROR;
+    }
+    
+#ifdef STORFS_METADATA_PACK
+    //The page of a packed header may hold other headers, rewrite it with only this header changed
+    if(STORFS_HEADER_PACKED(prevWearLevelInfo.storfsInfo.fileInfo))
+    {
+        if(meta_header_rewrite(storfsInst, &prevWearLevelInfo.storfsInfo, wearLevelInfo->storfsPrevLoc) == STORFS_OK)
+        {
+            STORFS_WORK_BUF_RETURN(storfsInst, relocateBuf, STORFS_OK);
+        }
+
+        //If the page could not be rewritten, move the header onto the next open byte and link to it
+        storfs_loc_t relocateLoc;
+        relocateLoc.pageLoc = LOCATION_TO_PAGE(storfsInst->cachedInfo.nextOpenByte, storfsInst) - 1;
+        relocateLoc.byteLoc = 0;
+        if(meta_slot_remove(storfsInst, wearLevelInfo->storfsPrevLoc, &prevWearLevelInfo.storfsInfo) != STORFS_OK ||
+            find_next_open_byte_helper(storfsInst, &relocateLoc) != STORFS_OK)
+        {
+            STORFS_WORK_BUF_RETURN(storfsInst, relocateBuf, STORFS_ERROR);
+        }
+        info_to_buf(relocateBuf, &prevWearLevelInfo.storfsInfo);
+        prevWearLevelInfo.sendBuf = relocateBuf;
+        prevWearLevelInfo.storfsCurrLoc = &relocateLoc;
+        prevWearLevelInfo.storfsOrigLoc = wearLevelInfo->storfsPrevLoc;
+        prevWearLevelInfo.storfsFlags = STORFS_FILE_INIT_HEADER_WRITE;
+        write_wear_level_helper(storfsInst, &prevWearLevelInfo);
+
+        STORFS_WORK_BUF_RETURN(storfsInst, relocateBuf, find_update_next_open_byte(storfsInst, relocateLoc));
+    }
+#endif
+
+    //Convert the header to a buffer, read the previous file, erase it and write the new information to it
+    file_info_display_helper(&prevWearLevelInfo.storfsInfo);
+    info_to_buf(relocateBuf, &prevWearLevelInfo.storfsInfo);
+    if(STORFS_READ(storfsInst,wearLevelInfo->storfsPrevLoc.pageLoc, prevWearLevelInfo.headerLen, (relocateBuf + prevWearLevelInfo.headerLen), (STORFS_INST_PAGE_SIZE(storfsInst) - prevWearLevelInfo.headerLen)) != STORFS_OK)
+    {
+        STORFS_WORK_BUF_RETURN(storfsInst, relocateBuf, STORFS_READ_FAILED);
+    }
+    if(STORFS_ERASE(storfsInst, wearLevelInfo->storfsPrevLoc.pageLoc) != STORFS_OK)
+    {
+        STORFS_WORK_BUF_RETURN(storfsInst, relocateBuf, STORFS_ERROR);
+    }
+    
+    //Write to the previous wear struct the previous files information
+    prevWearLevelInfo.sendBuf = relocateBuf;
+    prevWearLevelInfo.storfsCurrLoc = &wearLevelInfo->storfsPrevLoc;
+    prevWearLevelInfo.storfsOrigLoc = wearLevelInfo->storfsPrevLoc;
+
+    //Write the previous file and header
+    write_wear_level_helper(storfsInst, &prevWearLevelInfo);
+
+    STORFS_WORK_BUF_RETURN(storfsInst, relocateBuf, STORFS_OK);
+}
+
+static storfs_err_t page_relocate_helper(storfs_t* storfsInst, wear_level_t *wearLevelInfo, storfs_loc_t storfsLoc)
+{
+    storfs_loc_t relocateLoc;
+    storfs_err_t status;
+
+    //The next open byte is left for new headers, the page is moved onto the free page following it
+    relocateLoc.pageLoc = LOCATION_TO_PAGE(storfsInst->cachedInfo.nextOpenByte, storfsInst);
+    relocateLoc.byteLoc = 0;
+    if(find_next_open_byte_helper(storfsInst, &relocateLoc) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+    STORFS_LOGD(TAG, "Moving page %ld%ld to %ld%ld", (uint32_t)(storfsLoc.pageLoc >> 32), (uint32_t)(storfsLoc.pageLoc), (uint32_t)(relocateLoc.pageLoc >> 32), (uint32_t)(relocateLoc.pageLoc));
+
+    wearLevelInfo->storfsCurrLoc = &relocateLoc;
+    wearLevelInfo->storfsOrigLoc = storfsLoc;
+    wearLevelInfo->storfsFlags |= STORFS_FILE_UNLINKED_FLAG;
+
+    //Copy the page with only its header changed, the buffer is given back before the files linking to it are updated
+    {
+        STORFS_WORK_BUF_TAKE(storfsInst, relocateBuf, STORFS_INST_PAGE_SIZE(storfsInst));
+        if(STORFS_WORK_BUF_FAILED(relocateBuf))
+        {
+            return STORFS_ERROR;
+        }
+        info_to_buf(relocateBuf, &wearLevelInfo->storfsInfo);
+        if(STORFS_READ(storfsInst, storfsLoc.pageLoc, wearLevelInfo->headerLen, (relocateBuf + wearLevelInfo->headerLen), (STORFS_INST_PAGE_SIZE(storfsInst) - wearLevelInfo->headerLen)) != STORFS_OK)
+        {
+            STORFS_WORK_BUF_RETURN(storfsInst, relocateBuf, STORFS_READ_FAILED);
+        }
+        wearLevelInfo->sendBuf = relocateBuf;
+        status = write_wear_level_helper(storfsInst, wearLevelInfo);
+        STORFS_WORK_BUF_GIVE(storfsInst, relocateBuf);
+    }
+    if(status != STORFS_OK)
+    {
+        return status;
+    }
+
+    //Link to the page in place of the old one, which is only freed once nothing links to it
+    if(link_update_helper(storfsInst, wearLevelInfo) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+
+    return page_free_helper(storfsInst, storfsLoc.pageLoc);
+}
+
+#ifdef STORFS_LINK_IN_PLACE
+static storfs_err_t link_program_helper(storfs_t *storfsInst, wear_level_t *wearLevelInfo)
+{
+    uint8_t headerBuf[STORFS_HEADER_TOTAL_SIZE];
+    uint8_t linkBuf[STORFS_CHILD_DIR_REG_SIZE];
+    storfs_file_header_t prevInfo;
+    storfs_loc_t prevLoc = wearLevelInfo->storfsPrevLoc;
+    storfs_size_t origLocation = BYTEPAGE_TO_LOCATION(wearLevelInfo->storfsOrigLoc.byteLoc, wearLevelInfo->storfsOrigLoc.pageLoc, storfsInst);
+    storfs_size_t currLocation = BYTEPAGE_TO_LOCATION(wearLevelInfo->storfsCurrLoc->byteLoc, wearLevelInfo->storfsCurrLoc->pageLoc, storfsInst);
+    uint32_t linkOffset = STORFS_HEADER_CHILD_OFFSET;
+    uint32_t i = 0;
+
+    //The device must be able to program the link of a page already holding data
+    if(!storfsInst->partialProgram)
+    {
+        return STORFS_ERROR;
+    }
+
+#ifdef STORFS_JOURNAL
+    //Links programmed within a transaction would be visible before it is committed
+    if(storfsInst->cachedInfo.journalTransaction)
+    {
+        return STORFS_ERROR;
+    }
+
+    //A journalled update of the previous file takes precedence over its programmed links
+    for(int j = 0; j < storfsInst->cachedInfo.journalCount; j++)
+    {
+        if(storfsInst->cachedInfo.journalEntries[j].location == BYTEPAGE_TO_LOCATION(prevLoc.byteLoc, prevLoc.pageLoc, storfsInst))
+        {
+            return STORFS_ERROR;
+        }
+    }
+#endif
+
+    if(STORFS_READ(storfsInst, prevLoc.pageLoc, prevLoc.byteLoc, headerBuf, STORFS_HEADER_TOTAL_SIZE) != STORFS_OK)
+    {
+        return STORFS_READ_FAILED;
+    }
+    buf_to_info(headerBuf, &prevInfo);
+
+    //Fragment headers do not hold child or sibling links
+    if((prevInfo.fileInfo & STORFS_INFO_REG_FILE_TYPE_FILE) == STORFS_INFO_REG_FILE_TYPE_FILE_FRAGMENT)
+    {
+        return STORFS_ERROR;
+    }
+
+    //Determine if the child location or sibling location of the previous file must be programmed
+    if(prevInfo.childLocation == origLocation || wearLevelInfo->storfsFlags & STORFS_FILE_PARENT_FLAG)
+    {
+        STORFS_LOGD(TAG, "Programming previous file child location");
+    }
+    else if(prevInfo.siblingLocation == origLocation || wearLevelInfo->storfsFlags & STORFS_FILE_SIBLING_FLAG)
+    {
+        STORFS_LOGD(TAG, "Programming previous file sibling location");
+        linkOffset = STORFS_HEADER_SIBLING_OFFSET;
+    }
+    else
+    {
+        return STORFS_ERROR;
+    }
+
+    //Only a link which is still erased can be programmed without erasing the page
+    for(int j = 0; j < STORFS_CHILD_DIR_REG_SIZE; j++)
+    {
+        if(headerBuf[linkOffset + j] != 0xFF)
+        {
+            return STORFS_ERROR;
+        }
+    }
+
+    link_to_uint8_t(linkBuf, currLocation, &i);
+    if(STORFS_WRITE(storfsInst, prevLoc.pageLoc, (prevLoc.byteLoc + linkOffset), linkBuf, STORFS_CHILD_DIR_REG_SIZE) != STORFS_OK)
+    {
+        return STORFS_WRITE_FAILED;
+    }
+    if(STORFS_SYNC(storfsInst) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+
+    //Ensure the link was programmed correctly, otherwise the previous file's page is rewritten
+    if(STORFS_READ(storfsInst, prevLoc.pageLoc, (prevLoc.byteLoc + linkOffset), headerBuf, STORFS_CHILD_DIR_REG_SIZE) != STORFS_OK)
+    {
+        return STORFS_READ_FAILED;
+    }
+    if(memcmp(headerBuf, linkBuf, STORFS_CHILD_DIR_REG_SIZE) != 0)
+    {
+        return STORFS_ERROR;
+    }
+
+    return STORFS_OK;
+}
+#endif
+
+static storfs_err_t write_wear_level_helper(storfs_t* storfsInst, wear_level_t *wearLevelInfo)
+{
+    wear_level_state_t state = WRITE_BAD;
+    uint8_t itr = 0;
+#ifdef STORFS_WRITEV
+    storfs_err_t status;
+#endif
+
+    //Write to the area in memory and then check the crc and determine if that page in memory is worn/not usable
+    while(1)
+    {
+#ifdef STORFS_METADATA_PACK
+        //Headers packed after another header cannot be rewritten by erasing their page
+        uint8_t packedHeader = (wearLevelInfo->storfsCurrLoc->byteLoc != 0) && 
+            (wearLevelInfo->storfsFlags & (STORFS_FILE_INIT_HEADER_WRITE | STORFS_FILE_HEADER_WRITE));
+#endif
+        STORFS_LOGD(TAG, "Writing File At %ld%ld, %ld", (uint32_t)(wearLevelInfo->storfsCurrLoc->pageLoc >> 32),(uint32_t)(wearLevelInfo->storfsCurrLoc->pageLoc), wearLevelInfo->storfsCurrLoc->byteLoc);
+
+        //Retry write if failed to the page a certain amount of times based on user defined value
+        for(int i = 0; i < STORFS_WEAR_LEVEL_RETRY_NUM; i++)
+        {
+            if(i > 0)
+            {
+                STORFS_LOGW(TAG, "Failed to write to location, re-writting to location");
+            }
+            
+            //If the programming functionality fails return an error
+#ifdef STORFS_WRITEV
+            //The data following the header is sent from the caller's buffer when it was not copied into the send buffer
+            if(wearLevelInfo->storfsFlags & STORFS_FILE_WRITEV_FLAG)
+            {
+                status = STORFS_WRITE_VEC(storfsInst, wearLevelInfo->storfsCurrLoc->pageLoc, wearLevelInfo->storfsCurrLoc->byteLoc, 
+                    wearLevelInfo->sendBuf, wearLevelInfo->headerLen, wearLevelInfo->payloadBuf, (wearLevelInfo->sendDataLen - wearLevelInfo->headerLen));
+            }
+            else
+            {
+                status = STORFS_WRITE(storfsInst, wearLevelInfo->storfsCurrLoc->pageLoc, wearLevelInfo->storfsCurrLoc->byteLoc, wearLevelInfo->sendBuf, wearLevelInfo->sendDataLen);
+            }
+            if(status != STORFS_OK)
+#else
+            if(STORFS_WRITE(storfsInst, wearLevelInfo->storfsCurrLoc->pageLoc, wearLevelInfo->storfsCurrLoc->byteLoc, wearLevelInfo->sendBuf, wearLevelInfo->sendDataLen) != STORFS_OK)
+#endif
+            {
+                STORFS_LOGE(TAG, "Writing to memory failed in function fputs");
+                return STORFS_WRITE_FAILED;
+            }
+            if(STORFS_SYNC(storfsInst) != STORFS_OK)
+            {
+                return STORFS_ERROR;
+            }
+            if(wearLevelInfo->storfsFlags & STORFS_FILE_INIT_HEADER_WRITE || 
+                wearLevelInfo->storfsFlags & STORFS_FILE_HEADER_WRITE)
+            {
+                //If CRC returned correctly, break
+                if(crc_header_check(storfsInst, *wearLevelInfo->storfsCurrLoc) == STORFS_OK)
+                {
+                    if(itr == 0)
+                    {
+                        state = WRITE_GOOD;
+                    }
+                    else
+                    {
+                        state = WRITE_RELOCATE;
+                    }
+                    break;
+                }
+            }
+            else
+            {
+                if(crc_file_check(storfsInst, *wearLevelInfo->storfsCurrLoc, (wearLevelInfo->sendDataLen - wearLevelInfo->headerLen)) == STORFS_OK)
+                {
+                    if(itr == 0)
+                    {
+                        state = WRITE_GOOD;
+                    }
+                    else
+                    {
+                        state = WRITE_RELOCATE;
+                    }
+                    break;
+                }
+            } 
+#ifdef STORFS_METADATA_PACK
+            if(packedHeader)
+            {
+                break;
+            }
+#endif
+            //On devices erased in blocks the page cannot be erased to be written again, it is freed and another is found
+            if(STORFS_BLOCK_PAGES(storfsInst) > 1)
+            {
+                if(page_free_helper(storfsInst, wearLevelInfo->storfsCurrLoc->pageLoc) != STORFS_OK)
+                {
+                    return STORFS_ERROR;
+                }
+                break;
+            }
+            if(STORFS_ERASE(storfsInst, wearLevelInfo->storfsCurrLoc->pageLoc) != STORFS_OK)
+            {
+                STORFS_LOGE(TAG, "Could not erase page in wear-level function");
+                return STORFS_ERROR;
+            }           
+        }
+
+        //If written successful, continue
+        if(state == WRITE_GOOD || state == WRITE_RELOCATE)
+        {
+            break;
+        }
+
+#ifdef STORFS_METADATA_PACK
+        //Move the packed header onto a page of its own, the other headers remain within their page
+        if(packedHeader)
+        {
+            storfsInst->cachedInfo.metaLoc.byteLoc = 0;
+            goto RELOCATE;
+        }
+#endif
+
+#ifdef STORFS_L2P_MAP
+        //Move the logical page onto a spare page and retry, the headers linking to it remain unchanged
+        if(l2p_remap(storfsInst, wearLevelInfo->storfsCurrLoc->pageLoc) == STORFS_OK)
+        {
+            continue;
+        }
+#endif
+
+#ifdef STORFS_BAD_BLOCK_TABLE
+        //Record the page so that it is not retried by any further allocation
+        bad_block_mark(storfsInst, wearLevelInfo->storfsCurrLoc->pageLoc);
+#endif
+
+        //A page already linked to by another cannot be moved without rewriting that page, the write is stopped instead
+        if(STORFS_BLOCK_PAGES(storfsInst) > 1 && !(wearLevelInfo->storfsFlags & (STORFS_FILE_INIT_HEADER_WRITE | STORFS_FILE_UNLINKED_FLAG)))
+        {
+            STORFS_LOGE(TAG, "Could not write page, it is already linked to");
+            return STORFS_WRITE_FAILED;
+        }
+
+#ifdef STORFS_METADATA_PACK
+        RELOCATE:
+#endif
+        //If CRC returns incorrectly, find another location to write to
+        if(find_next_open_byte_helper(storfsInst, wearLevelInfo->storfsCurrLoc) != STORFS_OK)
+        {
+            return STORFS_ERROR;
+        }
+
+        //If this is a file being written to, it is the first write and the send data length is greater than a page size, the fragment location must be updated as well
+        if(wearLevelInfo->storfsFlags & STORFS_FILE_WRITE_FLAG && 
+            wearLevelInfo->storfsFlags & STORFS_FILE_WRITE_INIT_FLAG &&
+            wearLevelInfo->sendDataLen >= STORFS_INST_PAGE_SIZE(storfsInst))
+        {
+            storfs_loc_t nextFragmentLoc = *wearLevelInfo->storfsCurrLoc;
+            storfs_file_header_t currInfo;
+            
+            if(find_next_open_byte_helper(storfsInst, &nextFragmentLoc) != STORFS_OK)
+            {
+                return STORFS_ERROR;
+            }
+            buf_to_info(wearLevelInfo->sendBuf, &currInfo);
+            currInfo.fragmentLocation = BYTEPAGE_TO_LOCATION(nextFragmentLoc.byteLoc, nextFragmentLoc.pageLoc, storfsInst);
+            info_to_buf(wearLevelInfo->sendBuf, &currInfo);
+        }
+
+        itr++;
+    }
+
+    //If a file was rewritten to a new location than what was expected, the previous file must be re-written with new location
+    //Or if it is the initial write to a header file, the previous file must be updated to the newest position
+    //Pages written unlinked are linked to by the caller once written
+    if((state == WRITE_RELOCATE || wearLevelInfo->storfsFlags & STORFS_FILE_INIT_HEADER_WRITE) && !(wearLevelInfo->storfsFlags & STORFS_FILE_UNLINKED_FLAG))
+    {
+        return link_update_helper(storfsInst, wearLevelInfo);
+    }
+
+    return STORFS_OK;
+}
+
+static storfs_err_t link_update_helper(storfs_t* storfsInst, wear_level_t *wearLevelInfo)
+{
+#ifdef STORFS_JOURNAL
+    storfs_err_t status;
+#endif
+
+    //The root's child location is cached, it is written along with the root
+    if(wearLevelInfo->storfsPrevLoc.pageLoc == storfsInst->cachedInfo.rootLocation[0].pageLoc &&
+        wearLevelInfo->storfsPrevLoc.byteLoc == storfsInst->cachedInfo.rootLocation[0].byteLoc)
+    {
+        storfsInst->cachedInfo.rootHeaderInfo[0].childLocation = BYTEPAGE_TO_LOCATION(wearLevelInfo->storfsCurrLoc->byteLoc, wearLevelInfo->storfsCurrLoc->pageLoc, storfsInst);
+        storfsInst->cachedInfo.rootHeaderInfo[1].childLocation = BYTEPAGE_TO_LOCATION(wearLevelInfo->storfsCurrLoc->byteLoc, wearLevelInfo->storfsCurrLoc->pageLoc, storfsInst);
+        return STORFS_OK;
+    }
+#ifdef STORFS_LINK_IN_PLACE
+    //Program the previous file's link if it has not been set yet
+    if(link_program_helper(storfsInst, wearLevelInfo) == STORFS_OK)
+    {
+        return STORFS_OK;
+    }
+#endif
+#ifdef STORFS_JOURNAL
+    //Append the link update to the journal rather than rewriting the previous file's page
+    status = journal_link_update(storfsInst, wearLevelInfo);
+    if(status == STORFS_OK)
+    {
+        return STORFS_OK;
+    }
+
+    //Within a transaction the previous file is never rewritten in place, fail if the journal has no room for the update
+    if(storfsInst->cachedInfo.journalTransaction && status == STORFS_WRITE_FAILED)
+    {
+        return STORFS_ERROR;
+    }
+#endif
+
+    return wear_level_act(storfsInst, wearLevelInfo);
+}
+
+storfs_err_t storfs_mount(storfs_t *storfsInst, char *partName)
+{
+    storfs_err_t status;
+
+    if(STORFS_WRITE_LOCK(storfsInst) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+    status = mount_helper(storfsInst, partName);
+    STORFS_UNLOCK(storfsInst, STORFS_LOCK_EXCLUSIVE);
+
+    return status;
+}
+
+static storfs_err_t mount_helper(storfs_t *storfsInst, char *partName)
+{
+    storfs_file_header_t firstPartInfo[2];
+    storfs_file_header_t nextOpenInfo;
+    storfs_loc_t nextOpenLoc;
+    uint32_t strLen = 0;
+    storfs_page_t systemPageLoc;
+
+    STORFS_LOGI(TAG, "Mounting File System");
+#ifdef STORFS_WORK_BUF
+    storfsInst->cachedInfo.workBufUsed = 0;
+#endif
+#ifdef STORFS_LAZY_SYNC
+    storfsInst->cachedInfo.deviceBusy = STORFS_BUSY_NONE;
+#endif
+#ifdef STORFS_OPEN_FILE_TABLE
+    //Headers held before mounting may no longer match the storage device
+    memset(storfsInst->cachedInfo.openFiles, 0, sizeof(storfsInst->cachedInfo.openFiles));
+    storfsInst->cachedInfo.openFileNext = 0;
+#endif
+#ifdef STORFS_FALLOCATE
+    //Reservations are only held in memory, their pages are free once mounted
+    storfsInst->cachedInfo.fallocCount = 0;
+#endif
+
+#if defined(STORFS_PAGE_SIZE_LOG2) || defined(STORFS_PAGE_COUNT)
+    //The geometry of the instance must match the geometry STORfs was compiled for
+    if(storfsInst->pageSize != STORFS_INST_PAGE_SIZE(storfsInst) || storfsInst->pageCount != STORFS_INST_PAGE_COUNT(storfsInst))
+    {
+        STORFS_LOGE(TAG, "The user defined page size/count does not match STORFS_PAGE_SIZE_LOG2/STORFS_PAGE_COUNT");
+        return STORFS_ERROR;
+    }
+#endif
+
+    //If the user defined region for the first root directory byte added to the size of the header is larger than the size of a page, return an error
+    if((storfsInst->firstByteLoc + STORFS_HEADER_TOTAL_SIZE) > STORFS_INST_PAGE_SIZE(storfsInst))
+    {
+        STORFS_LOGE(TAG, "The user defined starting byte and header size is larger than the user defined page size");
+        return STORFS_ERROR;
+    }
+
+    //On devices erased in blocks, pages are never erased while another page of their block holds data
+    //Files are only ever written onto free pages and every removed page is marked invalid, so that a block is erased once all of its pages are
+    if(storfsInst->eraseSize > STORFS_INST_PAGE_SIZE(storfsInst))
+    {
+#if !defined(STORFS_LAZY_DELETE) || defined(STORFS_L2P_MAP) || defined(STORFS_JOURNAL) || defined(STORFS_METADATA_PACK) || defined(STORFS_INLINE_FILES)
+        STORFS_LOGE(TAG, "The options defined cannot be used with an erase size larger than the page size");
+        return STORFS_ERROR;
+#endif
+        if((storfsInst->eraseSize % STORFS_INST_PAGE_SIZE(storfsInst)) != 0 || (storfsInst->firstPageLoc % STORFS_BLOCK_PAGES(storfsInst)) != 0)
+        {
+            STORFS_LOGE(TAG, "The user defined erase size is not a multiple of the page size, or the first page is not the first page of a block");
+            return STORFS_ERROR;
+        }
+    }
+
+    //Store the first partition location into the cache
+    storfsInst->cachedInfo.rootLocation[0].pageLoc = storfsInst->firstPageLoc;
+    storfsInst->cachedInfo.rootLocation[0].byteLoc = storfsInst->firstByteLoc;
+
+    //The second root header will be a page ahead of the first root header, on devices erased in blocks a block ahead so the two are never erased together
+    storfsInst->cachedInfo.rootLocation[1].byteLoc = 0;
+    storfsInst->cachedInfo.rootLocation[1].pageLoc = storfsInst->cachedInfo.rootLocation[0].pageLoc + STORFS_BLOCK_PAGES(storfsInst); 
+
+    //Any system pages used by the file system follow the second root header, each within a block of its own
+    systemPageLoc = storfsInst->cachedInfo.rootLocation[1].pageLoc + STORFS_BLOCK_PAGES(storfsInst);
+
+#if defined(STORFS_LAZY_DELETE) && defined(STORFS_IDLE)
+    //Pages freed before mounting are still marked invalid and are erased once they are allocated again
+    storfsInst->cachedInfo.idleEraseCount = 0;
+#endif
+
+#ifdef STORFS_BAD_BLOCK_TABLE
+    storfsInst->cachedInfo.badBlockLocation[0] = systemPageLoc;
+    storfsInst->cachedInfo.badBlockLocation[1] = systemPageLoc + STORFS_BLOCK_PAGES(storfsInst);
+    systemPageLoc += 2 * STORFS_BLOCK_PAGES(storfsInst);
+    if(STORFS_BAD_BLOCK_TABLE_TOTAL_SIZE(STORFS_BAD_BLOCK_TABLE_SIZE) > STORFS_INST_PAGE_SIZE(storfsInst))
+    {
+        STORFS_LOGE(TAG, "The bad block table is larger than the user defined page size");
+        return STORFS_ERROR;
+    }
+#endif
+
+#ifdef STORFS_JOURNAL
+    storfsInst->cachedInfo.journalLocation = systemPageLoc;
+    storfsInst->cachedInfo.journalTransaction = 0;
+    systemPageLoc += STORFS_JOURNAL_PAGES;
+    if(STORFS_JOURNAL_RECORD_SIZE > STORFS_INST_PAGE_SIZE(storfsInst))
+    {
+        STORFS_LOGE(TAG, "The journal record is larger than the user defined page size");
+        return STORFS_ERROR;
+    }
+#endif
+
+#ifdef STORFS_L2P_MAP
+    storfsInst->cachedInfo.l2pLocation = systemPageLoc++;
+    if(STORFS_L2P_MAP_TOTAL_SIZE(STORFS_L2P_MAP_SIZE) > STORFS_INST_PAGE_SIZE(storfsInst) || STORFS_L2P_SPARE_PAGES >= STORFS_INST_PAGE_COUNT(storfsInst))
+    {
+        STORFS_LOGE(TAG, "The logical to physical map does not fit the user defined page size/count");
+        return STORFS_ERROR;
+    }
+#endif
+
+    //Files start on the block following the system pages
+    storfsInst->cachedInfo.dataPageLoc = systemPageLoc;
+
+#ifdef STORFS_COMPACT_LINKS
+    //Every location must fit within the 32 bit header registers
+    if((STORFS_INST_PAGE_SIZE(storfsInst) * STORFS_INST_PAGE_COUNT(storfsInst)) > 0xFFFFFFFF)
+    {
+        STORFS_LOGE(TAG, "The user defined page size/count is too large for 32 bit locations");
+        return STORFS_ERROR;
+    }
+#endif
+
+#ifdef STORFS_LAZY_DELETE
+    //Removed pages are marked invalid by programming their header in place
+    if(!storfsInst->partialProgram)
+    {
+        STORFS_LOGE(TAG, "STORFS_LAZY_DELETE requires a device with partial programming");
+        return STORFS_ERROR;
+    }
+#endif
+    
+    //Store the header written to the storage and verify that the crc is correct TODO
+    file_header_store_helper(storfsInst,  &firstPartInfo[0], storfsInst->cachedInfo.rootLocation[0], "Root");
+    file_info_display_helper(&firstPartInfo[0]);
+    file_header_store_helper(storfsInst,  &firstPartInfo[1], storfsInst->cachedInfo.rootLocation[1], "Root");
+    file_info_display_helper(&firstPartInfo[1]);
+
+    //If file is empty create the root partition within the user defined parameters
+    //The system will use two headers for the root
+    if(((firstPartInfo[0].fileInfo & STORFS_INFO_REG_BLOCK_SIGN_EMPTY) == 0x60) || ((firstPartInfo[1].fileInfo & STORFS_INFO_REG_BLOCK_SIGN_EMPTY) == 0x60))
+    {      
+        //Ensure that both of the roots are cleared
+        if(STORFS_ERASE(storfsInst, storfsInst->cachedInfo.rootLocation[0].pageLoc) != STORFS_OK)
+        {
+            return STORFS_ERROR;
+        }  
+        if(STORFS_ERASE(storfsInst, storfsInst->cachedInfo.rootLocation[1].pageLoc) != STORFS_OK)
+        {
+            return STORFS_ERROR;
+        }
+#ifdef STORFS_BAD_BLOCK_TABLE
+        //Start with an empty bad block table, the first table stored is written to the first copy
+        if(STORFS_ERASE(storfsInst, storfsInst->cachedInfo.badBlockLocation[0]) != STORFS_OK ||
+            STORFS_ERASE(storfsInst, storfsInst->cachedInfo.badBlockLocation[1]) != STORFS_OK)
+        {
+            return STORFS_ERROR;
+        }
+        storfsInst->cachedInfo.badBlockCount = 0;
+        storfsInst->cachedInfo.badBlockSequence = 0;
+        storfsInst->cachedInfo.badBlockCurrent = 1;
+#endif
+#ifdef STORFS_L2P_MAP
+        //Start with every logical page mapped onto itself
+        if(l2p_load(storfsInst, STORFS_OK) != STORFS_OK)
+        {
+            return STORFS_ERROR;
+        }
+#endif
+#ifdef STORFS_JOURNAL
+        //Start with an empty journal
+        if(journal_load(storfsInst, STORFS_OK) != STORFS_OK)
+        {
+            return STORFS_ERROR;
+        }
+#endif
+
+        //Set next open byte
+        storfsInst->cachedInfo.nextOpenByte = (systemPageLoc * STORFS_INST_PAGE_SIZE(storfsInst));
+
+        //Get string length
+        while(partName[strLen++] != '\0');
+
+        //Error checking
+        if(strLen == 0 || (storfsInst->cachedInfo.nextOpenByte >= (STORFS_LOGICAL_PAGE_COUNT(storfsInst) * STORFS_INST_PAGE_SIZE(storfsInst))))
+        {
+            STORFS_LOGE(TAG, "STORfs cannot be mounted");
+            return STORFS_ERROR;
+        }
+
+        //Store file parameters
+        for(int i = 0; i < strLen; i++)
+        {
+            firstPartInfo[0].fileName[i] = partName[i];
+        }
+        firstPartInfo[0].fileInfo = STORFS_INFO_REG_BLOCK_SIGN_PART_FULL | STORFS_INFO_REG_FILE_TYPE_ROOT;
+        firstPartInfo[0].childLocation = storfsInst->cachedInfo.nextOpenByte;
+        firstPartInfo[0].siblingLocation = 0x0;
+        firstPartInfo[0].reserved = STORFS_FORMAT_VERSION;
+        firstPartInfo[0].fragmentLocation = storfsInst->cachedInfo.nextOpenByte;
+        firstPartInfo[0].fileSize = STORFS_HEADER_TOTAL_SIZE * 2;
+        firstPartInfo[0].crc = STORFS_CRC_CALC(storfsInst, firstPartInfo[0].fileName, strLen);
+        firstPartInfo[1] = firstPartInfo[0];
+
+        //Write data to first available memory location defined by user
+        if(file_header_create_helper(storfsInst, &firstPartInfo[0], storfsInst->cachedInfo.rootLocation[0], "Root") != STORFS_OK)
+        {
+            STORFS_LOGE(TAG, "The filesystem could not be created at location %ld%ld, %ld", (uint32_t)(storfsInst->cachedInfo.rootLocation[0].pageLoc >> 32), \
+                (uint32_t)(storfsInst->cachedInfo.rootLocation[0].pageLoc), storfsInst->cachedInfo.rootLocation[0].byteLoc);
+            return STORFS_ERROR; 
+        }
+
+        file_header_store_helper(storfsInst,  &firstPartInfo[0], storfsInst->cachedInfo.rootLocation[0], "Root");
+        file_info_display_helper(&firstPartInfo[0]);
+
+        //Compare the CRC obtained from the file to the computed crc of the filename
+        if(crc_compare(storfsInst, &firstPartInfo[0], firstPartInfo[0].fileName, strLen) != STORFS_OK)
+        {
+            return STORFS_ERROR;
+        }
+
+        //Write data to second available memory location following the first
+        if(file_header_create_helper(storfsInst, &firstPartInfo[1], storfsInst->cachedInfo.rootLocation[1], "Root") != STORFS_OK)
+        {
+            STORFS_LOGE(TAG, "The filesystem could not be created at location %ld%ld, %ld", (uint32_t)(storfsInst->cachedInfo.rootLocation[1].pageLoc >> 32), \
+                (uint32_t)(storfsInst->cachedInfo.rootLocation[1].pageLoc), storfsInst->cachedInfo.rootLocation[1].byteLoc);
+            return STORFS_ERROR; 
+        }
+
+        file_header_store_helper(storfsInst,  &firstPartInfo[1], storfsInst->cachedInfo.rootLocation[1], "Root");
+        file_info_display_helper(&firstPartInfo[1]);
+
+        //Compare the CRC obtained from the file to the computed crc of the filename
+        if(crc_compare(storfsInst, &firstPartInfo[1], firstPartInfo[1].fileName, strLen) != STORFS_OK)
+        {
+            return STORFS_ERROR;
+        }
+        
+
+        storfsInst->cachedInfo.rootHeaderInfo[0] = firstPartInfo[0];
+        storfsInst->cachedInfo.rootHeaderInfo[1] = firstPartInfo[1];
+    }
+    else
+    {        
+        //Get string length
+        while(firstPartInfo[0].fileName[strLen++] != '\0');
+
+        //Compare the CRC code to the register code
+        if(crc_compare(storfsInst, &firstPartInfo[0], firstPartInfo[0].fileName, strLen) != STORFS_OK)
+        {
+            return STORFS_ERROR;
+        }
+        
+        //Get string length
+        strLen = 0;
+        while(firstPartInfo[1].fileName[strLen++] != '\0');
+        
+        //Compare the CRC code to the register code
+        if(crc_compare(storfsInst, &firstPartInfo[1], firstPartInfo[1].fileName, strLen) != STORFS_OK)
+        {
+            return STORFS_ERROR;
+        }
+
+        //An image formatted with other layout options cannot be read, its headers and system pages would be misread
+        if(firstPartInfo[0].reserved != STORFS_FORMAT_VERSION || firstPartInfo[1].reserved != STORFS_FORMAT_VERSION)
+        {
+            STORFS_LOGE(TAG, "The file system format version %x does not match %x", firstPartInfo[0].reserved, STORFS_FORMAT_VERSION);
+            return STORFS_ERROR;
+        }
+
+        //Set next open byte and cache the root headers so they may be updated
+        storfsInst->cachedInfo.nextOpenByte = firstPartInfo[1].fragmentLocation;
+        storfsInst->cachedInfo.rootHeaderInfo[0] = firstPartInfo[0];
+        storfsInst->cachedInfo.rootHeaderInfo[1] = firstPartInfo[1];
+
+#ifdef STORFS_BAD_BLOCK_TABLE
+        //Load the pages known to be bad so they may be skipped
+        if(bad_block_load(storfsInst) != STORFS_OK)
+        {
+            return STORFS_ERROR;
+        }
+#endif
+#ifdef STORFS_L2P_MAP
+        //Load the remapped logical pages
+        if(l2p_load(storfsInst, STORFS_ERROR) != STORFS_OK)
+        {
+            return STORFS_ERROR;
+        }
+#endif
+#ifdef STORFS_JOURNAL
+        //Bring the cached root and header links up to date with the journal
+        if(journal_load(storfsInst, STORFS_ERROR) != STORFS_OK)
+        {
+            return STORFS_ERROR;
+        }
+#endif
+
+        //The next open byte is written to without being checked, if power was lost after pages were programmed there but before
+        //the root was updated, such as within a transaction that was never committed, move it on to the next erased page
+        nextOpenLoc.pageLoc = LOCATION_TO_PAGE(storfsInst->cachedInfo.nextOpenByte, storfsInst);
+        nextOpenLoc.byteLoc = 0;
+        if(nextOpenLoc.pageLoc < STORFS_LOGICAL_PAGE_COUNT(storfsInst))
+        {
+            if(file_header_store_helper(storfsInst, &nextOpenInfo, nextOpenLoc, "Next") != STORFS_OK)
+            {
+                return STORFS_ERROR;
+            }
+            if(!STORFS_HEADER_ERASED(nextOpenInfo))
+            {
+                STORFS_LOGW(TAG, "The next open byte holds data, searching for the next erased page");
+                if(find_update_next_open_byte(storfsInst, nextOpenLoc) != STORFS_OK)
+                {
+                    return STORFS_ERROR;
+                }
+            }
+        }
+    }
+
+#ifdef STORFS_METADATA_PACK
+    //Directories created from here on start a new metadata page
+    storfsInst->cachedInfo.metaLoc.byteLoc = 0;
+#endif
+#ifdef STORFS_ERASE_POOL
+    //Rebuild the pool from the erased pages following the next open byte
+    storfsInst->cachedInfo.erasePoolCount = 0;
+    storfsInst->cachedInfo.erasePoolScan = LOCATION_TO_PAGE(storfsInst->cachedInfo.nextOpenByte, storfsInst) + 1;
+    while(erase_pool_fill(storfsInst, 0) == STORFS_OK);
+#endif
+    
+    return STORFS_OK;
+}
+
+storfs_err_t storfs_mkdir(storfs_t *storfsInst, char *pathToDir)
+{   
+    storfs_err_t status;
+
+    STORFS_LOGI(TAG, "Making Directory at %s", pathToDir);
+
+    if(STORFS_WRITE_LOCK(storfsInst) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+    status = file_handling_helper(storfsInst, (storfs_name_t *)pathToDir, DIR_CREATE, NULL);
+    STORFS_UNLOCK(storfsInst, STORFS_LOCK_EXCLUSIVE);
+
+    return status;
+}
+
+storfs_err_t storfs_touch(storfs_t *storfsInst, char *pathToFile)
+{
+    storfs_err_t status;
+
+    STORFS_LOGI(TAG, "Making File at %s", pathToFile);
+
+    if(STORFS_WRITE_LOCK(storfsInst) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+    status = file_handling_helper(storfsInst, (storfs_name_t *)pathToFile, FILE_CREATE, NULL);
+    STORFS_UNLOCK(storfsInst, STORFS_LOCK_EXCLUSIVE);
+
+    return status;
+}
+
+storfs_err_t storfs_fopen(storfs_t *storfsInst, char *pathToFile, const char * mode, STORFS_FILE *stream)
+{
+    storfs_err_t status;
+
+    if(STORFS_WRITE_LOCK(storfsInst) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+    status = fopen_helper(storfsInst, pathToFile, mode, stream);
+    STORFS_UNLOCK(storfsInst, STORFS_LOCK_EXCLUSIVE);
+
+    return status;
+}
+
+static storfs_err_t fopen_helper(storfs_t *storfsInst, char *pathToFile, const char * mode, STORFS_FILE *stream)
+{
+    STORFS_LOGI(TAG, "Opening File at %s in %s mode", pathToFile, mode);
+    storfs_file_flags_t fileFlags = 0;
+
+    if(file_handling_helper(storfsInst, (storfs_name_t *)pathToFile, FILE_OPEN, stream) != STORFS_OK)
+    {
+        STORFS_LOGE(TAG, "Cannot open or create file");
+        goto ERR;
+    }
+
+#ifdef STORFS_INLINE_FILES
+    //The size of an inline file is held by its latest version
+    if(stream->fileInfo.fileInfo & STORFS_INFO_REG_INLINE_BIT && inline_size_helper(storfsInst, stream) != STORFS_OK)
+    {
+        goto ERR;
+    }
+#endif
+
+    //Determine the flags to write to the file
+    if(strcmp(mode, "w") == 0)
+    {
+        //Determine if the file is already populated with data, and if it is delete the file associated
+        if(stream->fileInfo.fileSize > STORFS_HEADER_TOTAL_SIZE)
+        {
+            if(fopen_write_flag_helper(storfsInst, pathToFile, stream) != STORFS_OK)
+            {
+                goto ERR;
+            }   
+        }
+
+        fileFlags = STORFS_FILE_WRITE_FLAG;
+    }
+    else if(strcmp(mode, "r") == 0)
+    {
+        fileFlags = STORFS_FILE_READ_FLAG;
+    }
+    else if(strcmp(mode, "a") == 0)
+    {
+        fileFlags = STORFS_FILE_APPEND_FLAG;
+    }
+    else if(strcmp(mode, "w+") == 0)
+    {
+        //Determine if the file is already populated with data, and if it is delete the file associated
+        if(stream->fileInfo.fileSize > STORFS_HEADER_TOTAL_SIZE)
+        {
+            if(fopen_write_flag_helper(storfsInst, pathToFile, stream) != STORFS_OK)
+            {
+                goto ERR;
+            }
+        }
+
+        fileFlags = STORFS_FILE_WRITE_FLAG | STORFS_FILE_READ_FLAG;
+    }
+    else if(strcmp(mode, "r+") == 0)
+    {
+        fileFlags = STORFS_FILE_WRITE_FLAG | STORFS_FILE_READ_FLAG;
+    }
+    else if(strcmp(mode, "a+") == 0)
+    {
+        fileFlags = STORFS_FILE_APPEND_FLAG | STORFS_FILE_READ_FLAG;
+    }
+    else
+    {
+        //Default file flag to file read
+        fileFlags = STORFS_FILE_READ_FLAG;
+    }
+    
+    //Rewind the file back to the original location, unset rewind flag
+    storfs_rewind(storfsInst, stream);
+    stream->fileFlags &= ~(STORFS_FILE_REWIND_FLAG);
+
+    //Set the current file flags as the file flags for the returned FILE struct
+    stream->fileFlags = fileFlags;
+
+    STORFS_LOGD(TAG, "File Location: %ld%ld, %ld \r\n \
+    File Flags: %ld", (uint32_t)(stream->fileLoc.pageLoc >> 32), (uint32_t)(stream->fileLoc.pageLoc ), stream->fileLoc.byteLoc, fileFlags);
+
+    return STORFS_OK;
+
+    ERR:
+        return STORFS_ERROR;
+}
+
+storfs_err_t storfs_fputs(storfs_t *storfsInst, const char *str, const int n, STORFS_FILE *stream)
+{
+    storfs_err_t status;
+
+    if(STORFS_WRITE_LOCK(storfsInst) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+    status = write_helper(storfsInst, str, NULL, NULL, n, stream);
+    STORFS_UNLOCK(storfsInst, STORFS_LOCK_EXCLUSIVE);
+
+    return status;
+}
+
+storfs_err_t storfs_fwrite_stream(storfs_t *storfsInst, STORFS_FILE *stream, storfs_file_size_t size, storfs_producer_cb_t producer, void *ctx)
+{
+    storfs_err_t status;
+
+    if(producer == NULL || size > INT32_MAX)
+    {
+        STORFS_LOGE(TAG, "Cannot write to file");
+        return STORFS_ERROR;
+    }
+
+    if(STORFS_WRITE_LOCK(storfsInst) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+    status = write_helper(storfsInst, NULL, producer, ctx, (int)size, stream);
+    STORFS_UNLOCK(storfsInst, STORFS_LOCK_EXCLUSIVE);
+
+    return status;
+}
+
+static storfs_err_t write_helper(storfs_t *storfsInst, const char *str, storfs_producer_cb_t producer, void *ctx, const int n, STORFS_FILE *stream)
+{
+    storfs_write_t write;
+    storfs_err_t status;
+
+    status = write_begin_helper(storfsInst, str, producer, ctx, n, stream, &write);
+
+    //Program each page of the file in turn
+    while(status == STORFS_OK && write.sendDataItr > 0)
+    {
+        status = write_page_helper(storfsInst, &write);
+    }
+    if(status != STORFS_OK || write.currItr == 0)
+    {
+        return status;
+    }
+
+    return write_end_helper(storfsInst, &write);
+}
+
+static storfs_err_t write_begin_helper(storfs_t *storfsInst, const char *str, storfs_producer_cb_t producer, void *ctx, const int n, STORFS_FILE *stream, storfs_write_t *write)
+{
+    //Nothing is left to be programmed unless the write is started
+    write->sendDataItr = 0;
+    write->currItr = 0;
+
+    //Sanity Check
+    if(storfsInst == NULL || stream == NULL || (str == NULL && producer == NULL) || n == 0 || stream == NULL)
+    {
+        STORFS_LOGE(TAG, "Cannot write to file");
+        return STORFS_ERROR;
+    }
+
+    //Error if next write is larger than the page count
+    if(LOCATION_TO_PAGE(storfsInst->cachedInfo.nextOpenByte, storfsInst) >= STORFS_LOGICAL_PAGE_COUNT(storfsInst))
+    {
+        STORFS_LOGE(TAG, "Cannot write any more data to the file system");
+        return STORFS_ERROR;
+    }
+
+    //If the file is opened in read only return an error
+    if(stream->fileFlags == STORFS_FILE_READ_FLAG)
+    {
+        STORFS_LOGE(TAG, "Cannot write to file, in read only mode");
+        return STORFS_ERROR;
+    }
+
+    STORFS_LOGI(TAG, "Writing to file %s", stream->fileInfo.fileName);
+
+#ifdef STORFS_INLINE_FILES
+    //Small files are written as a new version within the metadata page, once too large they are moved onto pages of their own
+    if(stream->fileInfo.fileInfo & STORFS_INFO_REG_INLINE_BIT)
+    {
+        //The data of a producer is gathered first if it may be held inline
+        if(producer != NULL && n <= STORFS_INLINE_FILE_SIZE)
+        {
+            if(producer(ctx, (uint8_t *)write->inlineBuf, n) != STORFS_OK)
+            {
+                return STORFS_ERROR;
+            }
+            str = write->inlineBuf;
+            producer = NULL;
+        }
+        if(producer == NULL && inline_write_helper(storfsInst, str, n, stream) == STORFS_OK)
+        {
+            return STORFS_OK;
+        }
+        if(inline_promote_helper(storfsInst, stream) != STORFS_OK)
+        {
+            return STORFS_ERROR;
+        }
+    }
+#endif
+
+    //The pages are programmed by write_page_helper, the first of them also reads in the data being appended to
+    write->str = str;
+    write->producer = producer;
+    write->ctx = ctx;
+    write->stream = stream;
+    write->headerLen = STORFS_HEADER_TOTAL_SIZE;
+    write->count = n;
+    write->sendDataItr = 1;
+    write->currDataHeaderLoc = stream->fileLoc;
+    write->nextDataHeaderLoc = stream->fileLoc;
+    write->prevDataHeaderLoc = stream->filePrevLoc;
+    write->origHeaderLoc = stream->fileLoc;
+    write->appendHeaderByteLoc = 0;
+#ifdef STORFS_EXTENT_ALLOC
+    write->extentPageNum = 0;
+#endif
+#ifdef STORFS_OPEN_FILE_TABLE
+    write->headKnown = 0;
+#endif
+
+    return STORFS_OK;
+}
+
+static storfs_err_t write_setup_helper(storfs_t *storfsInst, storfs_write_t *write, uint8_t *sendBuf)
+{
+    STORFS_FILE *stream = write->stream;
+    storfs_file_size_t updatedFileSize;                                       //Updated filesize to be written to the header
+
+    //Get updated file information, the open file table holds it until the page of the header is changed
+    if(STORFS_HEADER_LOAD(storfsInst, &stream->fileInfo, stream->fileLoc, "Updated") != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+
+    //On devices erased in blocks a file is moved whenever it or a file it links to is written, a stream left at its old page must be opened again
+    //Data is never appended in place, as the pages being appended to cannot be erased on their own
+    if(STORFS_BLOCK_PAGES(storfsInst) > 1)
+    {
+#ifdef STORFS_LAZY_DELETE
+        if(stream->fileInfo.fileInfo == 0xFF || STORFS_HEADER_INVALID(stream->fileInfo.fileInfo))
+        {
+            STORFS_LOGE(TAG, "Cannot write to file, it has been moved and must be opened again");
+            return STORFS_ERROR;
+        }
+#endif
+        if(stream->fileFlags & STORFS_FILE_APPEND_FLAG && stream->fileInfo.fileSize > STORFS_HEADER_TOTAL_SIZE && !(stream->fileFlags & STORFS_FILE_REWIND_FLAG))
+        {
+            STORFS_LOGE(TAG, "Cannot append to file with an erase size larger than the page size");
+            return STORFS_ERROR;
+        }
+    }
+
+    if(stream->fileFlags & STORFS_FILE_APPEND_FLAG && stream->fileInfo.fileSize > STORFS_HEADER_TOTAL_SIZE && !(stream->fileFlags & STORFS_FILE_REWIND_FLAG))
+    {
+        //Update the file size of the main header
+        updatedFileSize = stream->fileInfo.fileSize + write->count + ((write->count / (STORFS_INST_PAGE_SIZE(storfsInst) - STORFS_FRAGMENT_HEADER_TOTAL_SIZE)) * STORFS_FRAGMENT_HEADER_TOTAL_SIZE);
+
+        //Store the file header
+        write->currHeaderInfo = stream->fileInfo;
+
+        //Find the current location of the header to be appended on to
+        write->currDataHeaderLoc.byteLoc = 0;
+        while(write->currHeaderInfo.fragmentLocation != 0x00)
+        {
+            //Set the previous header location to the current
+            write->prevDataHeaderLoc = write->currDataHeaderLoc;
+
+            //Set the current header location to the fragment location
+            write->currDataHeaderLoc.pageLoc = LOCATION_TO_PAGE(write->currHeaderInfo.fragmentLocation, storfsInst);
+            file_header_store_helper(storfsInst, &write->currHeaderInfo, write->currDataHeaderLoc, "Append");
+        }
+       
+        //If the location of the next available byte is greater than the files original location...
+        if(write->currDataHeaderLoc.pageLoc != stream->fileLoc.pageLoc)
+        {
+            STORFS_LOGD(TAG, "Appending to file fragment");
+
+            //Append needed to write onto the current buffer length
+            write->appendHeaderByteLoc = (stream->fileInfo.fileSize % STORFS_INST_PAGE_SIZE(storfsInst)) - STORFS_FRAGMENT_HEADER_TOTAL_SIZE;
+            if(write->appendHeaderByteLoc < 0)
+            {
+                write->appendHeaderByteLoc = 0;
+            }
+
+            //Update the file size register in the header of the file
+            stream->fileInfo.fileSize = updatedFileSize;
+            if(STORFS_READ(storfsInst, stream->fileLoc.pageLoc, STORFS_HEADER_TOTAL_SIZE, (sendBuf + STORFS_HEADER_TOTAL_SIZE), (STORFS_INST_PAGE_SIZE(storfsInst) - STORFS_HEADER_TOTAL_SIZE)) != STORFS_OK)
+            {
+                return STORFS_READ_FAILED;
+            }
+
+            //Delete the file header so it may be written to
+            if(STORFS_ERASE(storfsInst, stream->fileLoc.pageLoc) != STORFS_OK)
+            {
+                return STORFS_ERROR;
+            }
+
+            //Write the new file header with the updated information
+            info_to_buf(sendBuf, &stream->fileInfo);
+            if(STORFS_WRITE(storfsInst,  stream->fileLoc.pageLoc, 0, sendBuf, STORFS_INST_PAGE_SIZE(storfsInst)) != STORFS_OK)
+            {
+                return STORFS_WRITE_FAILED;
+            }
+
+            //Read in the current header of the data buffer
+            if(STORFS_READ(storfsInst, write->currDataHeaderLoc.pageLoc, STORFS_FRAGMENT_HEADER_TOTAL_SIZE, (sendBuf + STORFS_FRAGMENT_HEADER_TOTAL_SIZE), (write->appendHeaderByteLoc - STORFS_FRAGMENT_HEADER_TOTAL_SIZE)) != STORFS_OK)
+            {
+                return STORFS_READ_FAILED;
+            }
+            //Delete the page from memory so it may be re-written
+            if(STORFS_ERASE(storfsInst, write->currDataHeaderLoc.pageLoc) != STORFS_OK)
+            {
+                return STORFS_ERROR;
+            }
+
+            //Set the header length to fragment header size
+            write->headerLen = STORFS_FRAGMENT_HEADER_TOTAL_SIZE;
+        }
+        else
+        {
+            STORFS_LOGD(TAG, "Appending to file head");
+
+            //Append needed to write onto the current buffer length
+            write->appendHeaderByteLoc = stream->fileInfo.fileSize - STORFS_HEADER_TOTAL_SIZE;
+            if(write->appendHeaderByteLoc < 0)
+            {
+                write->appendHeaderByteLoc = 0;
+            }
+
+            //Read in the current header of the data buffer
+            if(STORFS_READ(storfsInst, stream->fileLoc.pageLoc, STORFS_HEADER_TOTAL_SIZE, (sendBuf + STORFS_HEADER_TOTAL_SIZE), (write->appendHeaderByteLoc - STORFS_HEADER_TOTAL_SIZE)) != STORFS_OK)
+            {
+                return STORFS_READ_FAILED;
+            }
+            //Delete the page from memory so it may be re-written
+            if(STORFS_ERASE(storfsInst, stream->fileLoc.pageLoc) != STORFS_OK)
+            {
+                return STORFS_ERROR;
+            }
+
+            //Set the current filesize information
+            write->currHeaderInfo.fileSize = updatedFileSize;
+        }
+
+        //Adjust the count of data to be written to
+        write->count+=write->appendHeaderByteLoc;
+        
+        STORFS_LOGD(TAG, "Append File Location: %ld%ld, %ld", (uint32_t)(write->currDataHeaderLoc.pageLoc >> 32),(uint32_t)write->currDataHeaderLoc.pageLoc, write->appendHeaderByteLoc + write->headerLen);
+
+        //Determine the number of iterations that must be programmed to the device
+        write->sendDataItr = (write->count + STORFS_INST_PAGE_SIZE(storfsInst)) / (STORFS_INST_PAGE_SIZE(storfsInst) - STORFS_FRAGMENT_HEADER_TOTAL_SIZE);
+        
+        //Set the next data header location to this location
+        write->nextDataHeaderLoc = write->currDataHeaderLoc;
+
+        //Adjust reading file size remainder
+        stream->fileRead.fileSizeRem -= write->appendHeaderByteLoc;
+    }
+    else
+    {
+        //Store the current header so it may be updated when initially writting to memory
+        write->currHeaderInfo = stream->fileInfo;
+
+        //On devices erased in blocks the file is written onto free pages from the next open byte, the old file is kept until the write ends
+        if(STORFS_BLOCK_PAGES(storfsInst) > 1)
+        {
+            stream->fileLoc.pageLoc = LOCATION_TO_PAGE(storfsInst->cachedInfo.nextOpenByte, storfsInst);
+            stream->fileLoc.byteLoc = 0;
+            write->currDataHeaderLoc = stream->fileLoc;
+            write->nextDataHeaderLoc = stream->fileLoc;
+            STORFS_FALLOC_MOVE(storfsInst, write->origHeaderLoc.pageLoc, stream->fileLoc.pageLoc);
+        }
+        else
+        {
+            // Delete the file to be written to
+            file_delete_helper(storfsInst, write->currDataHeaderLoc, &write->currHeaderInfo, 0);
+        }
+
+        //Update the file size register
+        updatedFileSize = STORFS_HEADER_TOTAL_SIZE + write->count + ((write->count / (STORFS_INST_PAGE_SIZE(storfsInst) - STORFS_FRAGMENT_HEADER_TOTAL_SIZE)) * STORFS_FRAGMENT_HEADER_TOTAL_SIZE);
+
+        //Update the file size register in the header of the file
+        write->currHeaderInfo.fileSize = updatedFileSize;
+
+        //Determine the number of iterations that must be programmed to the device
+        write->sendDataItr = 1;
+        if((write->count + STORFS_HEADER_TOTAL_SIZE) > STORFS_INST_PAGE_SIZE(storfsInst))
+        {
+            write->sendDataItr += ((write->count - (STORFS_INST_PAGE_SIZE(storfsInst) - STORFS_HEADER_TOTAL_SIZE)) + STORFS_INST_PAGE_SIZE(storfsInst)) / (STORFS_INST_PAGE_SIZE(storfsInst) - STORFS_FRAGMENT_HEADER_TOTAL_SIZE);
+        }
+
+        //Reset reading file size remainder and file read pointer
+        stream->fileRead.fileSizeRem = 0;
+        stream->fileRead.readLocPtr.pageLoc = stream->fileLoc.pageLoc;
+        stream->fileRead.readLocPtr.byteLoc = STORFS_HEADER_TOTAL_SIZE;
+    }
+
+    return STORFS_OK;
+}
+
+static storfs_err_t write_page_helper(storfs_t *storfsInst, storfs_write_t *write)
+{
+    wear_level_t wearLevelInfo;                                               //Needed for wear level writing
+    STORFS_WORK_BUF_TAKE(storfsInst, sendBuf, STORFS_INST_PAGE_SIZE(storfsInst));         //Buffer of data to send to flash device
+    uint8_t headerBuf[STORFS_HEADER_TOTAL_SIZE];                              //Buffer used to store the header of each page
+    int32_t pageDataLen;                                                      //Length of the new data placed within the current page
+    STORFS_FILE *stream = write->stream;
+    storfs_err_t status;
+
+    if(STORFS_WORK_BUF_FAILED(sendBuf))
+    {
+        return STORFS_ERROR;
+    }
+
+    //Before the first page is programmed the file is truncated, or the data being appended to is read into the buffer
+    if(write->currItr == 0)
+    {
+        status = write_setup_helper(storfsInst, write, sendBuf);
+        if(status != STORFS_OK)
+        {
+            STORFS_WORK_BUF_RETURN(storfsInst, sendBuf, status);
+        }
+    }
+
+    //Determine which type of header to store
+    if(write->currItr > 0)
+    {
+        write->headerLen = STORFS_FRAGMENT_HEADER_TOTAL_SIZE;
+        write->currHeaderInfo.fileInfo &= ~(STORFS_INFO_REG_FILE_TYPE_FILE);
+        write->currHeaderInfo.fileInfo &= ~(STORFS_INFO_REG_NOT_FRAGMENT_BIT);
+    }
+    else
+    {
+        write->currHeaderInfo.fileInfo |= STORFS_INFO_REG_NOT_FRAGMENT_BIT;
+    }
+    
+
+    //If the string length is greater than a page size ensure the sent data can maximally be the page size
+    if((write->count + write->headerLen) > STORFS_INST_PAGE_SIZE(storfsInst))
+    {
+        wearLevelInfo.sendDataLen = STORFS_INST_PAGE_SIZE(storfsInst);
+        write->count -= (STORFS_INST_PAGE_SIZE(storfsInst) - write->headerLen);
+
+#ifdef STORFS_EXTENT_ALLOC
+        //Reserve a run of free pages for every fragment of the write up front, searching from where the first fragment would be found
+        if(write->currItr == 0)
+        {
+            write->extentLoc = write->nextDataHeaderLoc;
+            if(storfsInst->cachedInfo.nextOpenByte < BYTEPAGE_TO_LOCATION(write->currDataHeaderLoc.byteLoc, write->currDataHeaderLoc.pageLoc, storfsInst))
+            {
+                write->extentLoc.pageLoc = LOCATION_TO_PAGE(storfsInst->cachedInfo.nextOpenByte, storfsInst) - 1;
+            }
+            write->extentPageNum = (write->count + STORFS_INST_PAGE_SIZE(storfsInst) - STORFS_FRAGMENT_HEADER_TOTAL_SIZE - 1) / (STORFS_INST_PAGE_SIZE(storfsInst) - STORFS_FRAGMENT_HEADER_TOTAL_SIZE);
+
+            //Pages reserved by storfs_fallocate are taken without searching, any fragments beyond them are found one at a time
+            if(STORFS_FALLOC_TAKE(storfsInst, stream->fileLoc.pageLoc, &write->extentLoc, &write->extentPageNum) != STORFS_OK &&
+                (write->extentPageNum < 2 || extent_alloc_helper(storfsInst, &write->extentLoc, write->extentPageNum) != STORFS_OK))
+            {
+                write->extentPageNum = 0;
+            }
+        }
+
+        //Fragments are placed one after another within the run, otherwise they are found one at a time
+        if(write->extentPageNum > 0)
+        {
+            write->nextDataHeaderLoc = write->extentLoc;
+            write->extentLoc.pageLoc += 1;
+            write->extentPageNum--;
+        }
+        else
+#endif
+        //Determine where the fragment location will be at
+        if((storfsInst->cachedInfo.nextOpenByte < BYTEPAGE_TO_LOCATION(write->currDataHeaderLoc.byteLoc, write->currDataHeaderLoc.pageLoc, storfsInst)) && write->currItr == 0)
+        {
+            write->nextDataHeaderLoc.pageLoc = LOCATION_TO_PAGE(storfsInst->cachedInfo.nextOpenByte, storfsInst);
+        }
+        else if(find_next_open_byte_helper(storfsInst, &write->nextDataHeaderLoc) != STORFS_OK)
+        {
+            STORFS_LOGE(TAG, "Cannot write any more data to the file system");
+            STORFS_WORK_BUF_RETURN(storfsInst, sendBuf, STORFS_ERROR);
+        }
+        
+        //Set the file header to full in the current header
+        write->currHeaderInfo.fileInfo &= ~(STORFS_INFO_REG_BLOCK_SIGN_EMPTY);
+        write->currHeaderInfo.fileInfo |= STORFS_INFO_REG_BLOCK_SIGN_FULL;
+
+        //Update the fragment register in the previous header with the new fragment location
+        write->currHeaderInfo.fragmentLocation = BYTEPAGE_TO_LOCATION(write->nextDataHeaderLoc.byteLoc, write->nextDataHeaderLoc.pageLoc, storfsInst);
+        
+    }
+    else
+    {
+        wearLevelInfo.sendDataLen = write->count + write->headerLen;
+
+        //If the total size is written to the page then set the file info flag as block full of data
+        if(wearLevelInfo.sendDataLen == STORFS_INST_PAGE_SIZE(storfsInst))
+        {
+            write->currHeaderInfo.fileInfo &= ~(STORFS_INFO_REG_BLOCK_SIGN_EMPTY);
+            write->currHeaderInfo.fileInfo |= STORFS_INFO_REG_BLOCK_SIGN_FULL;
+        }
+        else
+        {
+            write->currHeaderInfo.fileInfo &= ~(STORFS_INFO_REG_BLOCK_SIGN_EMPTY);
+            write->currHeaderInfo.fileInfo |= STORFS_INFO_REG_BLOCK_SIGN_PART_FULL;
+        }
+
+        write->currHeaderInfo.fragmentLocation = 0x00;
+    }
+
+    //Convert the current header info into a buffer and store it in the first bytes to be programmed
+    //Store the data to be programmed as well in the buffer after any data being appended to, a producer fills it directly
+    pageDataLen = wearLevelInfo.sendDataLen - write->headerLen - write->appendHeaderByteLoc;
+#ifdef STORFS_WRITEV
+    wearLevelInfo.payloadBuf = NULL;
+#endif
+    if(pageDataLen > 0)
+    {
+        if(write->producer != NULL)
+        {
+            if(write->producer(write->ctx, (sendBuf + write->headerLen + write->appendHeaderByteLoc), pageDataLen) != STORFS_OK)
+            {
+                STORFS_LOGE(TAG, "Producer failed in function fwrite_stream");
+                STORFS_WORK_BUF_RETURN(storfsInst, sendBuf, STORFS_ERROR);
+            }
+        }
+#ifdef STORFS_WRITEV
+        //Drivers able to write the header and data apart are sent the data straight from the caller's buffer
+        else if(storfsInst->writev != NULL && write->appendHeaderByteLoc == 0)
+        {
+            wearLevelInfo.payloadBuf = (const uint8_t*)write->str;
+            write->str += pageDataLen;
+        }
+#endif
+        else
+        {
+            memcpy((sendBuf + write->headerLen + write->appendHeaderByteLoc), write->str, pageDataLen);
+            write->str += pageDataLen;
+        }
+    }
+
+    //Calculate CRC
+#ifdef STORFS_WRITEV
+    if(wearLevelInfo.payloadBuf != NULL)
+    {
+        write->currHeaderInfo.crc = STORFS_CRC_CALC(storfsInst, wearLevelInfo.payloadBuf, (wearLevelInfo.sendDataLen - write->headerLen));
+    }
+    else
+#endif
+    write->currHeaderInfo.crc = STORFS_CRC_CALC(storfsInst, (uint8_t*)(sendBuf + write->headerLen), (wearLevelInfo.sendDataLen - write->headerLen));
+
+    //Place Header into buffer
+    info_to_buf(headerBuf, &write->currHeaderInfo);
+    for(int i = 0; i < write->headerLen; i++)
+    {
+        sendBuf[i] = headerBuf[i];
+    }
+
+    //Wear level handling for information
+    wearLevelInfo.headerLen = write->headerLen;
+    wearLevelInfo.sendBuf = sendBuf;
+    wearLevelInfo.storfsCurrLoc = &write->currDataHeaderLoc;
+    wearLevelInfo.storfsOrigLoc = write->currDataHeaderLoc;
+    wearLevelInfo.storfsPrevLoc = write->prevDataHeaderLoc;
+    wearLevelInfo.storfsInfo = stream->fileInfo;
+    wearLevelInfo.storfsInfoLoc = stream->fileLoc;
+    wearLevelInfo.storfsFlags = STORFS_FILE_WRITE_FLAG | STORFS_FILE_WRITE_INIT_FLAG;
+#ifdef STORFS_WRITEV
+    if(wearLevelInfo.payloadBuf != NULL)
+    {
+        wearLevelInfo.storfsFlags |= STORFS_FILE_WRITEV_FLAG;
+    }
+#endif
+    //On devices erased in blocks the file's header is linked to once the write ends, until then it may be moved freely
+    if(STORFS_BLOCK_PAGES(storfsInst) > 1 && write->currItr == 0)
+    {
+        wearLevelInfo.storfsFlags |= STORFS_FILE_UNLINKED_FLAG;
+    }
+    if(write_wear_level_helper(storfsInst, &wearLevelInfo) != STORFS_OK)
+    {
+        if(STORFS_BLOCK_PAGES(storfsInst) > 1)
+        {
+            write_abort_helper(storfsInst, write);
+        }
+        STORFS_WORK_BUF_RETURN(storfsInst, sendBuf, STORFS_ERROR);
+    }
+    if(STORFS_BLOCK_PAGES(storfsInst) > 1 && write->currItr == 0)
+    {
+        stream->fileLoc = *wearLevelInfo.storfsCurrLoc;
+    }
+
+#ifdef STORFS_OPEN_FILE_TABLE
+    //The head header written is the file's header unless wear-levelling moved a page, which rewrites the previous header
+    if(wearLevelInfo.storfsCurrLoc->pageLoc != wearLevelInfo.storfsOrigLoc.pageLoc)
+    {
+        write->headKnown = 0;
+    }
+    else if(write->currItr == 0 && write->headerLen == STORFS_HEADER_TOTAL_SIZE)
+    {
+        buf_to_info(headerBuf, &write->headInfo);
+        write->headKnown = 1;
+    }
+#endif
+
+#ifdef STORFS_EXTENT_ALLOC
+    //A relocated page links to the page found after it, the remaining fragments follow it one at a time
+    if(wearLevelInfo.storfsCurrLoc->pageLoc != wearLevelInfo.storfsOrigLoc.pageLoc)
+    {
+        write->extentPageNum = 0;
+        write->nextDataHeaderLoc = *wearLevelInfo.storfsCurrLoc;
+    }
+#endif
+
+    //Decrement the number of iterations left
+    --write->sendDataItr;
+
+    //Set current header location equal to the next, and previous to current
+    if(wearLevelInfo.storfsCurrLoc->pageLoc >= write->nextDataHeaderLoc.pageLoc)
+    {
+        //Update nextOpenByte to what is available, there is only need for a page if more are to be written
+        if(find_next_open_byte_helper(storfsInst, &write->currDataHeaderLoc) != STORFS_OK && write->sendDataItr > 0)
+        {
+            STORFS_WORK_BUF_RETURN(storfsInst, sendBuf, STORFS_ERROR);
+        }
+        storfsInst->cachedInfo.nextOpenByte = BYTEPAGE_TO_LOCATION(write->currDataHeaderLoc.byteLoc, write->currDataHeaderLoc.pageLoc, storfsInst);
+
+        //If the current header location is equivalent to the stream's original file location and there was an error writing, update the stream's file location
+        if(write->currDataHeaderLoc.pageLoc == stream->fileLoc.pageLoc)
+        {
+            stream->fileLoc = *wearLevelInfo.storfsCurrLoc;
+        }
+    }
+    else
+    {
+        write->currDataHeaderLoc = write->nextDataHeaderLoc;
+    }
+    write->prevDataHeaderLoc = *wearLevelInfo.storfsCurrLoc;
+
+    //Increment current iteration number
+    write->currItr++;
+
+    //Increment read file size remainder
+    stream->fileRead.fileSizeRem += (wearLevelInfo.sendDataLen - write->headerLen);
+    STORFS_LOGD(TAG, "Read File Size Remainder %ld", stream->fileRead.fileSizeRem);
+
+    //Set the append header byte location to 0
+    if(write->appendHeaderByteLoc > 0)
+    {
+        write->appendHeaderByteLoc = 0;
+    }
+
+    STORFS_WORK_BUF_RETURN(storfsInst, sendBuf, STORFS_OK);
+}
+
+static void write_abort_helper(storfs_t *storfsInst, storfs_write_t *write)
+{
+    STORFS_FILE *stream = write->stream;
+    storfs_file_header_t headInfo;
+
+    //The old file is left in place, only the pages written before the failed one are freed as it has been freed already
+    STORFS_FALLOC_MOVE(storfsInst, stream->fileLoc.pageLoc, write->origHeaderLoc.pageLoc);
+    if(write->currItr > 0 && file_header_store_helper(storfsInst, &headInfo, stream->fileLoc, "Aborted") == STORFS_OK)
+    {
+        headInfo.fileSize = (write->currItr - 1) * STORFS_INST_PAGE_SIZE(storfsInst);
+        file_delete_helper(storfsInst, stream->fileLoc, &headInfo, 1);
+    }
+    stream->fileLoc = write->origHeaderLoc;
+}
+
+static storfs_err_t write_end_helper(storfs_t *storfsInst, storfs_write_t *write)
+{
+    STORFS_FILE *stream = write->stream;
+
+    //On devices erased in blocks the file written onto free pages takes the place of the old file
+    if(STORFS_BLOCK_PAGES(storfsInst) > 1 && stream->fileLoc.pageLoc != write->origHeaderLoc.pageLoc &&
+        file_replace_helper(storfsInst, write->origHeaderLoc, stream->fileLoc) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+
+    //Store the updated header into the file information
+#ifdef STORFS_OPEN_FILE_TABLE
+    if(write->headKnown)
+    {
+        stream->fileInfo = write->headInfo;
+#ifdef STORFS_JOURNAL
+        journal_apply(storfsInst, stream->fileLoc, &stream->fileInfo);
+#endif
+        open_file_hold(storfsInst, stream->fileLoc, &stream->fileInfo);
+    }
+    else
+#endif
+    if(STORFS_HEADER_LOAD(storfsInst,  &stream->fileInfo, stream->fileLoc, "Updated FILE") != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+    
+    //Find and update the next open byte available if the next open byte is currently larger than the file's location
+    if(storfsInst->cachedInfo.nextOpenByte <= BYTEPAGE_TO_LOCATION(write->currDataHeaderLoc.byteLoc, write->currDataHeaderLoc.pageLoc, storfsInst))
+    {
+        write->currDataHeaderLoc.pageLoc = LOCATION_TO_PAGE(storfsInst->cachedInfo.nextOpenByte, storfsInst) - 1;
+        find_update_next_open_byte(storfsInst, write->currDataHeaderLoc);
+    } 
+    else
+    {
+        //Update the root with current values possibly overwritten when using wear-levelling
+        update_root(storfsInst);
+    }
+
+    if(stream->fileFlags & STORFS_FILE_REWIND_FLAG)
+    {
+        STORFS_LOGD(TAG, "Rewound file has been written");
+        stream->fileFlags &= ~(STORFS_FILE_REWIND_FLAG);
+    }
+
+    file_info_display_helper(&stream->fileInfo);
+
+    return STORFS_OK;
+}
+
+storfs_err_t storfs_fgets(storfs_t *storfsInst, char *str, int n, STORFS_FILE *stream)
+{
+    storfs_err_t status;
+
+    //Reading a stream does not modify the file system, other readers may run concurrently unless the open file table is used
+    if(STORFS_LOCK(storfsInst, STORFS_READ_LOCK) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+    status = fgets_helper(storfsInst, str, n, stream);
+    STORFS_UNLOCK(storfsInst, STORFS_READ_LOCK);
+
+    return status;
+}
+
+static storfs_err_t fgets_helper(storfs_t *storfsInst, char *str, int n, STORFS_FILE *stream)
+{
+    if(storfsInst == NULL || stream == NULL || stream->fileFlags == STORFS_FILE_DELETED_FLAG)
+    {
+        STORFS_LOGE(TAG, "Cannot read from file, it does not exist");
+        return STORFS_ERROR;
+    }
+    if(stream->fileFlags == STORFS_FILE_WRITE_FLAG || stream->fileFlags == STORFS_FILE_APPEND_FLAG)
+    {
+        STORFS_LOGE(TAG, "Cannot read file, in incorrect mode");
+        return STORFS_ERROR;
+    }
+
+    STORFS_LOGI(TAG, "Reading from file %s", stream->fileInfo.fileName);
+
+#ifdef STORFS_INLINE_FILES
+    if(stream->fileInfo.fileInfo & STORFS_INFO_REG_INLINE_BIT)
+    {
+        return inline_read_helper(storfsInst, str, n, stream);
+    }
+#endif
+
+    int32_t recvDataItr = 0;                                    //Iterations to read from file
+    uint32_t recvDataLen;                                       //Current length to read from file
+    storfs_file_header_t currHeaderInfo;                        //Info of the current in the file
+    uint32_t headerLen = STORFS_HEADER_TOTAL_SIZE;              //Fragment or file header length
+    int count = n;                                              //Storage for total number of bytes to be read from the file
+    storfs_loc_t recvDataHeaderLoc;                             //The location of the current file header in memory
+    
+    recvDataHeaderLoc.pageLoc = stream->fileRead.readLocPtr.pageLoc;
+    recvDataHeaderLoc.byteLoc = 0;
+
+    //Only the fragment location is used, the open file table holds the header until the page being read is changed
+    STORFS_HEADER_LOAD(storfsInst, &currHeaderInfo, recvDataHeaderLoc, "fgets");
+    
+    //Determine the number of iterations needed to read from the file
+    if(count < stream->fileRead.fileSizeRem)
+    {
+        if(count > STORFS_INST_PAGE_SIZE(storfsInst))
+        {
+            recvDataItr = (count + STORFS_HEADER_TOTAL_SIZE + ((count / STORFS_INST_PAGE_SIZE(storfsInst)) * STORFS_FRAGMENT_HEADER_TOTAL_SIZE) + STORFS_INST_PAGE_SIZE(storfsInst)) / STORFS_INST_PAGE_SIZE(storfsInst);
+        }
+        else
+        {
+            recvDataItr = (count + STORFS_HEADER_TOTAL_SIZE + STORFS_INST_PAGE_SIZE(storfsInst)) / STORFS_INST_PAGE_SIZE(storfsInst);
+        }
+    }
+    else
+    {
+        recvDataItr = (stream->fileRead.fileSizeRem + STORFS_INST_PAGE_SIZE(storfsInst)) / STORFS_INST_PAGE_SIZE(storfsInst);
+        count = stream->fileRead.fileSizeRem;
+    }
+    
+    //If the count is zero, the file has been completely read, warn the user
+    if(count == 0)
+    {        
+        STORFS_LOGW(TAG, "File has been completely read");
+        return STORFS_OK;
+    }
+
+    do
+    {
+        STORFS_LOGD(TAG, "Reading File At %ld%ld, %ld", (uint32_t)(stream->fileRead.readLocPtr.pageLoc >> 32),(uint32_t)(stream->fileRead.readLocPtr.pageLoc),  stream->fileRead.readLocPtr.byteLoc);
+
+        //If the receive string buffer length is greater than a page size ensure the received data will maximally be the page size   
+        if((count + headerLen) > (STORFS_INST_PAGE_SIZE(storfsInst) - stream->fileRead.readLocPtr.byteLoc))
+        {
+            recvDataLen = (STORFS_INST_PAGE_SIZE(storfsInst) - stream->fileRead.readLocPtr.byteLoc);
+            count -= recvDataLen;
+        }
+        else
+        {
+            recvDataLen = count;
+        }
+
+        //Read in the data and store each page size in the buffer
+        if(STORFS_READ(storfsInst, stream->fileRead.readLocPtr.pageLoc, stream->fileRead.readLocPtr.byteLoc, (uint8_t *)str, recvDataLen) != STORFS_OK)
+        {
+            STORFS_LOGE(TAG, "Reading from memory failed in function fgets");
+            return STORFS_READ_FAILED;
+        }
+        if(STORFS_SYNC(storfsInst) != STORFS_OK)
+        {
+            return STORFS_ERROR;
+        }
+
+        recvDataItr--;
+
+        //Decrement read file size remainder
+        stream->fileRead.fileSizeRem -= recvDataLen;
+
+        //If there are fragments...
+        if(recvDataItr > 0)
+        {
+            //Find the next fragments location
+            stream->fileRead.readLocPtr.pageLoc = LOCATION_TO_PAGE(currHeaderInfo.fragmentLocation, storfsInst);
+            stream->fileRead.readLocPtr.byteLoc = 0;
+            STORFS_HEADER_LOAD(storfsInst, &currHeaderInfo, stream->fileRead.readLocPtr, "");
+
+            //The next fragment's data will be after it's header
+            headerLen = STORFS_FRAGMENT_HEADER_TOTAL_SIZE;
+            stream->fileRead.readLocPtr.byteLoc = headerLen;
+
+            //Increment the buffer's location to store data
+            str += recvDataLen * sizeof(uint8_t);
+        }
+    } while (recvDataItr > 0);
+
+    //Ensure the file size remainder does not go below zero
+    if(stream->fileRead.fileSizeRem < 0)
+    {
+        stream->fileRead.fileSizeRem = 0;
+    }  
+    STORFS_LOGD(TAG, "Read File Size Remainder %ld", stream->fileRead.fileSizeRem);
+
+    //Set read pointer byte location
+    stream->fileRead.readLocPtr.byteLoc += recvDataLen;
+
+
+    return STORFS_OK;
+}
+
+storfs_err_t storfs_fread_stream(storfs_t *storfsInst, STORFS_FILE *stream, storfs_consumer_cb_t consumer, void *ctx)
+{
+    storfs_err_t status;
+
+    //Reading a stream does not modify the file system, other readers may run concurrently unless the work buffer is used
+    if(STORFS_LOCK(storfsInst, STORFS_STREAM_LOCK) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+    status = fread_stream_helper(storfsInst, stream, consumer, ctx);
+    STORFS_UNLOCK(storfsInst, STORFS_STREAM_LOCK);
+
+    return status;
+}
+
+static storfs_err_t fread_stream_helper(storfs_t *storfsInst, STORFS_FILE *stream, storfs_consumer_cb_t consumer, void *ctx)
+{
+    if(storfsInst == NULL || stream == NULL || consumer == NULL || stream->fileFlags == STORFS_FILE_DELETED_FLAG)
+    {
+        STORFS_LOGE(TAG, "Cannot read from file, it does not exist");
+        return STORFS_ERROR;
+    }
+    if(stream->fileFlags == STORFS_FILE_WRITE_FLAG || stream->fileFlags == STORFS_FILE_APPEND_FLAG)
+    {
+        STORFS_LOGE(TAG, "Cannot read file, in incorrect mode");
+        return STORFS_ERROR;
+    }
+
+    STORFS_LOGI(TAG, "Streaming file %s", stream->fileInfo.fileName);
+
+#ifdef STORFS_INLINE_FILES
+    //The data of an inline file fits within a single version
+    if(stream->fileInfo.fileInfo & STORFS_INFO_REG_INLINE_BIT)
+    {
+        uint8_t inlineBuf[STORFS_INLINE_FILE_SIZE];
+        storfs_byte_t readStart = stream->fileRead.readLocPtr.byteLoc;
+
+        if(inline_read_helper(storfsInst, (char *)inlineBuf, STORFS_INLINE_FILE_SIZE, stream) != STORFS_OK)
+        {
+            return STORFS_READ_FAILED;
+        }
+        if(stream->fileRead.readLocPtr.byteLoc > readStart)
+        {
+            return consumer(ctx, inlineBuf, stream->fileRead.readLocPtr.byteLoc - readStart);
+        }
+        return STORFS_OK;
+    }
+#endif
+
+    STORFS_WORK_BUF_TAKE(storfsInst, pageBuf, STORFS_INST_PAGE_SIZE(storfsInst));    //Data of the current page passed to the consumer
+    storfs_file_header_t currHeaderInfo;                                            //Header of the page being read
+    uint32_t recvDataLen;                                                           //Length of data read from the current page
+    storfs_err_t status;
+
+    if(STORFS_WORK_BUF_FAILED(pageBuf))
+    {
+        return STORFS_ERROR;
+    }
 
-                //If no siblings, this will be the last file within the directory
-                if(rmChildHeader.siblingLocation == 0x00)
-                {
-                    break;
-                }
-                file_header_store_helper(storfsInst, &rmChildHeader, rmChildFileLoc, "Remove");
+    while(stream->fileRead.fileSizeRem > 0)
+    {
+        //Once the data of the current page has been read, move onto the next fragment
+        if(stream->fileRead.readLocPtr.byteLoc >= STORFS_INST_PAGE_SIZE(storfsInst))
+        {
+            stream->fileRead.readLocPtr.byteLoc = 0;
+            if(file_header_store_helper(storfsInst, &currHeaderInfo, stream->fileRead.readLocPtr, "Stream") != STORFS_OK)
+            {
+                STORFS_WORK_BUF_RETURN(storfsInst, pageBuf, STORFS_READ_FAILED);
+            }
+            if(currHeaderInfo.fragmentLocation == 0x00)
+            {
+                break;
             }
+            stream->fileRead.readLocPtr.pageLoc = LOCATION_TO_PAGE(currHeaderInfo.fragmentLocation, storfsInst);
+            stream->fileRead.readLocPtr.byteLoc = STORFS_FRAGMENT_HEADER_TOTAL_SIZE;
         }
-       
-    return STORFS_OK;
+
+        //Read the rest of the data within the page
+        recvDataLen = STORFS_INST_PAGE_SIZE(storfsInst) - stream->fileRead.readLocPtr.byteLoc;
+        if(recvDataLen > stream->fileRead.fileSizeRem)
+        {
+            recvDataLen = stream->fileRead.fileSizeRem;
+        }
+
+        STORFS_LOGD(TAG, "Streaming File At %ld%ld, %ld", (uint32_t)(stream->fileRead.readLocPtr.pageLoc >> 32),(uint32_t)(stream->fileRead.readLocPtr.pageLoc),  stream->fileRead.readLocPtr.byteLoc);
+        if(STORFS_READ(storfsInst, stream->fileRead.readLocPtr.pageLoc, stream->fileRead.readLocPtr.byteLoc, pageBuf, recvDataLen) != STORFS_OK)
+        {
+            STORFS_LOGE(TAG, "Reading from memory failed in function fread_stream");
+            STORFS_WORK_BUF_RETURN(storfsInst, pageBuf, STORFS_READ_FAILED);
+        }
+        if(STORFS_SYNC(storfsInst) != STORFS_OK)
+        {
+            STORFS_WORK_BUF_RETURN(storfsInst, pageBuf, STORFS_ERROR);
+        }
+
+        stream->fileRead.readLocPtr.byteLoc += recvDataLen;
+        stream->fileRead.fileSizeRem -= recvDataLen;
+
+        //Pass the page's data on straight from the buffer it was read into
+        status = consumer(ctx, pageBuf, recvDataLen);
+        if(status != STORFS_OK)
+        {
+            STORFS_WORK_BUF_RETURN(storfsInst, pageBuf, status);
+        }
+    }
+
+    STORFS_WORK_BUF_RETURN(storfsInst, pageBuf, STORFS_OK);
 }
 
-static storfs_err_t find_prev_file_loc(storfs_t* storfsInst,  storfs_loc_t storfsCurrLoc, storfs_loc_t storfsItrLoc, storfs_loc_t* storfsPrevLoc)
+#ifdef STORFS_FALLOCATE
+storfs_err_t storfs_fallocate(storfs_t *storfsInst, STORFS_FILE *stream, storfs_file_size_t size)
 {
-    storfs_file_header_t prevFileHeader;
-    storfs_loc_t storfsNextChildLoc;
-    storfs_loc_t storfsNextSibLoc;
-    
-    //Store the iterator header and determine if the child or sibling location is equal to the the current location
-    if(file_header_store_helper(storfsInst, &prevFileHeader, storfsItrLoc, "Previous File") != STORFS_OK)
+    storfs_err_t status;
+
+    if(STORFS_WRITE_LOCK(storfsInst) != STORFS_OK)
     {
         return STORFS_ERROR;
     }
-    if( prevFileHeader.childLocation == BYTEPAGE_TO_LOCATION(storfsCurrLoc.byteLoc, storfsCurrLoc.pageLoc, storfsInst) ||
-        prevFileHeader.siblingLocation == BYTEPAGE_TO_LOCATION(storfsCurrLoc.byteLoc, storfsCurrLoc.pageLoc, storfsInst))
+    status = fallocate_helper(storfsInst, stream, size);
+    STORFS_UNLOCK(storfsInst, STORFS_LOCK_EXCLUSIVE);
+
+    return status;
+}
+
+static storfs_err_t fallocate_helper(storfs_t *storfsInst, STORFS_FILE *stream, storfs_file_size_t size)
+{
+    storfs_loc_t fallocLoc;
+    storfs_size_t pageNum = 0;
+    storfs_falloc_t *fallocFile;
+
+    if(storfsInst == NULL || stream == NULL || stream->fileFlags == STORFS_FILE_DELETED_FLAG)
+    {
+        STORFS_LOGE(TAG, "Cannot allocate file, it does not exist");
+        return STORFS_ERROR;
+    }
+    if(!(stream->fileFlags & (STORFS_FILE_WRITE_FLAG | STORFS_FILE_APPEND_FLAG)))
+    {
+        STORFS_LOGE(TAG, "Cannot allocate file, in incorrect mode");
+        return STORFS_ERROR;
+    }
+#ifdef STORFS_INLINE_FILES
+    //Inline files hold no fragments, one about to outgrow its slot is moved onto a page of their own as a write would
+    if(stream->fileInfo.fileInfo & STORFS_INFO_REG_INLINE_BIT)
+    {
+        if(size <= STORFS_INLINE_FILE_SIZE)
+        {
+            return STORFS_OK;
+        }
+        if(inline_promote_helper(storfsInst, stream) != STORFS_OK)
+        {
+            STORFS_LOGE(TAG, "Cannot allocate file, it could not be moved out of its inline slot");
+            return STORFS_ERROR;
+        }
+    }
+#endif
+
+    //Pages previously reserved for the file are given back first
+    falloc_release(storfsInst, stream->fileLoc.pageLoc);
+
+    //Appended data may start a new fragment, while data written from the start first fills the page of the file's header
+    if(stream->fileFlags & STORFS_FILE_APPEND_FLAG)
+    {
+        pageNum = (size + STORFS_INST_PAGE_SIZE(storfsInst) - STORFS_FRAGMENT_HEADER_TOTAL_SIZE - 1) / (STORFS_INST_PAGE_SIZE(storfsInst) - STORFS_FRAGMENT_HEADER_TOTAL_SIZE);
+    }
+    else if((size + STORFS_HEADER_TOTAL_SIZE) > STORFS_INST_PAGE_SIZE(storfsInst))
+    {
+        pageNum = (size - (STORFS_INST_PAGE_SIZE(storfsInst) - STORFS_HEADER_TOTAL_SIZE) + STORFS_INST_PAGE_SIZE(storfsInst) - STORFS_FRAGMENT_HEADER_TOTAL_SIZE - 1) / \
+                    (STORFS_INST_PAGE_SIZE(storfsInst) - STORFS_FRAGMENT_HEADER_TOTAL_SIZE);
+    }
+    if(pageNum == 0)
     {
-        *storfsPrevLoc = storfsItrLoc;
         return STORFS_OK;
     }
+    if(storfsInst->cachedInfo.fallocCount >= STORFS_FALLOCATE_FILES)
+    {
+        STORFS_LOGE(TAG, "Cannot allocate file, the maximum number of files already hold reserved pages");
+        return STORFS_ERROR;
+    }
 
-    //Determine whether the previous file has a child
-    if(prevFileHeader.childLocation != 0x00)
+    //Search for the run from the next open byte so that no free page before it is passed over
+    fallocLoc.pageLoc = LOCATION_TO_PAGE(storfsInst->cachedInfo.nextOpenByte, storfsInst) - 1;
+    fallocLoc.byteLoc = 0;
+    if(extent_alloc_helper(storfsInst, &fallocLoc, pageNum) != STORFS_OK)
     {
-        storfsNextChildLoc.byteLoc = LOCATION_TO_BYTE(prevFileHeader.childLocation, storfsInst);
-        storfsNextChildLoc.pageLoc = LOCATION_TO_PAGE(prevFileHeader.childLocation, storfsInst);
+        STORFS_LOGE(TAG, "Cannot allocate file, no run of %ld free pages was found", (uint32_t)pageNum);
+        return STORFS_ERROR;
+    }
 
-        //If the previous file has a child re-iterate through find_prev_file_loc
-        if(find_prev_file_loc(storfsInst, storfsCurrLoc, storfsNextChildLoc, storfsPrevLoc) != STORFS_OK)
+    fallocFile = &storfsInst->cachedInfo.fallocFiles[storfsInst->cachedInfo.fallocCount++];
+    fallocFile->filePage = stream->fileLoc.pageLoc;
+    fallocFile->page = fallocLoc.pageLoc;
+    fallocFile->pageNum = pageNum;
+
+    //New headers are written at the next open byte without searching, it must not lie within the reserved pages
+    if(falloc_check(storfsInst, LOCATION_TO_PAGE(storfsInst->cachedInfo.nextOpenByte, storfsInst)) != STORFS_OK)
+    {
+        fallocLoc.pageLoc += pageNum - 1;
+        return find_update_next_open_byte(storfsInst, fallocLoc);
+    }
+
+    return STORFS_OK;
+}
+#endif
+
+storfs_err_t storfs_rm(storfs_t *storfsInst, char *pathToFile, STORFS_FILE *stream)
+{
+    storfs_err_t status;
+
+    if(STORFS_WRITE_LOCK(storfsInst) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+    status = rm_helper(storfsInst, pathToFile, stream);
+    STORFS_UNLOCK(storfsInst, STORFS_LOCK_EXCLUSIVE);
+
+    return status;
+}
+
+static storfs_err_t rm_helper(storfs_t *storfsInst, char *pathToFile, STORFS_FILE *stream)
+{
+    //Error Checking
+    if(storfsInst == NULL || pathToFile == NULL)
+    {
+        return STORFS_ERROR;
+    }
+
+    STORFS_FILE rmStream;
+    storfs_file_header_t storfsPreviousHeader;
+    STORFS_LOGI(TAG, "Removing file at %s", pathToFile);
+
+    //Open the file again in order to find the current parent/sibling/children
+    if(file_handling_helper(storfsInst, (storfs_name_t *)pathToFile, FILE_OPEN, &rmStream) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+
+    //If the item to delete is a file or directory
+    if((rmStream.fileInfo.fileInfo & STORFS_INFO_REG_FILE_TYPE_FILE) == STORFS_INFO_REG_FILE_TYPE_FILE)
+    {
+        if(stream != NULL)
         {
-            return STORFS_ERROR;
+            //Set the stream flag to Deleted so it may not be used again until opened/created
+            stream->fileFlags = STORFS_FILE_DELETED_FLAG;
         }
 
-        //If the previously found location is the same as the 
-        if(BYTEPAGE_TO_LOCATION(storfsPrevLoc->byteLoc, storfsPrevLoc->pageLoc, storfsInst) == BYTEPAGE_TO_LOCATION(storfsCurrLoc.byteLoc, storfsCurrLoc.pageLoc, storfsInst))
+        if(file_delete_helper(storfsInst, rmStream.fileLoc, &rmStream.fileInfo, 1) != STORFS_OK)
         {
-            return STORFS_OK;
+            return STORFS_ERROR;
         }
+
+    }
+    else
+    {
+       if(directory_delete_helper(storfsInst, rmStream.fileLoc, &rmStream.fileInfo) != STORFS_OK)
+       {
+           return STORFS_ERROR;
+       }
     }
+    
+    
+    //Store the previous header and manipulate it
+    file_header_store_helper(storfsInst, &storfsPreviousHeader, rmStream.filePrevLoc, "Previous");
 
-    //Determine whether the previous file has a sibling
-    if(prevFileHeader.siblingLocation != 0x00)
+    //Update the child or sibling directory of the previous file location
+    if(STORFS_BLOCK_PAGES(storfsInst) > 1)
     {
-        //If the current header has a sibling location, continuously iterate through the siblings until the wanted location is found or not
-        while(prevFileHeader.siblingLocation != 0x00)
+        //On devices erased in blocks the previous file's page cannot be erased on its own, it is moved to link past the removed file
+        wear_level_t wearLevelInfo;
+        storfs_loc_t siblingLoc;
+        siblingLoc.pageLoc = LOCATION_TO_PAGE(rmStream.fileInfo.siblingLocation, storfsInst);
+        siblingLoc.byteLoc = LOCATION_TO_BYTE(rmStream.fileInfo.siblingLocation, storfsInst);
+        wearLevelInfo.storfsInfo = rmStream.fileInfo;
+        wearLevelInfo.storfsInfoLoc = rmStream.fileLoc;
+        wearLevelInfo.storfsOrigLoc = rmStream.fileLoc;
+        wearLevelInfo.storfsCurrLoc = &siblingLoc;
+        wearLevelInfo.storfsPrevLoc = rmStream.filePrevLoc;
+        wearLevelInfo.storfsFlags = rmStream.filePrevFlags;
+        if(link_update_helper(storfsInst, &wearLevelInfo) != STORFS_OK || update_root(storfsInst) != STORFS_OK)
         {
-            storfsNextSibLoc.byteLoc = LOCATION_TO_BYTE(prevFileHeader.siblingLocation, storfsInst);
-            storfsNextSibLoc.pageLoc = LOCATION_TO_PAGE(prevFileHeader.siblingLocation, storfsInst);
-            if(file_header_store_helper(storfsInst, &prevFileHeader, storfsNextSibLoc, "Previous File") != STORFS_OK)
+            return STORFS_ERROR;
+        }
+    }
+    else if(rmStream.filePrevLoc.pageLoc == storfsInst->firstPageLoc)
+    {
+        storfsInst->cachedInfo.rootHeaderInfo[0].childLocation = rmStream.fileInfo.siblingLocation;
+        storfsInst->cachedInfo.rootHeaderInfo[1].childLocation = rmStream.fileInfo.siblingLocation;
+    }
+    else if(rmStream.filePrevFlags == STORFS_FILE_PARENT_FLAG)
+    {
+        storfsPreviousHeader.childLocation = rmStream.fileInfo.siblingLocation;
+#ifdef STORFS_METADATA_PACK
+        //Keep the other headers packed within the parent's page
+        if(meta_header_rewrite(storfsInst, &storfsPreviousHeader, rmStream.filePrevLoc) != STORFS_OK)
+        {
+            return STORFS_ERROR;
+        }
+#else
+        //Remove the header from storage so it may be re-written
+        if(STORFS_ERASE(storfsInst, rmStream.filePrevLoc.pageLoc) != STORFS_OK)
+        {
+            return STORFS_ERROR;
+        }
+        if(file_header_create_helper(storfsInst, &storfsPreviousHeader, rmStream.filePrevLoc, "") != STORFS_OK)
+        {
+            return STORFS_ERROR;
+        }
+#endif
+    }
+    else
+    {
+        //If the current file being deleted has a sibling, update the previous register's sibling with the current registers sibling
+        storfsPreviousHeader.siblingLocation = rmStream.fileInfo.siblingLocation;
+
+         //If the previous file is a directory simply update the header, if not read in the data of the original file page and update the page with a new header
+        if(STORFS_HEADER_PACKED(storfsPreviousHeader.fileInfo))
+        {
+#ifdef STORFS_METADATA_PACK
+            //Keep the other headers packed within the previous header's page
+            if(meta_header_rewrite(storfsInst, &storfsPreviousHeader, rmStream.filePrevLoc) != STORFS_OK)
+            {
+                return STORFS_ERROR;
+            }
+#else
+            //Remove the header from storage so it may be re-written
+            if(STORFS_ERASE(storfsInst, rmStream.filePrevLoc.pageLoc) != STORFS_OK)
+            {
+                return STORFS_ERROR;
+            }
+            if(file_header_create_helper(storfsInst, &storfsPreviousHeader, rmStream.filePrevLoc, "") != STORFS_OK)
+            {
+                return STORFS_ERROR;
+            }
+#endif
+        }
+        else
+        {
+            STORFS_WORK_BUF_TAKE(storfsInst, siblingBuf, STORFS_INST_PAGE_SIZE(storfsInst));
+            if(STORFS_WORK_BUF_FAILED(siblingBuf))
             {
                 return STORFS_ERROR;
             }
 
-            //If either the child location of the sibling location is equivalent to the wanted location, place that
-            if( prevFileHeader.childLocation == BYTEPAGE_TO_LOCATION(storfsCurrLoc.byteLoc, storfsCurrLoc.pageLoc, storfsInst) ||
-                prevFileHeader.siblingLocation == BYTEPAGE_TO_LOCATION(storfsCurrLoc.byteLoc, storfsCurrLoc.pageLoc, storfsInst))
+            STORFS_LOGD(TAG, "Updating Previous File Sibling Location at the file's initial location at %ld%ld, %d", (uint32_t)(rmStream.filePrevLoc.pageLoc >> 32), (uint32_t)(rmStream.filePrevLoc.pageLoc), 0);
+
+            if(STORFS_READ(storfsInst, rmStream.filePrevLoc.pageLoc, STORFS_HEADER_TOTAL_SIZE, (siblingBuf + STORFS_HEADER_TOTAL_SIZE), (STORFS_INST_PAGE_SIZE(storfsInst) - STORFS_HEADER_TOTAL_SIZE)) != STORFS_OK)
             {
-                *storfsPrevLoc = storfsNextSibLoc;
-                return STORFS_OK;
+                STORFS_WORK_BUF_RETURN(storfsInst, siblingBuf, STORFS_READ_FAILED);
             }
 
-            //If there is a child location, iterate through it with the prev_file_loc function
-            if(prevFileHeader.childLocation != 0x00)
+            //Remove the header from storage so it may be re-written
+            if(STORFS_ERASE(storfsInst, rmStream.filePrevLoc.pageLoc) != STORFS_OK)
             {
-                storfsNextChildLoc.byteLoc = LOCATION_TO_BYTE(prevFileHeader.childLocation, storfsInst);
-                storfsNextChildLoc.pageLoc = LOCATION_TO_PAGE(prevFileHeader.childLocation, storfsInst);
-                if(find_prev_file_loc(storfsInst, storfsCurrLoc, storfsNextChildLoc, storfsPrevLoc) != STORFS_OK)
-                {
-                    return STORFS_ERROR;
-                }
-                if(BYTEPAGE_TO_LOCATION(storfsPrevLoc->byteLoc, storfsPrevLoc->pageLoc, storfsInst) == BYTEPAGE_TO_LOCATION(storfsCurrLoc.byteLoc, storfsCurrLoc.pageLoc, storfsInst))
-                {
-                    return STORFS_OK;
-                }
+                STORFS_WORK_BUF_RETURN(storfsInst, siblingBuf, STORFS_ERROR);
+            }
+
+            //The previous file's data is kept after its updated header
+            info_to_buf(siblingBuf, &storfsPreviousHeader);
+            if(STORFS_WRITE(storfsInst, rmStream.filePrevLoc.pageLoc, 0, siblingBuf, STORFS_INST_PAGE_SIZE(storfsInst)) != STORFS_OK)
+            {
+                STORFS_WORK_BUF_RETURN(storfsInst, siblingBuf, STORFS_WRITE_FAILED);
             }
+            STORFS_WORK_BUF_GIVE(storfsInst, siblingBuf);
+        }
+    }
+
+#ifdef STORFS_METADATA_PACK
+    //The page of a removed header is only written to again once none of the headers packed within it remain
+    if(meta_page_live(storfsInst, rmStream.fileLoc.pageLoc, NULL, 0) == STORFS_OK)
+    {
+        return STORFS_OK;
+    }
+    rmStream.fileLoc.byteLoc = 0;
+#endif
+
+#ifdef STORFS_LAZY_DELETE
+    //The next open byte is written to without being checked, erase the removed header's page if it becomes the next open byte
+    //On devices erased in blocks the next open byte is left in place while the rest of the page's block holds data
+    if(storfsInst->cachedInfo.nextOpenByte >= BYTEPAGE_TO_LOCATION(rmStream.fileLoc.byteLoc, rmStream.fileLoc.pageLoc, storfsInst))
+    {
+        if(block_reclaim_check(storfsInst, rmStream.fileLoc.pageLoc) != STORFS_OK)
+        {
+            return STORFS_OK;
+        }
+        if(STORFS_ERASE(storfsInst, rmStream.fileLoc.pageLoc) != STORFS_OK)
+        {
+            return STORFS_ERROR;
         }
     }
+#endif
+
+    //Update the next open byte to the file that was deleted if the next open byte is currently larger than the files location
+    if(storfsInst->cachedInfo.nextOpenByte >= BYTEPAGE_TO_LOCATION(rmStream.fileLoc.byteLoc, rmStream.fileLoc.pageLoc, storfsInst) &&
+        STORFS_ASYNC_ERASE_CHECK(storfsInst, rmStream.fileLoc.pageLoc) == STORFS_OK)
+    {
+        update_root_next_open_byte(storfsInst, BYTEPAGE_TO_LOCATION(rmStream.fileLoc.byteLoc, rmStream.fileLoc.pageLoc, storfsInst));
+    }
+    
+    return STORFS_OK;
+}
+
+storfs_err_t storfs_rewind(storfs_t *storfsInst, STORFS_FILE *stream)
+{
+    if(storfsInst == NULL || stream == NULL || stream->fileFlags == STORFS_FILE_DELETED_FLAG)
+    {
+        STORFS_LOGE(TAG, "Error in opening the current file stream");
+        return STORFS_ERROR;
+    }
+
+    STORFS_LOGI(TAG, "Rewinding file %s to original location", stream->fileInfo.fileName);
+
+    //Set read pointer location
+    stream->fileRead.readLocPtr.pageLoc = stream->fileLoc.pageLoc;
+    stream->fileRead.readLocPtr.byteLoc = STORFS_HEADER_TOTAL_SIZE;
+    //Set read file size remainder, the stored size adds a fragment header for every full fragment of data written
+    //A fragment of data and its header fill a page, so the headers added are the whole pages past the file's header
+    stream->fileRead.fileSizeRem = stream->fileInfo.fileSize - STORFS_HEADER_TOTAL_SIZE -
+        ((stream->fileInfo.fileSize - STORFS_HEADER_TOTAL_SIZE) / STORFS_INST_PAGE_SIZE(storfsInst) * STORFS_FRAGMENT_HEADER_TOTAL_SIZE);
+
+    STORFS_LOGD(TAG, "File size remainder %ld", stream->fileRead.fileSizeRem);
+
+    //Set rewind flag
+    stream->fileFlags |= STORFS_FILE_REWIND_FLAG;
 
     return STORFS_OK;
 }
 
-storfs_err_t wear_level_act(storfs_t* storfsInst, wear_level_t *wearLevelInfo)
+storfs_err_t storfs_fclose(storfs_t *storfsInst, STORFS_FILE *stream)
 {
-    uint8_t relocateBuf[storfsInst->pageSize];
-    wear_level_t prevWearLevelInfo;
+    storfs_err_t status;
 
-    //Store the previous header, determine if it was a fragment header or a file/directory/root header
-    file_header_store_helper(storfsInst, &prevWearLevelInfo.storfsInfo, wearLevelInfo->storfsPrevLoc, "Previous File");
+    if(STORFS_LOCK(storfsInst, STORFS_LOCK_EXCLUSIVE) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+    status = fclose_helper(storfsInst, stream);
+    STORFS_UNLOCK(storfsInst, STORFS_LOCK_EXCLUSIVE);
 
-    //If the previous file information is a file, the root or a directory... else if it is a fragment
-    if((prevWearLevelInfo.storfsInfo.fileInfo & STORFS_INFO_REG_FILE_TYPE_FILE) == STORFS_INFO_REG_FILE_TYPE_FILE || 
-        (prevWearLevelInfo.storfsInfo.fileInfo & STORFS_INFO_REG_FILE_TYPE_FILE) == STORFS_INFO_REG_FILE_TYPE_ROOT || 
-        (prevWearLevelInfo.storfsInfo.fileInfo & STORFS_INFO_REG_FILE_TYPE_FILE) == STORFS_INFO_REG_FILE_TYPE_DIRECTORY)
+    return status;
+}
+
+static storfs_err_t fclose_helper(storfs_t *storfsInst, STORFS_FILE *stream)
+{
+    if(storfsInst == NULL || stream == NULL)
     {
-        //Determine the parent/sibling location of the previous file in order to prepare it for another iteration of wear-level writing
-        if(find_prev_file_loc(storfsInst, wearLevelInfo->storfsPrevLoc, storfsInst->cachedInfo.rootLocation[0], &prevWearLevelInfo.storfsPrevLoc) != STORFS_OK)
-        {
-            LOGE(TAG, "Error determining the previous file's parent/sibling location");
-            return STORFS_ERROR;
-        }
+        STORFS_LOGE(TAG, "Error in closing the current file stream");
+        return STORFS_ERROR;
+    }
 
-        //The header info location will be the same as the previous location
-        prevWearLevelInfo.storfsInfoLoc = prevWearLevelInfo.storfsPrevLoc;
-        
-        //Set the previous header length
-        prevWearLevelInfo.headerLen = STORFS_HEADER_TOTAL_SIZE;
+    STORFS_LOGI(TAG, "Closing file %s", stream->fileInfo.fileName);
 
-        //Set the page size that must be re-written
-        if(prevWearLevelInfo.storfsInfo.fileSize > storfsInst->pageSize)
+#ifdef STORFS_OPEN_FILE_TABLE
+    //Give back the entries holding the stream's header and the header of the page it was reading
+    for(int i = 0; i < STORFS_OPEN_FILES; i++)
+    {
+        storfs_open_file_t *openFile = &storfsInst->cachedInfo.openFiles[i];
+        if((openFile->location.pageLoc == stream->fileLoc.pageLoc && openFile->location.byteLoc == stream->fileLoc.byteLoc) ||
+            (openFile->location.pageLoc == stream->fileRead.readLocPtr.pageLoc && openFile->location.byteLoc == 0))
         {
-            prevWearLevelInfo.sendDataLen  = storfsInst->pageSize;
+            openFile->valid = 0;
         }
-        else
+    }
+#endif
+
+    return STORFS_OK;
+}
+
+#ifdef STORFS_OPEN_FILE_TABLE
+static storfs_err_t open_file_load(storfs_t *storfsInst, storfs_file_header_t *storfsInfo, storfs_loc_t storfsLoc, const char *fileType)
+{
+    //A header held within the table still matches the storage device, as its page has not been changed since
+    for(int i = 0; i < STORFS_OPEN_FILES; i++)
+    {
+        storfs_open_file_t *openFile = &storfsInst->cachedInfo.openFiles[i];
+        if(openFile->valid && openFile->location.pageLoc == storfsLoc.pageLoc && openFile->location.byteLoc == storfsLoc.byteLoc)
         {
-            prevWearLevelInfo.sendDataLen  = prevWearLevelInfo.storfsInfo.fileSize;
+            *storfsInfo = openFile->info;
+            return STORFS_OK;
         }
+    }
 
-        //Determine if the child location or sibling location must be re-written
-        if(prevWearLevelInfo.storfsInfo.childLocation == BYTEPAGE_TO_LOCATION(wearLevelInfo->storfsOrigLoc.byteLoc, wearLevelInfo->storfsOrigLoc.pageLoc, storfsInst) ||
-            wearLevelInfo->storfsFlags & STORFS_FILE_PARENT_FLAG)
+    if(file_header_store_helper(storfsInst, storfsInfo, storfsLoc, fileType) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+    open_file_hold(storfsInst, storfsLoc, storfsInfo);
+
+    return STORFS_OK;
+}
+
+static void open_file_hold(storfs_t *storfsInst, storfs_loc_t storfsLoc, const storfs_file_header_t *storfsInfo)
+{
+    storfs_open_file_t *openFile = NULL;
+
+    //The entry already holding the location is updated, otherwise a free entry is taken
+    for(int i = 0; i < STORFS_OPEN_FILES; i++)
+    {
+        storfs_open_file_t *entry = &storfsInst->cachedInfo.openFiles[i];
+        if(entry->valid && entry->location.pageLoc == storfsLoc.pageLoc && entry->location.byteLoc == storfsLoc.byteLoc)
         {
-            STORFS_LOGI(TAG, "Updating previous file child location");
-            prevWearLevelInfo.storfsInfo.childLocation = BYTEPAGE_TO_LOCATION(wearLevelInfo->storfsCurrLoc->byteLoc, wearLevelInfo->storfsCurrLoc->pageLoc, storfsInst);
+            openFile = entry;
+            break;
         }
-        else if(prevWearLevelInfo.storfsInfo.siblingLocation == BYTEPAGE_TO_LOCATION(wearLevelInfo->storfsOrigLoc.byteLoc, wearLevelInfo->storfsOrigLoc.pageLoc, storfsInst) ||
-                wearLevelInfo->storfsFlags & STORFS_FILE_SIBLING_FLAG)
+        if(!entry->valid && openFile == NULL)
         {
-            STORFS_LOGI(TAG, "Updating previous file sibling location");
-            prevWearLevelInfo.storfsInfo.siblingLocation = BYTEPAGE_TO_LOCATION(wearLevelInfo->storfsCurrLoc->byteLoc, wearLevelInfo->storfsCurrLoc->pageLoc, storfsInst);
+            openFile = entry;
         }
     }
-    else
+
+    //Once the table is full its entries are replaced in turn
+    if(openFile == NULL)
     {
-        storfs_file_header_t tempHeader = wearLevelInfo->storfsInfo;
+        openFile = &storfsInst->cachedInfo.openFiles[storfsInst->cachedInfo.openFileNext];
+        storfsInst->cachedInfo.openFileNext = (storfsInst->cachedInfo.openFileNext + 1) % STORFS_OPEN_FILES;
+    }
+    openFile->location = storfsLoc;
+    openFile->info = *storfsInfo;
+    openFile->valid = 1;
+}
 
-        //If the current head file header's fragment location is equal to the previous files fragment location
-        if(tempHeader.fragmentLocation == BYTEPAGE_TO_LOCATION(wearLevelInfo->storfsPrevLoc.byteLoc, wearLevelInfo->storfsPrevLoc.pageLoc, storfsInst))
+static storfs_page_t open_file_touch(storfs_t *storfsInst, storfs_page_t page)
+{
+    //Drop the headers held of the page about to be programmed or erased
+    for(int i = 0; i < STORFS_OPEN_FILES; i++)
+    {
+        if(storfsInst->cachedInfo.openFiles[i].location.pageLoc == page)
         {
-            //The previous location will be equivalent to the main header's location
-            prevWearLevelInfo.storfsPrevLoc = wearLevelInfo->storfsInfoLoc;
+            storfsInst->cachedInfo.openFiles[i].valid = 0;
         }
-        else
-        {
-            //Iterate through fragment header locations until the previous fragment header is found
-            while(tempHeader.fragmentLocation != BYTEPAGE_TO_LOCATION(wearLevelInfo->storfsPrevLoc.byteLoc, wearLevelInfo->storfsPrevLoc.pageLoc, storfsInst))
-            {
-                prevWearLevelInfo.storfsPrevLoc.pageLoc = LOCATION_TO_PAGE(tempHeader.fragmentLocation, storfsInst);
-                prevWearLevelInfo.storfsPrevLoc.byteLoc = LOCATION_TO_BYTE(tempHeader.fragmentLocation, storfsInst);
+    }
 
-                //Update the prevWearLevel header information while iterating
-                file_header_store_helper(storfsInst, &tempHeader, prevWearLevelInfo.storfsPrevLoc, "Previous Fragment");
-            }
-        }
+    return page;
+}
+#endif
 
-        STORFS_LOGI(TAG, "Updating previous file fragment location");
+#ifdef STORFS_JOURNAL
+storfs_err_t storfs_checkpoint(storfs_t *storfsInst)
+{
+    storfs_err_t status;
 
-        //Set the previous header length to be a fragment header length
-        prevWearLevelInfo.headerLen = STORFS_FRAGMENT_HEADER_TOTAL_SIZE;
+    if(storfsInst == NULL)
+    {
+        return STORFS_ERROR;
+    }
 
-        //Set the previous header's info location to the original
-        prevWearLevelInfo.storfsInfoLoc = wearLevelInfo->storfsInfoLoc;
+    STORFS_LOGI(TAG, "Checkpointing the journal");
 
-        //Set the page size that must be re-written, must be a full page if there is a fragment
-        prevWearLevelInfo.sendDataLen  = storfsInst->pageSize;
+    if(STORFS_WRITE_LOCK(storfsInst) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+    status = journal_checkpoint(storfsInst);
+    STORFS_UNLOCK(storfsInst, STORFS_LOCK_EXCLUSIVE);
 
-        //Update the fragment location
-        prevWearLevelInfo.storfsInfo.fragmentLocation = BYTEPAGE_TO_LOCATION(wearLevelInfo->storfsCurrLoc->byteLoc, wearLevelInfo->storfsCurrLoc->pageLoc, storfsInst);
+    return status;
+}
+
+storfs_err_t storfs_begin(storfs_t *storfsInst)
+{
+    storfs_err_t status = STORFS_OK;
+
+    if(storfsInst == NULL || STORFS_WRITE_LOCK(storfsInst) != STORFS_OK)
+    {
+        return STORFS_ERROR;
     }
 
-    //Determine if the previous file is a directory or the root and ensure that the correct flag is applied to the next iteration
-    if((prevWearLevelInfo.storfsInfo.fileInfo & STORFS_INFO_REG_FILE_TYPE_FILE) == STORFS_INFO_REG_FILE_TYPE_DIRECTORY || 
-    (prevWearLevelInfo.storfsInfo.fileInfo & STORFS_INFO_REG_FILE_TYPE_FILE) == STORFS_INFO_REG_FILE_TYPE_ROOT || 
-    (((prevWearLevelInfo.storfsInfo.fileInfo & STORFS_INFO_REG_FILE_TYPE_FILE) == STORFS_INFO_REG_FILE_TYPE_FILE) && (prevWearLevelInfo.sendDataLen == STORFS_HEADER_TOTAL_SIZE)))
+    if(storfsInst->cachedInfo.journalTransaction)
     {
-        prevWearLevelInfo.storfsFlags = STORFS_FILE_HEADER_WRITE;
+        STORFS_LOGE(TAG, "Cannot begin a transaction");
+        status = STORFS_ERROR;
     }
     else
     {
-        prevWearLevelInfo.storfsFlags = STORFS_FILE_WRITE_FLAG;
+        STORFS_LOGI(TAG, "Beginning transaction");
+
+        //Write the updates held before the transaction into the tree, leaving the whole journal to the transaction
+        if(storfsInst->cachedInfo.journalCount > 0 || storfsInst->cachedInfo.journalHead.pageLoc != storfsInst->cachedInfo.journalLocation || \
+            storfsInst->cachedInfo.journalHead.byteLoc != 0)
+        {
+            status = journal_checkpoint(storfsInst);
+        }
+        if(status == STORFS_OK)
+        {
+            storfsInst->cachedInfo.journalTransaction = 1;
+        }
     }
+    STORFS_UNLOCK(storfsInst, STORFS_LOCK_EXCLUSIVE);
 
-    STORFS_LOGI(TAG, "Previous file's, previous file location %ld%ld", (uint32_t)(BYTEPAGE_TO_LOCATION(prevWearLevelInfo.storfsPrevLoc.byteLoc, prevWearLevelInfo.storfsPrevLoc.pageLoc, storfsInst) >> 32), (uint32_t)(BYTEPAGE_TO_LOCATION(prevWearLevelInfo.storfsPrevLoc.byteLoc, prevWearLevelInfo.storfsPrevLoc.pageLoc, storfsInst)));
-    
-    //Convert the header to a buffer, read the previous file, erase it and write the new information to it
-    file_info_display_helper(prevWearLevelInfo.storfsInfo);
-    info_to_buf(relocateBuf, &prevWearLevelInfo.storfsInfo);
-    if(storfsInst->read(storfsInst,wearLevelInfo->storfsPrevLoc.pageLoc, prevWearLevelInfo.headerLen, (relocateBuf + prevWearLevelInfo.headerLen), (storfsInst->pageSize - prevWearLevelInfo.headerLen)) != STORFS_OK)
+    return status;
+}
+
+storfs_err_t storfs_commit(storfs_t *storfsInst)
+{
+    storfs_err_t status;
+
+    if(storfsInst == NULL || STORFS_WRITE_LOCK(storfsInst) != STORFS_OK)
     {
-        return STORFS_READ_FAILED;
+        return STORFS_ERROR;
     }
-    if(storfsInst->erase(storfsInst, wearLevelInfo->storfsPrevLoc.pageLoc) != STORFS_OK)
+    status = commit_helper(storfsInst);
+    STORFS_UNLOCK(storfsInst, STORFS_LOCK_EXCLUSIVE);
+
+    return status;
+}
+
+static storfs_err_t commit_helper(storfs_t *storfsInst)
+{
+    storfs_journal_entry_t *entries;
+
+    if(!storfsInst->cachedInfo.journalTransaction)
     {
+        STORFS_LOGE(TAG, "No transaction to commit");
         return STORFS_ERROR;
     }
-    
-    //Write to the previous wear struct the previous files information
-    prevWearLevelInfo.sendBuf = relocateBuf;
-    prevWearLevelInfo.storfsCurrLoc = &wearLevelInfo->storfsPrevLoc;
-    prevWearLevelInfo.storfsOrigLoc = wearLevelInfo->storfsPrevLoc;
 
-    //Write the previous file and header
-    write_wear_level_helper(storfsInst, &prevWearLevelInfo);
+    STORFS_LOGI(TAG, "Committing transaction");
+    storfsInst->cachedInfo.journalTransaction = 0;
+    entries = storfsInst->cachedInfo.journalEntries;
+
+    //Append every cached link update followed by the root, the journal was kept with room for them during the transaction
+    for(int j = 0; j < storfsInst->cachedInfo.journalCount; j++)
+    {
+        if(journal_append(storfsInst, entries[j].type, entries[j].location, entries[j].value) != STORFS_OK)
+        {
+            return STORFS_ERROR;
+        }
+    }
+
+    return journal_append(storfsInst, STORFS_JOURNAL_ROOT, storfsInst->cachedInfo.rootHeaderInfo[0].childLocation, \
+                            storfsInst->cachedInfo.rootHeaderInfo[0].fragmentLocation);
+}
+#endif
+
+#ifdef STORFS_IDLE
+#ifdef STORFS_LAZY_DELETE
+static storfs_err_t idle_erase_defer(storfs_t *storfsInst, storfs_page_t page)
+{
+    //If no more pages may be held, the page is already marked invalid and will be erased once it is allocated again
+    if(storfsInst->cachedInfo.idleEraseCount >= STORFS_IDLE_ERASE_PAGES)
+    {
+        return STORFS_OK;
+    }
+
+    STORFS_LOGD(TAG, "Deferring erase of page %ld%ld", (uint32_t)(page >> 32), (uint32_t)(page));
+    storfsInst->cachedInfo.idleErasePages[storfsInst->cachedInfo.idleEraseCount++] = page;
 
     return STORFS_OK;
 }
+#endif
 
-static storfs_err_t write_wear_level_helper(storfs_t* storfsInst, wear_level_t *wearLevelInfo)
+storfs_err_t storfs_idle(storfs_t *storfsInst, uint32_t budgetUs)
 {
-    wear_level_state_t state = WRITE_BAD;
-    uint8_t itr = 0;
+    storfs_err_t status = STORFS_OK;
+    uint32_t startUs = 0;
+#ifdef STORFS_LAZY_DELETE
+    storfs_page_t page;
+#endif
 
-    //Write to the area in memory and then check the crc and determine if that page in memory is worn/not usable
-    while(1)
+    if(storfsInst == NULL || STORFS_WRITE_LOCK(storfsInst) != STORFS_OK)
     {
-        STORFS_LOGD(TAG, "Writing File At %ld%ld, %ld", (uint32_t)(wearLevelInfo->storfsCurrLoc->pageLoc >> 32),(uint32_t)(wearLevelInfo->storfsCurrLoc->pageLoc), wearLevelInfo->storfsCurrLoc->byteLoc);
+        return STORFS_ERROR;
+    }
 
-        //Retry write if failed to the page a certain amount of times based on user defined value
-        for(int i = 0; i < STORFS_WEAR_LEVEL_RETRY_NUM; i++)
+    if(storfsInst->time != NULL)
+    {
+        startUs = storfsInst->time(storfsInst);
+    }
+
+    while(status == STORFS_OK)
+    {
+#ifdef STORFS_LAZY_DELETE
+        if(storfsInst->cachedInfo.idleEraseCount > 0)
         {
-            if(i > 0)
-            {
-                STORFS_LOGW(TAG, "Failed to write to location, re-writting to location");
-            }
-            
-            //If the programming functionality fails return an error
-            if(storfsInst->write(storfsInst, wearLevelInfo->storfsCurrLoc->pageLoc, wearLevelInfo->storfsCurrLoc->byteLoc, wearLevelInfo->sendBuf, wearLevelInfo->sendDataLen) != STORFS_OK)
+            //Erase the most recently freed page
+            page = storfsInst->cachedInfo.idleErasePages[--storfsInst->cachedInfo.idleEraseCount];
+
+            //The page may have already been erased and allocated again, on devices erased in blocks it is left while its block holds data
+            uint8_t infoReg;
+            status = STORFS_READ(storfsInst, page, 0, &infoReg, STORFS_INFO_REG_SIZE);
+            if(status != STORFS_OK || !STORFS_PAGE_INVALID(storfsInst, page, &infoReg, STORFS_INFO_REG_SIZE) ||
+                block_reclaim_check(storfsInst, page) != STORFS_OK)
             {
-                STORFS_LOGE(TAG, "Writing to memory failed in function fputs");
-                return STORFS_WRITE_FAILED;
+                continue;
             }
-            if(storfsInst->sync(storfsInst) != STORFS_OK)
+            STORFS_LOGD(TAG, "Erasing freed page %ld%ld", (uint32_t)(page >> 32), (uint32_t)(page));
+            status = STORFS_ERASE(storfsInst, page);
+
+            //Allow the page to be written to again
+            if(status == STORFS_OK && storfsInst->cachedInfo.nextOpenByte > BYTEPAGE_TO_LOCATION(0, page, storfsInst))
             {
-                return STORFS_ERROR;
+                status = update_root_next_open_byte(storfsInst, BYTEPAGE_TO_LOCATION(0, page, storfsInst));
             }
-            if(wearLevelInfo->storfsFlags & STORFS_FILE_INIT_HEADER_WRITE || 
-                wearLevelInfo->storfsFlags & STORFS_FILE_HEADER_WRITE)
+#ifdef STORFS_ERASE_POOL
+            else if(status == STORFS_OK)
             {
-                //If CRC returned correctly, break
-                if(crc_header_check(storfsInst, *wearLevelInfo->storfsCurrLoc) == STORFS_OK)
-                {
-                    if(itr == 0)
-                    {
-                        state = WRITE_GOOD;
-                    }
-                    else
-                    {
-                        state = WRITE_RELOCATE;
-                    }
-                    break;
-                }
+                erase_pool_add(storfsInst, page);
             }
-            else
-            {
-                if(crc_file_check(storfsInst, *wearLevelInfo->storfsCurrLoc, (wearLevelInfo->sendDataLen - wearLevelInfo->headerLen)) == STORFS_OK)
-                {
-                    if(itr == 0)
-                    {
-                        state = WRITE_GOOD;
-                    }
-                    else
-                    {
-                        state = WRITE_RELOCATE;
-                    }
-                    break;
-                }
-            } 
-            if(storfsInst->erase(storfsInst, wearLevelInfo->storfsCurrLoc->pageLoc) != STORFS_OK)
-            {
-                LOGE(TAG, "Could not erase page in wear-level function");
-                return STORFS_ERROR;
-            }           
+#endif
+        }
+        else
+#endif
+#ifdef STORFS_JOURNAL
+        if(storfsInst->cachedInfo.journalCount > 0 && !storfsInst->cachedInfo.journalTransaction)
+        {
+            //Write the cached link updates into the tree so later checkpoints do not stall a user call
+            status = journal_checkpoint(storfsInst);
+        }
+        else
+#endif
+#ifdef STORFS_ERASE_POOL
+        if(erase_pool_fill(storfsInst, 1) == STORFS_OK)
+        {
+            //Pages ahead of the next open byte are erased so they may be allocated without an erase
+            STORFS_LOGD(TAG, "Erased page pool holds %d pages", storfsInst->cachedInfo.erasePoolCount);
+        }
+        else
+#endif
+        {
+            break;
         }
 
-        //If written successful, continue
-        if(state == WRITE_GOOD || state == WRITE_RELOCATE)
+        //Without a time source a single piece of work is performed
+        if(storfsInst->time == NULL || (uint32_t)(storfsInst->time(storfsInst) - startUs) >= budgetUs)
         {
             break;
         }
+    }
 
-        //If CRC returns incorrectly, find another location to write to
-        find_next_open_byte_helper(storfsInst, wearLevelInfo->storfsCurrLoc);
+    STORFS_UNLOCK(storfsInst, STORFS_LOCK_EXCLUSIVE);
 
-        //If this is a file being written to, it is the first write and the send data length is greater than a page size, the fragment location must be updated as well
-        if(wearLevelInfo->storfsFlags & STORFS_FILE_WRITE_FLAG && 
-            wearLevelInfo->storfsFlags & STORFS_FILE_WRITE_INIT_FLAG &&
-            wearLevelInfo->sendDataLen >= storfsInst->pageSize)
+    return status;
+}
+#endif
+
+#ifdef STORFS_ERASE_POOL
+static storfs_err_t erase_pool_fill(storfs_t *storfsInst, uint8_t eraseInvalid)
+{
+    STORFS_WORK_BUF_TAKE(storfsInst, pageBuf, STORFS_INST_PAGE_SIZE(storfsInst));
+    storfs_page_t page;
+    uint32_t i;
+    if(STORFS_WORK_BUF_FAILED(pageBuf))
+    {
+        return STORFS_ERROR;
+    }
+
+    //Check the pages following the next open byte until one is found that is erased, or may be erased
+    while(storfsInst->cachedInfo.erasePoolCount < STORFS_ERASE_POOL_PAGES && 
+            storfsInst->cachedInfo.erasePoolScan < STORFS_LOGICAL_PAGE_COUNT(storfsInst))
+    {
+        page = storfsInst->cachedInfo.erasePoolScan++;
+
+        //The next open byte is written to without being allocated, it may not be held within the pool
+        if(page <= LOCATION_TO_PAGE(storfsInst->cachedInfo.nextOpenByte, storfsInst))
+        {
+            continue;
+        }
+#ifdef STORFS_BAD_BLOCK_TABLE
+        if(bad_block_check(storfsInst, page) != STORFS_OK)
+        {
+            continue;
+        }
+#endif
+#ifdef STORFS_FALLOCATE
+        //Pages reserved for a file must not be handed out by the pool
+        if(falloc_check(storfsInst, page) != STORFS_OK)
+        {
+            continue;
+        }
+#endif
+        if(STORFS_READ(storfsInst, page, 0, pageBuf, STORFS_INST_PAGE_SIZE(storfsInst)) != STORFS_OK)
         {
-            storfs_loc_t nextFragmentLoc = *wearLevelInfo->storfsCurrLoc;
-            storfs_file_header_t currInfo;
-            
-            find_next_open_byte_helper(storfsInst, &nextFragmentLoc);
-            buf_to_info(wearLevelInfo->sendBuf, &currInfo);
-            currInfo.fragmentLocation = BYTEPAGE_TO_LOCATION(nextFragmentLoc.byteLoc, nextFragmentLoc.pageLoc, storfsInst);
-            info_to_buf(wearLevelInfo->sendBuf, &currInfo);
+            STORFS_WORK_BUF_RETURN(storfsInst, pageBuf, STORFS_ERROR);
         }
 
-        itr++;
-    }
-
-    //If a file was rewritten to a new location than what was expected, the previous file must be re-written with new location
-    //Or if it is the initial write to a header file, the previous file must be updated to the newest position
-    if(state == WRITE_RELOCATE || wearLevelInfo->storfsFlags & STORFS_FILE_INIT_HEADER_WRITE)
-    {
-        if(wearLevelInfo->storfsPrevLoc.pageLoc == storfsInst->cachedInfo.rootLocation[0].pageLoc &&
-            wearLevelInfo->storfsPrevLoc.byteLoc == storfsInst->cachedInfo.rootLocation[0].byteLoc)
+        //Only pages that are completely erased are added to the pool
+        for(i = 0; i < STORFS_INST_PAGE_SIZE(storfsInst) && pageBuf[i] == 0xFF; i++);
+        if(i == STORFS_INST_PAGE_SIZE(storfsInst))
         {
-            storfsInst->cachedInfo.rootHeaderInfo[0].childLocation = BYTEPAGE_TO_LOCATION(wearLevelInfo->storfsCurrLoc->byteLoc, wearLevelInfo->storfsCurrLoc->pageLoc, storfsInst);
-            storfsInst->cachedInfo.rootHeaderInfo[1].childLocation = BYTEPAGE_TO_LOCATION(wearLevelInfo->storfsCurrLoc->byteLoc, wearLevelInfo->storfsCurrLoc->pageLoc, storfsInst);
-            return STORFS_OK;
+            STORFS_WORK_BUF_RETURN(storfsInst, pageBuf, erase_pool_add(storfsInst, page));
+        }
+#ifdef STORFS_LAZY_DELETE
+        if(eraseInvalid && STORFS_PAGE_INVALID(storfsInst, page, pageBuf, STORFS_INST_PAGE_SIZE(storfsInst)) && block_reclaim_check(storfsInst, page) == STORFS_OK)
+        {
+            if(STORFS_ERASE(storfsInst, page) != STORFS_OK)
+            {
+                STORFS_WORK_BUF_RETURN(storfsInst, pageBuf, STORFS_ERROR);
+            }
+            STORFS_WORK_BUF_RETURN(storfsInst, pageBuf, erase_pool_add(storfsInst, page));
         }
-        wear_level_act(storfsInst, wearLevelInfo);
+#endif
     }
 
-    return STORFS_OK;
+    STORFS_WORK_BUF_RETURN(storfsInst, pageBuf, STORFS_ERROR);
 }
 
-storfs_err_t storfs_mount(storfs_t *storfsInst, char *partName)
+static storfs_err_t erase_pool_add(storfs_t *storfsInst, storfs_page_t page)
 {
-    storfs_file_header_t firstPartInfo[2];
-    uint32_t strLen = 0;
-
-    STORFS_LOGI(TAG, "Mounting File System");
-
-    //If the user defined region for the first root directory byte added to the size of the header is larger than the size of a page, return an error
-    if((storfsInst->firstByteLoc + STORFS_HEADER_TOTAL_SIZE) > storfsInst->pageSize)
+    if(storfsInst->cachedInfo.erasePoolCount >= STORFS_ERASE_POOL_PAGES)
     {
-        STORFS_LOGE(TAG, "The user defined starting byte and header size is larger than the user defined page size");
         return STORFS_ERROR;
     }
 
-    //Store the first partition location into the cache
-    storfsInst->cachedInfo.rootLocation[0].pageLoc = storfsInst->firstPageLoc;
-    storfsInst->cachedInfo.rootLocation[0].byteLoc = storfsInst->firstByteLoc;
+    STORFS_LOGD(TAG, "Adding page %ld%ld to the erased page pool", (uint32_t)(page >> 32), (uint32_t)(page));
+    storfsInst->cachedInfo.erasePool[storfsInst->cachedInfo.erasePoolCount++] = page;
 
-    //The second root header will be a page ahead of the first root header
-    storfsInst->cachedInfo.rootLocation[1].byteLoc = 0;
-    storfsInst->cachedInfo.rootLocation[1].pageLoc = storfsInst->cachedInfo.rootLocation[0].pageLoc + 1; 
-    
-    //Store the header written to the storage and verify that the crc is correct TODO
-    file_header_store_helper(storfsInst,  &firstPartInfo[0], storfsInst->cachedInfo.rootLocation[0], "Root");
-    file_info_display_helper(firstPartInfo[0]);
-    file_header_store_helper(storfsInst,  &firstPartInfo[1], storfsInst->cachedInfo.rootLocation[1], "Root");
-    file_info_display_helper(firstPartInfo[1]);
+    return STORFS_OK;
+}
 
-    //If file is empty create the root partition within the user defined parameters
-    //The system will use two headers for the root
-    if(((firstPartInfo[0].fileInfo & STORFS_INFO_REG_BLOCK_SIGN_EMPTY) == 0x60) || ((firstPartInfo[1].fileInfo & STORFS_INFO_REG_BLOCK_SIGN_EMPTY) == 0x60))
-    {      
-        //Ensure that both of the roots are cleared
-        if(storfsInst->erase(storfsInst, storfsInst->cachedInfo.rootLocation[0].pageLoc) != STORFS_OK)
-        {
-            return STORFS_ERROR;
-        }  
-        if(storfsInst->erase(storfsInst, storfsInst->cachedInfo.rootLocation[1].pageLoc) != STORFS_OK)
+static storfs_err_t erase_pool_find(storfs_t *storfsInst, storfs_page_t page, storfs_page_t *poolPage)
+{
+    storfs_err_t status = STORFS_ERROR;
+
+    //Find the lowest page within the pool that follows the given page
+    for(int j = 0; j < storfsInst->cachedInfo.erasePoolCount; j++)
+    {
+        if(storfsInst->cachedInfo.erasePool[j] > page && (status != STORFS_OK || storfsInst->cachedInfo.erasePool[j] < *poolPage))
         {
-            return STORFS_ERROR;
+            *poolPage = storfsInst->cachedInfo.erasePool[j];
+            status = STORFS_OK;
         }
-        //Set next open byte
-        storfsInst->cachedInfo.nextOpenByte = ((storfsInst->cachedInfo.rootLocation[1].pageLoc + 1) * storfsInst->pageSize);
+    }
 
-        //Get string length
-        while(partName[strLen++] != '\0');
+    return status;
+}
 
-        //Error checking
-        if(strLen == 0 || (storfsInst->cachedInfo.nextOpenByte >= (storfsInst->pageCount * storfsInst->pageSize)))
+static storfs_err_t erase_pool_remove(storfs_t *storfsInst, storfs_page_t page)
+{
+    for(int j = 0; j < storfsInst->cachedInfo.erasePoolCount; j++)
+    {
+        if(storfsInst->cachedInfo.erasePool[j] == page)
         {
-            STORFS_LOGE(TAG, "STORfs cannot be mounted");
-            return STORFS_ERROR;
+            storfsInst->cachedInfo.erasePool[j] = storfsInst->cachedInfo.erasePool[--storfsInst->cachedInfo.erasePoolCount];
+            return STORFS_OK;
         }
+    }
 
-        //Store file parameters
-        for(int i = 0; i < strLen; i++)
-        {
-            firstPartInfo[0].fileName[i] = partName[i];
-        }
-        firstPartInfo[0].fileInfo = STORFS_INFO_REG_BLOCK_SIGN_PART_FULL | STORFS_INFO_REG_FILE_TYPE_ROOT;
-        firstPartInfo[0].childLocation = storfsInst->cachedInfo.nextOpenByte;
-        firstPartInfo[0].siblingLocation = 0x0;
-        firstPartInfo[0].reserved = 0xFFFF;
-        firstPartInfo[0].fragmentLocation = storfsInst->cachedInfo.nextOpenByte;
-        firstPartInfo[0].fileSize = STORFS_HEADER_TOTAL_SIZE * 2;
-        firstPartInfo[0].crc = STORFS_CRC_CALC(storfsInst, firstPartInfo[0].fileName, strLen);
-        firstPartInfo[1] = firstPartInfo[0];
+    return STORFS_ERROR;
+}
+#endif
 
-        //Write data to first available memory location defined by user
-        if(file_header_create_helper(storfsInst, &firstPartInfo[0], storfsInst->cachedInfo.rootLocation[0], "Root") != STORFS_OK)
-        {
-            STORFS_LOGE(TAG, "The filesystem could not be created at location %ld%ld, %ld", (uint32_t)(storfsInst->cachedInfo.rootLocation[0].pageLoc >> 32), \
-                (uint32_t)(storfsInst->cachedInfo.rootLocation[0].pageLoc), storfsInst->cachedInfo.rootLocation[0].byteLoc);
-            return STORFS_ERROR; 
-        }
+#ifdef STORFS_METADATA_PACK
+static storfs_err_t meta_slot_take(storfs_t *storfsInst, storfs_loc_t *storfsLoc)
+{
+    storfs_loc_t metaLoc = storfsInst->cachedInfo.metaLoc;
+    uint8_t headerBuf[STORFS_HEADER_TOTAL_SIZE];
 
-        file_header_store_helper(storfsInst,  &firstPartInfo[0], storfsInst->cachedInfo.rootLocation[0], "Root");
-        file_info_display_helper(firstPartInfo[0]);
+    //Directories are only packed after the last directory created since mounting
+    if(metaLoc.byteLoc == 0 || (metaLoc.byteLoc + STORFS_HEADER_TOTAL_SIZE) > STORFS_INST_PAGE_SIZE(storfsInst))
+    {
+        return STORFS_ERROR;
+    }
 
-        //Compare the CRC obtained from the file to the computed crc of the filename
-        if(crc_compare(storfsInst, firstPartInfo[0], firstPartInfo[0].fileName, strLen) != STORFS_OK)
+    //Ensure the space following the last directory is still erased
+    if(STORFS_READ(storfsInst, metaLoc.pageLoc, metaLoc.byteLoc, headerBuf, STORFS_HEADER_TOTAL_SIZE) != STORFS_OK)
+    {
+        return STORFS_READ_FAILED;
+    }
+    for(int i = 0; i < STORFS_HEADER_TOTAL_SIZE; i++)
+    {
+        if(headerBuf[i] != 0xFF)
         {
+            storfsInst->cachedInfo.metaLoc.byteLoc = 0;
             return STORFS_ERROR;
         }
+    }
 
-        //Write data to second available memory location following the first
-        if(file_header_create_helper(storfsInst, &firstPartInfo[1], storfsInst->cachedInfo.rootLocation[1], "Root") != STORFS_OK)
-        {
-            STORFS_LOGE(TAG, "The filesystem could not be created at location %ld%ld, %ld", (uint32_t)(storfsInst->cachedInfo.rootLocation[1].pageLoc >> 32), \
-                (uint32_t)(storfsInst->cachedInfo.rootLocation[1].pageLoc), storfsInst->cachedInfo.rootLocation[1].byteLoc);
-            return STORFS_ERROR; 
-        }
+    STORFS_LOGD(TAG, "Packing directory header at %ld%ld, %ld", (uint32_t)(metaLoc.pageLoc >> 32), (uint32_t)(metaLoc.pageLoc), metaLoc.byteLoc);
+    *storfsLoc = metaLoc;
 
-        file_header_store_helper(storfsInst,  &firstPartInfo[1], storfsInst->cachedInfo.rootLocation[1], "Root");
-        file_info_display_helper(firstPartInfo[1]);
+    return STORFS_OK;
+}
 
-        //Compare the CRC obtained from the file to the computed crc of the filename
-        if(crc_compare(storfsInst, firstPartInfo[1], firstPartInfo[1].fileName, strLen) != STORFS_OK)
+static storfs_err_t meta_slot_remove(storfs_t *storfsInst, storfs_loc_t storfsLoc, const storfs_file_header_t *storfsInfo)
+{
+    uint8_t infoReg = storfsInfo->fileInfo & (uint8_t)~STORFS_INFO_REG_VALID_BIT;
+
+    STORFS_LOGD(TAG, "Removing directory header at %ld%ld, %ld", (uint32_t)(storfsLoc.pageLoc >> 32), (uint32_t)(storfsLoc.pageLoc), storfsLoc.byteLoc);
+    if(storfsInst->partialProgram)
+    {
+        //Clear the valid bit of the header only
+        if(STORFS_WRITE(storfsInst, storfsLoc.pageLoc, storfsLoc.byteLoc, &infoReg, STORFS_INFO_REG_SIZE) != STORFS_OK || 
+            STORFS_SYNC(storfsInst) != STORFS_OK)
         {
-            return STORFS_ERROR;
+            return STORFS_WRITE_FAILED;
         }
-        
-
-        storfsInst->cachedInfo.rootHeaderInfo[0] = firstPartInfo[0];
-        storfsInst->cachedInfo.rootHeaderInfo[1] = firstPartInfo[1];
     }
     else
-    {        
-        //Get string length
-        while(firstPartInfo[0].fileName[strLen++] != '\0');
-
-        //Compare the CRC code to the register code
-        if(crc_compare(storfsInst, firstPartInfo[0], firstPartInfo[0].fileName, strLen) != STORFS_OK)
+    {
+        //Without partial programming the page is rewritten with the header cleared, unless no other header remains
+        STORFS_WORK_BUF_TAKE(storfsInst, pageBuf, STORFS_INST_PAGE_SIZE(storfsInst));
+        if(STORFS_WORK_BUF_FAILED(pageBuf))
         {
             return STORFS_ERROR;
         }
-        
-        //Get string length
-        strLen = 0;
-        while(firstPartInfo[1].fileName[strLen++] != '\0');
-        
-        //Compare the CRC code to the register code
-        if(crc_compare(storfsInst, firstPartInfo[1], firstPartInfo[1].fileName, strLen) != STORFS_OK)
+        if(meta_page_read(storfsInst, storfsLoc.pageLoc, pageBuf) != STORFS_OK)
         {
-            return STORFS_ERROR;
+            STORFS_WORK_BUF_RETURN(storfsInst, pageBuf, STORFS_READ_FAILED);
         }
-
-        //Set next open byte
-        storfsInst->cachedInfo.nextOpenByte = firstPartInfo[1].fragmentLocation;
+        pageBuf[storfsLoc.byteLoc] = infoReg;
+        if(meta_page_live(storfsInst, storfsLoc.pageLoc, pageBuf, STORFS_INST_PAGE_SIZE(storfsInst)) == STORFS_OK)
+        {
+            STORFS_WORK_BUF_RETURN(storfsInst, pageBuf, meta_page_write(storfsInst, storfsLoc.pageLoc, pageBuf));
+        }
+        STORFS_WORK_BUF_GIVE(storfsInst, pageBuf);
     }
-    
-    return STORFS_OK;
-}
 
-storfs_err_t storfs_mkdir(storfs_t *storfsInst, char *pathToDir)
-{   
-    STORFS_LOGI(TAG, "Making Directory at %s", pathToDir);
+    //Free the page once none of its headers are valid
+    if(meta_page_live(storfsInst, storfsLoc.pageLoc, NULL, 0) == STORFS_OK)
+    {
+        return STORFS_OK;
+    }
+    if(storfsInst->cachedInfo.metaLoc.pageLoc == storfsLoc.pageLoc)
+    {
+        storfsInst->cachedInfo.metaLoc.byteLoc = 0;
+    }
 
-    return file_handling_helper(storfsInst, (storfs_name_t *)pathToDir, DIR_CREATE, NULL);
+    return page_free_helper(storfsInst, storfsLoc.pageLoc);
 }
 
-storfs_err_t storfs_touch(storfs_t *storfsInst, char *pathToFile)
+static storfs_err_t meta_page_live(storfs_t *storfsInst, storfs_page_t page, const uint8_t *buf, storfs_size_t size)
 {
-    STORFS_LOGI(TAG, "Making File at %s", pathToFile);
+    uint8_t infoReg;
+
+    //Read the info register of each header in turn, from the buffer if given or otherwise from the page
+    for(storfs_byte_t byte = 0; (byte + STORFS_HEADER_TOTAL_SIZE) <= STORFS_INST_PAGE_SIZE(storfsInst); byte += STORFS_HEADER_TOTAL_SIZE)
+    {
+        if(byte < size)
+        {
+            infoReg = buf[byte];
+        }
+        else if(STORFS_READ(storfsInst, page, byte, &infoReg, STORFS_INFO_REG_SIZE) != STORFS_OK)
+        {
+            return STORFS_OK;
+        }
+
+        //Headers are packed in order, nothing follows an erased header
+        if(infoReg == 0xFF)
+        {
+            break;
+        }
+        if(!STORFS_HEADER_INVALID(infoReg))
+        {
+            return STORFS_OK;
+        }
+
+        //Only packed headers share a page, the rest of a file's page is its data
+        if(!STORFS_HEADER_PACKED(infoReg))
+        {
+            break;
+        }
+    }
 
-    return file_handling_helper(storfsInst, (storfs_name_t *)pathToFile, FILE_CREATE, NULL);
+    return STORFS_ERROR;
 }
 
-storfs_err_t storfs_fopen(storfs_t *storfsInst, char *pathToFile, const char * mode, STORFS_FILE *stream)
+static storfs_err_t meta_page_read(storfs_t *storfsInst, storfs_page_t page, uint8_t *pageBuf)
 {
-    STORFS_LOGI(TAG, "Opening File at %s in %s mode", pathToFile, mode);
-    storfs_file_flags_t fileFlags = 0;
-
-    if(file_handling_helper(storfsInst, (storfs_name_t *)pathToFile, FILE_OPEN, stream) != STORFS_OK)
+    if(STORFS_READ(storfsInst, page, 0, pageBuf, STORFS_INST_PAGE_SIZE(storfsInst)) != STORFS_OK || STORFS_SYNC(storfsInst) != STORFS_OK)
     {
-        STORFS_LOGE(TAG, "Cannot open or create file");
-        goto ERR;
+        return STORFS_READ_FAILED;
     }
 
-    //Determine the flags to write to the file
-    if(strcmp(mode, "w") == 0)
+#ifdef STORFS_JOURNAL
+    //Link updates held for the page are dropped once it is erased, write them into each valid header
+    storfs_file_header_t storfsInfo;
+    storfs_loc_t storfsLoc;
+    storfsLoc.pageLoc = page;
+    for(storfsLoc.byteLoc = 0; (storfsLoc.byteLoc + STORFS_HEADER_TOTAL_SIZE) <= STORFS_INST_PAGE_SIZE(storfsInst) && pageBuf[storfsLoc.byteLoc] != 0xFF;
+        storfsLoc.byteLoc += STORFS_HEADER_TOTAL_SIZE)
     {
-        //Determine if the file is already populated with data, and if it is delete the file associated
-        if(stream->fileInfo.fileSize > STORFS_HEADER_TOTAL_SIZE)
+        if(STORFS_HEADER_INVALID(pageBuf[storfsLoc.byteLoc]))
         {
-            if(fopen_write_flag_helper(storfsInst, pathToFile, stream) != STORFS_OK)
-            {
-                goto ERR;
-            }   
+            continue;
+        }
+        buf_to_info(pageBuf + storfsLoc.byteLoc, &storfsInfo);
+        journal_apply(storfsInst, storfsLoc, &storfsInfo);
+        info_to_buf(pageBuf + storfsLoc.byteLoc, &storfsInfo);
+        if(!STORFS_HEADER_PACKED(storfsInfo.fileInfo))
+        {
+            break;
         }
-
-        fileFlags = STORFS_FILE_WRITE_FLAG;
     }
-    else if(strcmp(mode, "r") == 0)
+#endif
+
+    return STORFS_OK;
+}
+
+static storfs_err_t meta_page_write(storfs_t *storfsInst, storfs_page_t page, uint8_t *pageBuf)
+{
+    if(STORFS_ERASE(storfsInst, page) != STORFS_OK)
     {
-        fileFlags = STORFS_FILE_READ_FLAG;
+        return STORFS_ERROR;
     }
-    else if(strcmp(mode, "a") == 0)
+    if(STORFS_WRITE(storfsInst, page, 0, pageBuf, STORFS_INST_PAGE_SIZE(storfsInst)) != STORFS_OK)
     {
-        fileFlags = STORFS_FILE_APPEND_FLAG;
+        return STORFS_WRITE_FAILED;
     }
-    else if(strcmp(mode, "w+") == 0)
-    {
-        //Determine if the file is already populated with data, and if it is delete the file associated
-        if(stream->fileInfo.fileSize > STORFS_HEADER_TOTAL_SIZE)
-        {
-            if(fopen_write_flag_helper(storfsInst, pathToFile, stream) != STORFS_OK)
-            {
-                goto ERR;
-            }
-        }
 
-        fileFlags = STORFS_FILE_WRITE_FLAG | STORFS_FILE_READ_FLAG;
-    }
-    else if(strcmp(mode, "r+") == 0)
+    return STORFS_SYNC(storfsInst);
+}
+
+static storfs_err_t meta_header_rewrite(storfs_t *storfsInst, storfs_file_header_t *storfsInfo, storfs_loc_t storfsLoc)
+{
+    STORFS_WORK_BUF_TAKE(storfsInst, pageBuf, STORFS_INST_PAGE_SIZE(storfsInst));
+    if(STORFS_WORK_BUF_FAILED(pageBuf))
     {
-        fileFlags = STORFS_FILE_WRITE_FLAG | STORFS_FILE_READ_FLAG;
+        return STORFS_ERROR;
     }
-    else if(strcmp(mode, "a+") == 0)
+
+    STORFS_LOGD(TAG, "Rewriting header at %ld%ld, %ld", (uint32_t)(storfsLoc.pageLoc >> 32), (uint32_t)(storfsLoc.pageLoc), storfsLoc.byteLoc);
+    if(meta_page_read(storfsInst, storfsLoc.pageLoc, pageBuf) != STORFS_OK)
     {
-        fileFlags = STORFS_FILE_APPEND_FLAG | STORFS_FILE_READ_FLAG;
+        STORFS_WORK_BUF_RETURN(storfsInst, pageBuf, STORFS_READ_FAILED);
     }
-    else
+    info_to_buf(pageBuf + storfsLoc.byteLoc, storfsInfo);
+    if(meta_page_write(storfsInst, storfsLoc.pageLoc, pageBuf) != STORFS_OK)
     {
-        //Default file flag to file read
-        fileFlags = STORFS_FILE_READ_FLAG;
+        STORFS_WORK_BUF_RETURN(storfsInst, pageBuf, STORFS_WRITE_FAILED);
     }
-    
-    //Rewind the file back to the original location, unset rewind flag
-    storfs_rewind(storfsInst, stream);
-    stream->fileFlags &= ~(STORFS_FILE_REWIND_FLAG);
-
-    //Set the current file flags as the file flags for the returned FILE struct
-    stream->fileFlags = fileFlags;
-
-    STORFS_LOGD(TAG, "File Location: %ld%ld, %ld \r\n \
-    File Flags: %ld", (uint32_t)(stream->fileLoc.pageLoc >> 32), (uint32_t)(stream->fileLoc.pageLoc ), stream->fileLoc.byteLoc, fileFlags);
-
-    return STORFS_OK;
 
-    ERR:
-        return STORFS_ERROR;
+    STORFS_WORK_BUF_RETURN(storfsInst, pageBuf, crc_header_check(storfsInst, storfsLoc));
 }
+#endif
 
-storfs_err_t storfs_fputs(storfs_t *storfsInst, const char *str, const int n, STORFS_FILE *stream)
+#ifdef STORFS_INLINE_FILES
+static storfs_err_t inline_find_helper(storfs_t *storfsInst, storfs_file_header_t *storfsInfo, storfs_loc_t *versionLoc, storfs_file_header_t *versionInfo, uint32_t *versions)
 {
-    //Sanity Check
-    if(storfsInst == NULL || stream == NULL || str == NULL || n == 0 || stream == NULL)
-    {
-        STORFS_LOGE(TAG, "Cannot write to file");
-        return STORFS_ERROR;
-    }
+    storfs_size_t location = storfsInfo->fragmentLocation;
 
-    //Error if next write is larger than the page count
-    if(LOCATION_TO_PAGE(storfsInst->cachedInfo.nextOpenByte, storfsInst) >= storfsInst->pageCount)
+    //Follow the links from the header to the latest version, which has not been linked yet
+    *versions = 0;
+    while(location != STORFS_INLINE_LINK_ERASED)
     {
-        STORFS_LOGE(TAG, "Cannot write any more data to the file system");
+        versionLoc->pageLoc = LOCATION_TO_PAGE(location, storfsInst);
+        versionLoc->byteLoc = LOCATION_TO_BYTE(location, storfsInst);
+        if(file_header_store_helper(storfsInst, versionInfo, *versionLoc, "Inline Version") != STORFS_OK)
+        {
+            return STORFS_READ_FAILED;
+        }
+        location = versionInfo->fragmentLocation;
+        (*versions)++;
     }
 
-    //If the file is opened in read only return an error
-    if(stream->fileFlags == STORFS_FILE_READ_FLAG)
+    return (*versions > 0) ? STORFS_OK : STORFS_ERROR;
+}
+
+static storfs_err_t inline_write_helper(storfs_t *storfsInst, const char *str, const int n, STORFS_FILE *stream)
+{
+    uint8_t versionBuf[STORFS_HEADER_TOTAL_SIZE];
+    uint8_t checkBuf[STORFS_HEADER_TOTAL_SIZE];
+    storfs_file_header_t headerInfo, lastInfo, versionInfo;
+    storfs_loc_t lastLoc, versionLoc;
+    storfs_size_t versionLocation;
+    storfs_err_t status = STORFS_ERROR;
+    uint32_t versions;
+    int32_t offset = 0;
+    int i;
+
+    if(file_header_store_helper(storfsInst, &headerInfo, stream->fileLoc, "Inline") != STORFS_OK)
     {
-        STORFS_LOGE(TAG, "Cannot write to file, in read only mode");
-        return STORFS_ERROR;
+        return STORFS_READ_FAILED;
+    }
+    if(inline_find_helper(storfsInst, &headerInfo, &lastLoc, &lastInfo, &versions) == STORFS_OK && 
+        stream->fileFlags & STORFS_FILE_APPEND_FLAG && !(stream->fileFlags & STORFS_FILE_REWIND_FLAG))
+    {
+        //Appending keeps the data of the latest version
+        offset = lastInfo.reserved;
     }
 
-    STORFS_LOGI(TAG, "Writing to file %s", stream->fileInfo.fileName);
-
-    wear_level_t wearLevelInfo;                                               //Needed for wear level writing
-    uint8_t sendBuf[storfsInst->pageSize];                                    //Buffer of data to send to flash device                                      
-    uint8_t headerBuf[STORFS_HEADER_TOTAL_SIZE];                              //Buffer used to store the header of each page
-    uint32_t headerLen = STORFS_HEADER_TOTAL_SIZE;                            //Length of header to be used depending on fragment header or file header
-    int count = n;                                                            //Length of the data to be placed in storage
-    int32_t sendDataItr = 0;                                                  //Iterations for the number of pages to be programmed
-    int32_t currItr = 0;
-
-    storfs_loc_t currDataHeaderLoc = stream->fileLoc;                         //Location of the current data
-    storfs_loc_t nextDataHeaderLoc = currDataHeaderLoc;                       //Next location for data to be written to
-    storfs_loc_t prevDataHeaderLoc = stream->filePrevLoc;
-    
-    storfs_file_size_t updatedFileSize;                                       //Updated filesize to be written to the header
-    storfs_file_header_t currHeaderInfo;                                      //Current Header's information
-    
-    int32_t appendHeaderByteLoc = 0;                                          //Location of the data to be appended onto the current buffer
-
-    //Get updated file information
-    if(file_header_store_helper(storfsInst, &stream->fileInfo, stream->fileLoc, "Updated") != STORFS_OK)
+    //The file no longer fits within a single version
+    if((offset + n) > STORFS_INLINE_FILE_SIZE)
     {
         return STORFS_ERROR;
     }
 
-    if(stream->fileFlags & STORFS_FILE_APPEND_FLAG && stream->fileInfo.fileSize > STORFS_HEADER_TOTAL_SIZE && !(stream->fileFlags & STORFS_FILE_REWIND_FLAG))
+    STORFS_LOGI(TAG, "Writing inline version %ld of file %s", versions, stream->fileInfo.fileName);
+    if(offset > 0 && STORFS_READ(storfsInst, lastLoc.pageLoc, (lastLoc.byteLoc + STORFS_FRAGMENT_HEADER_TOTAL_SIZE), 
+        (versionBuf + STORFS_FRAGMENT_HEADER_TOTAL_SIZE), offset) != STORFS_OK)
     {
-        //Update the file size of the main header
-        updatedFileSize = stream->fileInfo.fileSize + n + ((n / (storfsInst->pageSize - STORFS_FRAGMENT_HEADER_TOTAL_SIZE)) * STORFS_FRAGMENT_HEADER_TOTAL_SIZE);
-
-        //Store the file header
-        currHeaderInfo = stream->fileInfo;
+        return STORFS_READ_FAILED;
+    }
+    memcpy(versionBuf + STORFS_FRAGMENT_HEADER_TOTAL_SIZE + offset, str, n);
 
-        //Find the current location of the header to be appended on to
-        currDataHeaderLoc.byteLoc = 0;
-        while(currHeaderInfo.fragmentLocation != 0x00)
-        {
-            //Set the previous header location to the current
-            prevDataHeaderLoc = currDataHeaderLoc;
+    //The version is a fragment header holding the data length followed by the data, its link is left erased
+    versionInfo.fileInfo = STORFS_INFO_REG_FILE_TYPE_FILE_FRAGMENT | STORFS_INFO_REG_INLINE_BIT;
+    versionInfo.reserved = offset + n;
+    versionInfo.fragmentLocation = STORFS_INLINE_LINK_ERASED;
+    versionInfo.crc = STORFS_CRC_CALC(storfsInst, (versionBuf + STORFS_FRAGMENT_HEADER_TOTAL_SIZE), versionInfo.reserved);
+    info_to_buf(versionBuf, &versionInfo);
 
-            //Set the current header location to the fragment location
-            currDataHeaderLoc.pageLoc = LOCATION_TO_PAGE(currHeaderInfo.fragmentLocation, storfsInst);
-            file_header_store_helper(storfsInst, &currHeaderInfo, currDataHeaderLoc, "Append");
-        }
-       
-        //If the location of the next available byte is greater than the files original location...
-        if(currDataHeaderLoc.pageLoc != stream->fileLoc.pageLoc)
+    //Write the version after the last packed header, moving past space that fails to program
+    for(i = 0; i < STORFS_WEAR_LEVEL_RETRY_NUM && status != STORFS_OK; i++)
+    {
+        if(meta_slot_take(storfsInst, &versionLoc) != STORFS_OK)
         {
-            STORFS_LOGD(TAG, "Appending to file fragment");
-
-            //Append needed to write onto the current buffer length
-            appendHeaderByteLoc = (stream->fileInfo.fileSize % storfsInst->pageSize) - STORFS_FRAGMENT_HEADER_TOTAL_SIZE;
-            if(appendHeaderByteLoc < 0)
-            {
-                appendHeaderByteLoc = 0;
-            }
-
-            //Update the file size register in the header of the file
-            stream->fileInfo.fileSize = updatedFileSize;
-            if(storfsInst->read(storfsInst, stream->fileLoc.pageLoc, STORFS_HEADER_TOTAL_SIZE, (sendBuf + STORFS_HEADER_TOTAL_SIZE), (storfsInst->pageSize - STORFS_HEADER_TOTAL_SIZE)) != STORFS_OK)
-            {
-                return STORFS_READ_FAILED;
-            }
-
-            //Delete the file header so it may be written to
-            if(storfsInst->erase(storfsInst, stream->fileLoc.pageLoc) != STORFS_OK)
-            {
-                return STORFS_ERROR;
-            }
-
-            //Write the new file header with the updated information
-            info_to_buf(sendBuf, &stream->fileInfo);
-            if(storfsInst->write(storfsInst,  stream->fileLoc.pageLoc, 0, sendBuf, storfsInst->pageSize) != STORFS_OK)
-            {
-                return STORFS_WRITE_FAILED;
-            }
-
-            //Read in the current header of the data buffer
-            if(storfsInst->read(storfsInst, currDataHeaderLoc.pageLoc, STORFS_FRAGMENT_HEADER_TOTAL_SIZE, (sendBuf + STORFS_FRAGMENT_HEADER_TOTAL_SIZE), (appendHeaderByteLoc - STORFS_FRAGMENT_HEADER_TOTAL_SIZE)) != STORFS_OK)
-            {
-                return STORFS_READ_FAILED;
-            }
-            //Delete the page from memory so it may be re-written
-            if(storfsInst->erase(storfsInst, currDataHeaderLoc.pageLoc) != STORFS_OK)
+            //Start a new metadata page at the next open byte
+            versionLoc.pageLoc = LOCATION_TO_PAGE(storfsInst->cachedInfo.nextOpenByte, storfsInst);
+            versionLoc.byteLoc = 0;
+            if(find_update_next_open_byte(storfsInst, versionLoc) != STORFS_OK)
             {
                 return STORFS_ERROR;
             }
+        }
+        storfsInst->cachedInfo.metaLoc.pageLoc = versionLoc.pageLoc;
+        storfsInst->cachedInfo.metaLoc.byteLoc = versionLoc.byteLoc + STORFS_HEADER_TOTAL_SIZE;
 
-            //Set the header length to fragment header size
-            headerLen = STORFS_FRAGMENT_HEADER_TOTAL_SIZE;
+        if(STORFS_WRITE(storfsInst, versionLoc.pageLoc, versionLoc.byteLoc, versionBuf, (STORFS_FRAGMENT_HEADER_TOTAL_SIZE + versionInfo.reserved)) != STORFS_OK || 
+            STORFS_SYNC(storfsInst) != STORFS_OK || 
+            STORFS_READ(storfsInst, versionLoc.pageLoc, versionLoc.byteLoc, checkBuf, (STORFS_FRAGMENT_HEADER_TOTAL_SIZE + versionInfo.reserved)) != STORFS_OK)
+        {
+            return STORFS_WRITE_FAILED;
         }
-        else
+        if(memcmp(checkBuf, versionBuf, (STORFS_FRAGMENT_HEADER_TOTAL_SIZE + versionInfo.reserved)) == 0)
         {
-            STORFS_LOGD(TAG, "Appending to file head");
+            status = STORFS_OK;
+        }
+        else if(meta_slot_remove(storfsInst, versionLoc, &versionInfo) != STORFS_OK)
+        {
+            return STORFS_ERROR;
+        }
+    }
+    if(status != STORFS_OK)
+    {
+        return STORFS_WRITE_FAILED;
+    }
 
-            //Append needed to write onto the current buffer length
-            appendHeaderByteLoc = stream->fileInfo.fileSize - STORFS_HEADER_TOTAL_SIZE;
-            if(appendHeaderByteLoc < 0)
-            {
-                appendHeaderByteLoc = 0;
-            }
+    //Link the latest version to the new one, once enough versions are linked the header is rewritten to point to the new one
+    versionLocation = BYTEPAGE_TO_LOCATION(versionLoc.byteLoc, versionLoc.pageLoc, storfsInst);
+    if(versions == 0)
+    {
+        status = inline_link_program(storfsInst, stream->fileLoc, STORFS_INLINE_HEADER_LINK, versionLocation);
+    }
+    else if(versions < STORFS_INLINE_VERSIONS)
+    {
+        status = inline_link_program(storfsInst, lastLoc, STORFS_INLINE_VERSION_LINK, versionLocation);
+    }
+    else
+    {
+        status = STORFS_ERROR;
+    }
+    if(status != STORFS_OK)
+    {
+        storfs_file_header_t oldInfo = headerInfo;
 
-            //Read in the current header of the data buffer
-            if(storfsInst->read(storfsInst, stream->fileLoc.pageLoc, STORFS_HEADER_TOTAL_SIZE, (sendBuf + STORFS_HEADER_TOTAL_SIZE), (appendHeaderByteLoc - STORFS_HEADER_TOTAL_SIZE)) != STORFS_OK)
-            {
-                return STORFS_READ_FAILED;
-            }
-            //Delete the page from memory so it may be re-written
-            if(storfsInst->erase(storfsInst, stream->fileLoc.pageLoc) != STORFS_OK)
+        headerInfo.fragmentLocation = versionLocation;
+        if(meta_header_rewrite(storfsInst, &headerInfo, stream->fileLoc) != STORFS_OK)
+        {
+            return STORFS_ERROR;
+        }
+
+        //The earlier versions are no longer linked to the header, remove them
+        oldInfo.fileInfo &= ~STORFS_INFO_REG_INLINE_BIT;
+        while(oldInfo.fragmentLocation != STORFS_INLINE_LINK_ERASED)
+        {
+            lastLoc.pageLoc = LOCATION_TO_PAGE(oldInfo.fragmentLocation, storfsInst);
+            lastLoc.byteLoc = LOCATION_TO_BYTE(oldInfo.fragmentLocation, storfsInst);
+            if(file_header_store_helper(storfsInst, &oldInfo, lastLoc, "Inline Version") != STORFS_OK || 
+                meta_slot_remove(storfsInst, lastLoc, &oldInfo) != STORFS_OK)
             {
                 return STORFS_ERROR;
             }
-
-            //Set the current filesize information
-            currHeaderInfo.fileSize = updatedFileSize;
         }
+    }
 
-        //Adjust the count of data to be written to
-        count+=appendHeaderByteLoc;
-        
-        STORFS_LOGD(TAG, "Append File Location: %ld%ld, %ld", (uint32_t)(currDataHeaderLoc.pageLoc >> 32),(uint32_t)currDataHeaderLoc.pageLoc, appendHeaderByteLoc + headerLen);
+    //Reading starts over from the beginning unless the data was appended
+    stream->fileInfo = headerInfo;
+    stream->fileInfo.fileSize = STORFS_HEADER_TOTAL_SIZE + versionInfo.reserved;
+    if(offset == 0)
+    {
+        stream->fileRead.readLocPtr.pageLoc = stream->fileLoc.pageLoc;
+        stream->fileRead.readLocPtr.byteLoc = STORFS_HEADER_TOTAL_SIZE;
+    }
+    stream->fileRead.fileSizeRem = versionInfo.reserved - (stream->fileRead.readLocPtr.byteLoc - STORFS_HEADER_TOTAL_SIZE);
+    stream->fileFlags &= ~(STORFS_FILE_REWIND_FLAG);
 
-        //Determine the number of iterations that must be programmed to the device
-        sendDataItr = (count + storfsInst->pageSize) / (storfsInst->pageSize - STORFS_FRAGMENT_HEADER_TOTAL_SIZE);
-        
-        //Set the next data header location to this location
-        nextDataHeaderLoc = currDataHeaderLoc;
+    return STORFS_OK;
+}
 
-        //Adjust reading file size remainder
-        stream->fileRead.fileSizeRem -= appendHeaderByteLoc;
+static storfs_err_t inline_read_helper(storfs_t *storfsInst, char *str, int n, STORFS_FILE *stream)
+{
+    storfs_file_header_t headerInfo, versionInfo;
+    storfs_loc_t versionLoc;
+    uint32_t versions;
+    int32_t offset = stream->fileRead.readLocPtr.byteLoc - STORFS_HEADER_TOTAL_SIZE;
+
+    if(file_header_store_helper(storfsInst, &headerInfo, stream->fileLoc, "Inline") != STORFS_OK)
+    {
+        return STORFS_READ_FAILED;
     }
-    else
+    if(inline_find_helper(storfsInst, &headerInfo, &versionLoc, &versionInfo, &versions) != STORFS_OK)
     {
-        //Store the current header so it may be updated when initially writting to memory
-        currHeaderInfo = stream->fileInfo;
+        versionInfo.reserved = 0;
+    }
 
-        // Delete the file to be written to
-        file_delete_helper(storfsInst, currDataHeaderLoc, currHeaderInfo);
+    //Read from the current read location up to the end of the latest version
+    if(offset < 0)
+    {
+        offset = 0;
+    }
+    if(n > (versionInfo.reserved - offset))
+    {
+        n = versionInfo.reserved - offset;
+    }
+    if(n <= 0)
+    {
+        STORFS_LOGW(TAG, "File has been completely read");
+        stream->fileRead.fileSizeRem = 0;
+        return STORFS_OK;
+    }
 
-        //Update the file size register
-        updatedFileSize = STORFS_HEADER_TOTAL_SIZE + n + ((n / (storfsInst->pageSize - STORFS_FRAGMENT_HEADER_TOTAL_SIZE)) * STORFS_FRAGMENT_HEADER_TOTAL_SIZE);
+    if(STORFS_READ(storfsInst, versionLoc.pageLoc, (versionLoc.byteLoc + STORFS_FRAGMENT_HEADER_TOTAL_SIZE + offset), (uint8_t *)str, n) != STORFS_OK)
+    {
+        STORFS_LOGE(TAG, "Reading from memory failed in function fgets");
+        return STORFS_READ_FAILED;
+    }
+    if(STORFS_SYNC(storfsInst) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
 
-        //Update the file size register in the header of the file
-        currHeaderInfo.fileSize = updatedFileSize;
+    stream->fileRead.readLocPtr.byteLoc = STORFS_HEADER_TOTAL_SIZE + offset + n;
+    stream->fileRead.fileSizeRem = versionInfo.reserved - offset - n;
 
-        //Determine the number of iterations that must be programmed to the device
-        sendDataItr = 1;
-        if((count + STORFS_HEADER_TOTAL_SIZE) > storfsInst->pageSize)
-        {
-            sendDataItr += ((count - (storfsInst->pageSize - STORFS_HEADER_TOTAL_SIZE)) + storfsInst->pageSize) / (storfsInst->pageSize - STORFS_FRAGMENT_HEADER_TOTAL_SIZE);
-        }
+    return STORFS_OK;
+}
 
-        //Reset reading file size remainder and file read pointer
-        stream->fileRead.fileSizeRem = 0;
-        stream->fileRead.readLocPtr.pageLoc = stream->fileLoc.pageLoc;
-        stream->fileRead.readLocPtr.byteLoc = STORFS_HEADER_TOTAL_SIZE;
-    }
+static storfs_err_t inline_size_helper(storfs_t *storfsInst, STORFS_FILE *stream)
+{
+    storfs_file_header_t versionInfo;
+    storfs_loc_t versionLoc;
+    uint32_t versions;
 
-    do
-    {   
-        //Determine which type of header to store
-        if(currItr > 0)
-        {
-            headerLen = STORFS_FRAGMENT_HEADER_TOTAL_SIZE;
-            currHeaderInfo.fileInfo &= ~(STORFS_INFO_REG_FILE_TYPE_FILE);
-            currHeaderInfo.fileInfo &= ~(STORFS_INFO_REG_NOT_FRAGMENT_BIT);
-        }
-        else
-        {
-            currHeaderInfo.fileInfo |= STORFS_INFO_REG_NOT_FRAGMENT_BIT;
-        }
-        
+    stream->fileInfo.fileSize = STORFS_HEADER_TOTAL_SIZE;
+    if(inline_find_helper(storfsInst, &stream->fileInfo, &versionLoc, &versionInfo, &versions) == STORFS_OK)
+    {
+        stream->fileInfo.fileSize += versionInfo.reserved;
+    }
 
-        //If the string length is greater than a page size ensure the sent data can maximally be the page size
-        if((count + headerLen) > storfsInst->pageSize)
-        {
-            wearLevelInfo.sendDataLen = storfsInst->pageSize;
-            count -= (storfsInst->pageSize - headerLen);
+    return STORFS_OK;
+}
 
-            //Determine where the fragment location will be at
-            if((storfsInst->cachedInfo.nextOpenByte < BYTEPAGE_TO_LOCATION(currDataHeaderLoc.byteLoc, currDataHeaderLoc.pageLoc, storfsInst)) && currItr == 0)
-            {
-                nextDataHeaderLoc.pageLoc = LOCATION_TO_PAGE(storfsInst->cachedInfo.nextOpenByte, storfsInst);
-            }
-            else
-            {
-                find_next_open_byte_helper(storfsInst, &nextDataHeaderLoc);
-            }
-            
-            //Set the file header to full in the current header
-            currHeaderInfo.fileInfo &= ~(STORFS_INFO_REG_BLOCK_SIGN_EMPTY);
-            currHeaderInfo.fileInfo |= STORFS_INFO_REG_BLOCK_SIGN_FULL;
+static storfs_err_t inline_promote_helper(storfs_t *storfsInst, STORFS_FILE *stream)
+{
+    wear_level_t wearLevelInfo;
+    uint8_t headerBuf[STORFS_HEADER_TOTAL_SIZE];
+    char dataBuf[STORFS_INLINE_FILE_SIZE];
+    storfs_file_header_t inlineInfo, versionInfo;
+    storfs_loc_t inlineLoc = stream->fileLoc;
+    storfs_loc_t headerLoc;
+    storfs_file_flags_t fileFlags = stream->fileFlags;
+    uint32_t versions;
+    int32_t dataLen = 0;
+    storfs_err_t status;
+
+    STORFS_LOGI(TAG, "Moving inline file %s onto a page of its own", stream->fileInfo.fileName);
+    if(file_header_store_helper(storfsInst, &inlineInfo, inlineLoc, "Inline") != STORFS_OK)
+    {
+        return STORFS_READ_FAILED;
+    }
 
-            //Update the fragment register in the previous header with the new fragment location
-            currHeaderInfo.fragmentLocation = BYTEPAGE_TO_LOCATION(nextDataHeaderLoc.byteLoc, nextDataHeaderLoc.pageLoc, storfsInst);
-            
-        }
-        else
+    //Keep the data of the latest version if it is to be appended to
+    if(inline_find_helper(storfsInst, &inlineInfo, &headerLoc, &versionInfo, &versions) == STORFS_OK && 
+        fileFlags & STORFS_FILE_APPEND_FLAG && !(fileFlags & STORFS_FILE_REWIND_FLAG))
+    {
+        dataLen = versionInfo.reserved;
+        if(STORFS_READ(storfsInst, headerLoc.pageLoc, (headerLoc.byteLoc + STORFS_FRAGMENT_HEADER_TOTAL_SIZE), (uint8_t *)dataBuf, dataLen) != STORFS_OK)
         {
-            wearLevelInfo.sendDataLen = count + headerLen;
+            return STORFS_READ_FAILED;
+        }
+    }
 
-            //If the total size is written to the page then set the file info flag as block full of data
-            if(wearLevelInfo.sendDataLen == storfsInst->pageSize)
-            {
-                currHeaderInfo.fileInfo &= ~(STORFS_INFO_REG_BLOCK_SIGN_EMPTY);
-                currHeaderInfo.fileInfo |= STORFS_INFO_REG_BLOCK_SIGN_FULL;
-            }
-            else
-            {
-                currHeaderInfo.fileInfo &= ~(STORFS_INFO_REG_BLOCK_SIGN_EMPTY);
-                currHeaderInfo.fileInfo |= STORFS_INFO_REG_BLOCK_SIGN_PART_FULL;
-            }
+    //Write the header as a regular file at the next open byte and link the previous file to it
+    wearLevelInfo.storfsInfo = inlineInfo;
+    wearLevelInfo.storfsInfo.fileInfo &= ~STORFS_INFO_REG_INLINE_BIT;
+    wearLevelInfo.storfsInfo.fragmentLocation = 0;
+    wearLevelInfo.storfsInfo.fileSize = STORFS_HEADER_TOTAL_SIZE;
+    headerLoc.pageLoc = LOCATION_TO_PAGE(storfsInst->cachedInfo.nextOpenByte, storfsInst);
+    headerLoc.byteLoc = 0;
+
+    info_to_buf(headerBuf, &wearLevelInfo.storfsInfo);
+    wearLevelInfo.sendBuf = headerBuf;
+    wearLevelInfo.headerLen = STORFS_HEADER_TOTAL_SIZE;
+    wearLevelInfo.sendDataLen = STORFS_HEADER_TOTAL_SIZE;
+    wearLevelInfo.storfsCurrLoc = &headerLoc;
+    wearLevelInfo.storfsInfoLoc = headerLoc;
+    wearLevelInfo.storfsOrigLoc = inlineLoc;
+    wearLevelInfo.storfsPrevLoc = stream->filePrevLoc;
+    wearLevelInfo.storfsFlags = STORFS_FILE_INIT_HEADER_WRITE | stream->filePrevFlags;
+    status = write_wear_level_helper(storfsInst, &wearLevelInfo);
+    if(find_update_next_open_byte(storfsInst, headerLoc) != STORFS_OK || status != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
 
-            currHeaderInfo.fragmentLocation = 0x00;
-        }
+    //Remove the inline header and its versions
+    if(inline_delete_helper(storfsInst, inlineLoc, &inlineInfo) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+    stream->fileLoc = headerLoc;
+    stream->fileInfo = wearLevelInfo.storfsInfo;
 
-        //Convert the current header info into a buffer and store it in the first bytes to be programmed
-        //Store the data to be programmed as well in the buffer
-        for(int i = headerLen; i < wearLevelInfo.sendDataLen; i++)
+    //Write the data being appended to as the start of the file
+    if(dataLen > 0)
+    {
+        stream->fileFlags = STORFS_FILE_WRITE_FLAG;
+        if(write_helper(storfsInst, dataBuf, NULL, NULL, dataLen, stream) != STORFS_OK)
         {
-            //If there is items to append to the current buffer
-            if(currItr == 0 && ((i - headerLen) < appendHeaderByteLoc))
-            {
-                continue;
-            }
-            else
-            {
-                sendBuf[i] = str[i - headerLen - appendHeaderByteLoc];
-            }
+            return STORFS_ERROR;
         }
+        stream->fileFlags = fileFlags;
+    }
 
-        //Calculate CRC
-        currHeaderInfo.crc = STORFS_CRC_CALC(storfsInst, (uint8_t*)(sendBuf + headerLen), (wearLevelInfo.sendDataLen - headerLen));
+    return STORFS_OK;
+}
 
-        //Place Header into buffer
-        info_to_buf(headerBuf, &currHeaderInfo);
-        for(int i = 0; i < headerLen; i++)
-        {
-            sendBuf[i] = headerBuf[i];
-        }
+static storfs_err_t inline_delete_helper(storfs_t *storfsInst, storfs_loc_t storfsLoc, const storfs_file_header_t *storfsInfo)
+{
+    storfs_file_header_t versionInfo = *storfsInfo;
+    storfs_loc_t versionLoc;
 
-        //Wear level handling for information
-        wearLevelInfo.headerLen = headerLen;
-        wearLevelInfo.sendBuf = sendBuf;
-        wearLevelInfo.storfsCurrLoc = &currDataHeaderLoc;
-        wearLevelInfo.storfsOrigLoc = currDataHeaderLoc;
-        wearLevelInfo.storfsPrevLoc = prevDataHeaderLoc;
-        wearLevelInfo.storfsInfo = stream->fileInfo;
-        wearLevelInfo.storfsInfoLoc = stream->fileLoc;
-        wearLevelInfo.storfsFlags = STORFS_FILE_WRITE_FLAG | STORFS_FILE_WRITE_INIT_FLAG;
-        if(write_wear_level_helper(storfsInst, &wearLevelInfo) != STORFS_OK)
+    //Remove each linked version, then the header
+    while(versionInfo.fragmentLocation != STORFS_INLINE_LINK_ERASED)
+    {
+        versionLoc.pageLoc = LOCATION_TO_PAGE(versionInfo.fragmentLocation, storfsInst);
+        versionLoc.byteLoc = LOCATION_TO_BYTE(versionInfo.fragmentLocation, storfsInst);
+        if(file_header_store_helper(storfsInst, &versionInfo, versionLoc, "Inline Version") != STORFS_OK || 
+            meta_slot_remove(storfsInst, versionLoc, &versionInfo) != STORFS_OK)
         {
             return STORFS_ERROR;
         }
+    }
 
-        //Decrement the number of iterations left
-        --sendDataItr;
+    return meta_slot_remove(storfsInst, storfsLoc, storfsInfo);
+}
 
-        //Increment the buffer's location to send data
-        str += (wearLevelInfo.sendDataLen - headerLen - appendHeaderByteLoc) * sizeof(uint8_t);
+static storfs_err_t inline_link_program(storfs_t *storfsInst, storfs_loc_t storfsLoc, storfs_byte_t linkOffset, storfs_size_t location)
+{
+    uint8_t linkBuf[STORFS_FRAGMENT_LOC_SIZE];
+    uint8_t checkBuf[STORFS_FRAGMENT_LOC_SIZE];
+    uint32_t i = 0;
 
-        //Set current header location equal to the next, and previous to current
-        if(wearLevelInfo.storfsCurrLoc->pageLoc >= nextDataHeaderLoc.pageLoc)
-        {
-            //Update nextOpenByte to what is available
-            find_next_open_byte_helper(storfsInst, &currDataHeaderLoc);
-            storfsInst->cachedInfo.nextOpenByte = BYTEPAGE_TO_LOCATION(currDataHeaderLoc.byteLoc, currDataHeaderLoc.pageLoc, storfsInst);
+    //The link is still erased, program it without erasing the page
+    link_to_uint8_t(linkBuf, location, &i);
+    if(STORFS_WRITE(storfsInst, storfsLoc.pageLoc, (storfsLoc.byteLoc + linkOffset), linkBuf, STORFS_FRAGMENT_LOC_SIZE) != STORFS_OK || 
+        STORFS_SYNC(storfsInst) != STORFS_OK)
+    {
+        return STORFS_WRITE_FAILED;
+    }
 
-            //If the current header location is equivalent to the stream's original file location and there was an error writing, update the stream's file location
-            if(currDataHeaderLoc.pageLoc == stream->fileLoc.pageLoc)
-            {
-                stream->fileLoc = *wearLevelInfo.storfsCurrLoc;
-            }
-        }
-        else
-        {
-            currDataHeaderLoc = nextDataHeaderLoc;
-        }
-        prevDataHeaderLoc = *wearLevelInfo.storfsCurrLoc;
+    //Ensure the link was programmed correctly, otherwise the header is rewritten
+    if(STORFS_READ(storfsInst, storfsLoc.pageLoc, (storfsLoc.byteLoc + linkOffset), checkBuf, STORFS_FRAGMENT_LOC_SIZE) != STORFS_OK)
+    {
+        return STORFS_READ_FAILED;
+    }
 
-        //Increment current iteration number
-        currItr++;
+    return (memcmp(checkBuf, linkBuf, STORFS_FRAGMENT_LOC_SIZE) == 0) ? STORFS_OK : STORFS_ERROR;
+}
+#endif
 
-        //Increment read file size remainder
-        stream->fileRead.fileSizeRem += (wearLevelInfo.sendDataLen - headerLen);
-        STORFS_LOGD(TAG, "Read File Size Remainder %ld", stream->fileRead.fileSizeRem);
+#ifdef STORFS_ASYNC
+static storfs_err_t async_check_helper(storfs_t *storfsInst, storfs_async_t *handle)
+{
+    //A handle may not be reused until its operation has completed
+    if(storfsInst == NULL || handle == NULL || handle->pending)
+    {
+        STORFS_LOGE(TAG, "Cannot queue operation");
+        return STORFS_ERROR;
+    }
 
-        //Set the append header byte location to 0
-        if(appendHeaderByteLoc > 0)
-        {
-            appendHeaderByteLoc = 0;
-        }
-    } while (sendDataItr > 0);
+    return STORFS_OK;
+}
 
-    //Store the updated header into the file information
-    if(file_header_store_helper(storfsInst,  &stream->fileInfo, stream->fileLoc, "Updated FILE") != STORFS_OK)
+static storfs_err_t async_queue_helper(storfs_t *storfsInst, storfs_async_t *handle, storfs_async_op_t operation, storfs_async_cb_t callback)
+{
+    handle->operation = operation;
+    handle->callback = callback;
+    handle->status = STORFS_OK;
+    handle->started = 0;
+    handle->done = 0;
+    handle->next = NULL;
+
+    //Add the operation to the end of the queue
+    if(STORFS_LOCK(storfsInst, STORFS_LOCK_EXCLUSIVE) != STORFS_OK)
     {
         return STORFS_ERROR;
     }
-    
-    //Find and update the next open byte available if the next open byte is currently larger than the file's location
-    if(storfsInst->cachedInfo.nextOpenByte <= BYTEPAGE_TO_LOCATION(currDataHeaderLoc.byteLoc, currDataHeaderLoc.pageLoc, storfsInst))
+    handle->pending = 1;
+    if(storfsInst->cachedInfo.asyncTail == NULL)
     {
-        currDataHeaderLoc.pageLoc = LOCATION_TO_PAGE(storfsInst->cachedInfo.nextOpenByte, storfsInst) - 1;
-        find_update_next_open_byte(storfsInst, currDataHeaderLoc);
-    } 
+        storfsInst->cachedInfo.asyncHead = handle;
+    }
     else
     {
-        //Update the root with current values possibly overwritten when using wear-levelling
-        update_root(storfsInst);
+        storfsInst->cachedInfo.asyncTail->next = handle;
+    }
+    storfsInst->cachedInfo.asyncTail = handle;
+    STORFS_UNLOCK(storfsInst, STORFS_LOCK_EXCLUSIVE);
+
+    return STORFS_OK;
+}
+
+storfs_err_t storfs_mkdir_async(storfs_t *storfsInst, char *pathToDir, storfs_async_t *handle, storfs_async_cb_t callback)
+{
+    if(async_check_helper(storfsInst, handle) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+
+    handle->path = pathToDir;
+
+    return async_queue_helper(storfsInst, handle, STORFS_ASYNC_MKDIR, callback);
+}
+
+storfs_err_t storfs_touch_async(storfs_t *storfsInst, char *pathToFile, storfs_async_t *handle, storfs_async_cb_t callback)
+{
+    if(async_check_helper(storfsInst, handle) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+
+    handle->path = pathToFile;
+
+    return async_queue_helper(storfsInst, handle, STORFS_ASYNC_TOUCH, callback);
+}
+
+storfs_err_t storfs_fopen_async(storfs_t *storfsInst, char *pathToFile, const char * mode, STORFS_FILE *stream, storfs_async_t *handle, storfs_async_cb_t callback)
+{
+    if(async_check_helper(storfsInst, handle) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+
+    handle->path = pathToFile;
+    handle->mode = mode;
+    handle->stream = stream;
+
+    return async_queue_helper(storfsInst, handle, STORFS_ASYNC_FOPEN, callback);
+}
+
+storfs_err_t storfs_fputs_async(storfs_t *storfsInst, const char *str, const int n, STORFS_FILE *stream, storfs_async_t *handle, storfs_async_cb_t callback)
+{
+    if(async_check_helper(storfsInst, handle) != STORFS_OK)
+    {
+        return STORFS_ERROR;
     }
 
-    if(stream->fileFlags & STORFS_FILE_REWIND_FLAG)
+    handle->writeBuf = str;
+    handle->n = n;
+    handle->stream = stream;
+
+    return async_queue_helper(storfsInst, handle, STORFS_ASYNC_FPUTS, callback);
+}
+
+storfs_err_t storfs_fgets_async(storfs_t *storfsInst, char *str, int n, STORFS_FILE *stream, storfs_async_t *handle, storfs_async_cb_t callback)
+{
+    if(async_check_helper(storfsInst, handle) != STORFS_OK)
     {
-        LOGD(TAG, "Rewound file has been written");
-        stream->fileFlags &= ~(STORFS_FILE_REWIND_FLAG);
+        return STORFS_ERROR;
     }
 
-    file_info_display_helper(stream->fileInfo);
+    handle->readBuf = str;
+    handle->n = n;
+    handle->stream = stream;
 
-    return STORFS_OK;
+    return async_queue_helper(storfsInst, handle, STORFS_ASYNC_FGETS, callback);
 }
 
-storfs_err_t storfs_fgets(storfs_t *storfsInst, char *str, int n, STORFS_FILE *stream)
+storfs_err_t storfs_rm_async(storfs_t *storfsInst, char *pathToFile, STORFS_FILE *stream, storfs_async_t *handle, storfs_async_cb_t callback)
 {
-    if(storfsInst == NULL || stream == NULL || stream->fileFlags == STORFS_FILE_DELETED_FLAG)
+    if(async_check_helper(storfsInst, handle) != STORFS_OK)
     {
-        STORFS_LOGE(TAG, "Cannot read from file, it does not exist");
         return STORFS_ERROR;
     }
-    if(stream->fileFlags == STORFS_FILE_WRITE_FLAG || stream->fileFlags == STORFS_FILE_APPEND_FLAG)
+
+    handle->path = pathToFile;
+    handle->stream = stream;
+
+    return async_queue_helper(storfsInst, handle, STORFS_ASYNC_RM, callback);
+}
+
+static storfs_err_t async_write_check(storfs_t *storfsInst)
+{
+    //The pages of a queued write are only linked once it has completed, nothing else may change the file system before then
+    if(storfsInst->cachedInfo.asyncWrite != NULL)
     {
-        STORFS_LOGE(TAG, "Cannot read file, in incorrect mode");
+        STORFS_LOGE(TAG, "Cannot write while a queued write is in progress");
+        STORFS_UNLOCK(storfsInst, STORFS_LOCK_EXCLUSIVE);
         return STORFS_ERROR;
     }
 
-    STORFS_LOGI(TAG, "Reading from file %s", stream->fileInfo.fileName);
+    return STORFS_OK;
+}
 
-    int32_t recvDataItr = 0;                                    //Iterations to read from file
-    uint32_t recvDataLen;                                       //Current length to read from file
-    storfs_file_header_t currHeaderInfo;                        //Info of the current in the file
-    uint32_t headerLen = STORFS_HEADER_TOTAL_SIZE;              //Fragment or file header length
-    int count = n;                                              //Storage for total number of bytes to be read from the file
-    storfs_loc_t recvDataHeaderLoc;                             //The location of the current file header in memory
-    
-    recvDataHeaderLoc.pageLoc = stream->fileRead.readLocPtr.pageLoc;
-    recvDataHeaderLoc.byteLoc = 0;
+#ifndef STORFS_LAZY_DELETE
+static storfs_err_t async_erase_defer(storfs_t *storfsInst, storfs_page_t page)
+{
+    storfs_page_t *erasePages = storfsInst->cachedInfo.asyncErasePages;
 
-    file_header_store_helper(storfsInst, &currHeaderInfo, recvDataHeaderLoc, "fgets");
-    
-    //Determine the number of iterations needed to read from the file
-    if(count < stream->fileRead.fileSizeRem)
+    //Pages freed outside of a queued operation, or once the list is full, are erased straight away
+    if(!storfsInst->cachedInfo.asyncDefer || storfsInst->cachedInfo.asyncEraseCount >= STORFS_ASYNC_ERASE_PAGES)
     {
-        if(count > storfsInst->pageSize)
-        {
-            recvDataItr = (count + STORFS_HEADER_TOTAL_SIZE + ((count / storfsInst->pageSize) * STORFS_FRAGMENT_HEADER_TOTAL_SIZE) + storfsInst->pageSize) / storfsInst->pageSize;
-        }
-        else
-        {
-            recvDataItr = (count + STORFS_HEADER_TOTAL_SIZE + storfsInst->pageSize) / storfsInst->pageSize;
-        }
+        return STORFS_ERASE(storfsInst, page);
     }
-    else
+
+    //The lowest page is held first so it is erased last, once every other page is free
+    STORFS_LOGD(TAG, "Deferring erase of page %ld%ld", (uint32_t)(page >> 32), (uint32_t)(page));
+    erasePages[storfsInst->cachedInfo.asyncEraseCount] = page;
+    if(storfsInst->cachedInfo.asyncEraseCount > 0 && page < erasePages[0])
     {
-        recvDataItr = (stream->fileRead.fileSizeRem + storfsInst->pageSize) / storfsInst->pageSize;
-        count = stream->fileRead.fileSizeRem;
-    }
-    
-    //If the count is zero, the file has been completely read, warn the user
-    if(count == 0)
-    {        
-        STORFS_LOGW(TAG, "File has been completely read");
-        return STORFS_OK;
+        erasePages[storfsInst->cachedInfo.asyncEraseCount] = erasePages[0];
+        erasePages[0] = page;
     }
+    storfsInst->cachedInfo.asyncEraseCount++;
 
-    do
-    {
-        STORFS_LOGD(TAG, "Reading File At %ld%ld, %ld", (uint32_t)(stream->fileRead.readLocPtr.pageLoc >> 32),(uint32_t)(stream->fileRead.readLocPtr.pageLoc),  stream->fileRead.readLocPtr.byteLoc);
+    return STORFS_OK;
+}
 
-        //If the receive string buffer length is greater than a page size ensure the received data will maximally be the page size   
-        if((count + headerLen) > (storfsInst->pageSize - stream->fileRead.readLocPtr.byteLoc))
-        {
-            recvDataLen = (storfsInst->pageSize - stream->fileRead.readLocPtr.byteLoc);
-            count -= recvDataLen;
-        }
-        else
-        {
-            recvDataLen = count;
-        }
+static storfs_err_t async_erase_check(storfs_t *storfsInst, storfs_page_t page)
+{
+    uint16_t eraseItr;
 
-        //Read in the data and store each page size in the buffer
-        if(storfsInst->read(storfsInst, stream->fileRead.readLocPtr.pageLoc, stream->fileRead.readLocPtr.byteLoc, (uint8_t *)str, recvDataLen) != STORFS_OK)
-        {
-            STORFS_LOGE(TAG, "Reading from memory failed in function fgets");
-            return STORFS_READ_FAILED;
-        }
-        if(storfsInst->sync(storfsInst) != STORFS_OK)
+    for(eraseItr = 0; eraseItr < storfsInst->cachedInfo.asyncEraseCount; eraseItr++)
+    {
+        if(storfsInst->cachedInfo.asyncErasePages[eraseItr] == page)
         {
             return STORFS_ERROR;
         }
+    }
 
-        recvDataItr--;
-
-        //Decrement read file size remainder
-        stream->fileRead.fileSizeRem -= recvDataLen;
-
-        //If there are fragments...
-        if(recvDataItr > 0)
-        {
-            //Find the next fragments location
-            stream->fileRead.readLocPtr.pageLoc = LOCATION_TO_PAGE(currHeaderInfo.fragmentLocation, storfsInst);
-            stream->fileRead.readLocPtr.byteLoc = 0;
-            file_header_store_helper(storfsInst, &currHeaderInfo, stream->fileRead.readLocPtr, "");
-
-            //The next fragment's data will be after it's header
-            headerLen = STORFS_FRAGMENT_HEADER_TOTAL_SIZE;
-            stream->fileRead.readLocPtr.byteLoc = headerLen;
+    return STORFS_OK;
+}
 
-            //Increment the buffer's location to store data
-            str += recvDataLen * sizeof(uint8_t);
-        }
-    } while (recvDataItr > 0);
+static storfs_err_t async_erase_helper(storfs_t *storfsInst)
+{
+    storfs_page_t page = storfsInst->cachedInfo.asyncErasePages[storfsInst->cachedInfo.asyncEraseCount - 1];
 
-    //Ensure the file size remainder does not go below zero
-    if(stream->fileRead.fileSizeRem < 0)
+    STORFS_LOGD(TAG, "Erasing freed page %ld%ld", (uint32_t)(page >> 32), (uint32_t)(page));
+    storfsInst->cachedInfo.asyncEraseCount--;
+    if(STORFS_ERASE(storfsInst, page) != STORFS_OK)
     {
-        stream->fileRead.fileSizeRem = 0;
-    }  
-    STORFS_LOGD(TAG, "Read File Size Remainder %ld", stream->fileRead.fileSizeRem);
+        return STORFS_ERROR;
+    }
 
-    //Set read pointer byte location
-    stream->fileRead.readLocPtr.byteLoc += recvDataLen;
+    //The last page erased is the lowest, allow the freed pages to be written again from it
+    if(storfsInst->cachedInfo.asyncEraseCount == 0 && storfsInst->cachedInfo.nextOpenByte > BYTEPAGE_TO_LOCATION(0, page, storfsInst))
+    {
+        return update_root_next_open_byte(storfsInst, BYTEPAGE_TO_LOCATION(0, page, storfsInst));
+    }
 
     return STORFS_OK;
 }
+#endif
 
-storfs_err_t storfs_rm(storfs_t *storfsInst, char *pathToFile, STORFS_FILE *stream)
+static storfs_err_t async_write_helper(storfs_t *storfsInst, storfs_async_t *handle)
 {
-    //Error Checking
-    if(storfsInst == NULL || pathToFile == NULL)
+    storfs_err_t status = STORFS_OK;
+
+    //The write is started on the first call, after which a single page is programmed on each call
+    if(!handle->started)
     {
-        return STORFS_ERROR;
+        handle->started = 1;
+        storfsInst->cachedInfo.asyncWrite = handle;
+        status = write_begin_helper(storfsInst, handle->writeBuf, NULL, NULL, handle->n, handle->stream, &handle->write);
+    }
+    if(status == STORFS_OK && handle->write.sendDataItr > 0)
+    {
+        status = write_page_helper(storfsInst, &handle->write);
+    }
+    if(status == STORFS_OK && handle->write.sendDataItr == 0 && handle->write.currItr > 0)
+    {
+        status = write_end_helper(storfsInst, &handle->write);
     }
+    handle->done = (status != STORFS_OK || handle->write.sendDataItr == 0);
 
-    STORFS_FILE rmStream;
-    storfs_file_header_t storfsPreviousHeader;
-    STORFS_LOGI(TAG, "Removing file at %s", pathToFile);
+    return status;
+}
 
-    //Open the file again in order to find the current parent/sibling/children
-    if(file_handling_helper(storfsInst, (storfs_name_t *)pathToFile, FILE_OPEN, &rmStream) != STORFS_OK)
+static storfs_err_t async_step_helper(storfs_t *storfsInst, storfs_async_t *handle)
+{
+    storfs_err_t status;
+
+    //Reading a stream does not modify the file system, it is run as storfs_fgets would be
+    if(handle->operation == STORFS_ASYNC_FGETS)
     {
-        return STORFS_ERROR;
+        handle->done = 1;
+        return storfs_fgets(storfsInst, handle->readBuf, handle->n, handle->stream);
     }
 
-    //If the item to delete is a file or directory
-    if((rmStream.fileInfo.fileInfo & STORFS_INFO_REG_FILE_TYPE_FILE) == STORFS_INFO_REG_FILE_TYPE_FILE)
+    if(STORFS_LOCK(storfsInst, STORFS_LOCK_EXCLUSIVE) != STORFS_OK)
     {
-        if(stream != NULL)
-        {
-            //Set the stream flag to Deleted so it may not be used again until opened/created
-            stream->fileFlags = STORFS_FILE_DELETED_FLAG;
-        }
+        return STORFS_ERROR;
+    }
+#ifndef STORFS_LAZY_DELETE
+    //Pages freed by the operation are left to be erased by the following polls
+    storfsInst->cachedInfo.asyncDefer = 1;
+#endif
+    STORFS_LOGD(TAG, "Running queued operation %d", handle->operation);
+    switch(handle->operation)
+    {
+        case STORFS_ASYNC_MKDIR:
+            STORFS_LOGI(TAG, "Making Directory at %s", handle->path);
+            status = file_handling_helper(storfsInst, (storfs_name_t *)handle->path, DIR_CREATE, NULL);
+            break;
+        case STORFS_ASYNC_TOUCH:
+            STORFS_LOGI(TAG, "Making File at %s", handle->path);
+            status = file_handling_helper(storfsInst, (storfs_name_t *)handle->path, FILE_CREATE, NULL);
+            break;
+        case STORFS_ASYNC_FOPEN:
+            status = fopen_helper(storfsInst, handle->path, handle->mode, handle->stream);
+            break;
+        case STORFS_ASYNC_FPUTS:
+            status = async_write_helper(storfsInst, handle);
+            break;
+        case STORFS_ASYNC_RM:
+            status = rm_helper(storfsInst, handle->path, handle->stream);
+            break;
+        default:
+            status = STORFS_ERROR;
+            break;
+    }
+#ifndef STORFS_LAZY_DELETE
+    storfsInst->cachedInfo.asyncDefer = 0;
+#endif
+    if(handle->operation != STORFS_ASYNC_FPUTS)
+    {
+        handle->done = 1;
+    }
+    STORFS_UNLOCK(storfsInst, STORFS_LOCK_EXCLUSIVE);
 
-        if(file_delete_helper(storfsInst, rmStream.fileLoc, rmStream.fileInfo) != STORFS_OK)
-        {
-            return STORFS_ERROR;
-        }
+    return status;
+}
+
+storfs_err_t storfs_poll(storfs_t *storfsInst)
+{
+    storfs_async_t *handle;
+    storfs_err_t status;
 
+    if(storfsInst == NULL)
+    {
+        return STORFS_ERROR;
     }
-    else
+
+    //Nothing is run while the device is still busy with a previous operation
+    if(storfsInst->ready != NULL && storfsInst->ready(storfsInst) != STORFS_OK)
     {
-       if(directory_delete_helper(storfsInst, rmStream.fileLoc, rmStream.fileInfo) != STORFS_OK)
-       {
-           return STORFS_ERROR;
-       }
+        return STORFS_OK;
     }
-    
-    
-    //Store the previous header and manipulate it
-    file_header_store_helper(storfsInst, &storfsPreviousHeader, rmStream.filePrevLoc, "Previous");
 
-    //Update the child or sibling directory of the previous file location
-    if(rmStream.filePrevLoc.pageLoc == storfsInst->firstPageLoc)
+    //The queue is only read while holding the lock, operations may be queued from other threads
+    if(STORFS_LOCK(storfsInst, STORFS_LOCK_EXCLUSIVE) != STORFS_OK)
     {
-        storfsInst->cachedInfo.rootHeaderInfo[0].childLocation = rmStream.fileInfo.siblingLocation;
-        storfsInst->cachedInfo.rootHeaderInfo[1].childLocation = rmStream.fileInfo.siblingLocation;
+        return STORFS_ERROR;
     }
-    else if(rmStream.filePrevFlags == STORFS_FILE_PARENT_FLAG)
+    handle = storfsInst->cachedInfo.asyncHead;
+    if(handle == NULL)
     {
-        storfsPreviousHeader.childLocation = rmStream.fileInfo.siblingLocation;
-        //Remove the header from storage so it may be re-written
-        if(storfsInst->erase(storfsInst, rmStream.filePrevLoc.pageLoc) != STORFS_OK)
-        {
-            return STORFS_ERROR;
-        }
-        if(file_header_create_helper(storfsInst, &storfsPreviousHeader, rmStream.filePrevLoc, "") != STORFS_OK)
+        STORFS_UNLOCK(storfsInst, STORFS_LOCK_EXCLUSIVE);
+        return STORFS_OK;
+    }
+#ifndef STORFS_LAZY_DELETE
+    //A single page freed by the operation at the head of the queue is erased on each call, the lowest is kept until it has run to its end
+    if(storfsInst->cachedInfo.asyncEraseCount > 1 || (storfsInst->cachedInfo.asyncEraseCount == 1 && handle->done))
+    {
+        status = async_erase_helper(storfsInst);
+        if(status != STORFS_OK && handle->status == STORFS_OK)
         {
-            return STORFS_ERROR;
+            handle->status = status;
         }
+        STORFS_UNLOCK(storfsInst, STORFS_LOCK_EXCLUSIVE);
+        return STORFS_OK;
     }
-    else
-    {
-        //If the current file being deleted has a sibling, update the previous register's sibling with the current registers sibling
-        storfsPreviousHeader.siblingLocation = rmStream.fileInfo.siblingLocation;
+#endif
+    STORFS_UNLOCK(storfsInst, STORFS_LOCK_EXCLUSIVE);
 
-         //If the previous file is a directory simply update the header, if not read in the data of the original file page and update the page with a new header
-        if((storfsPreviousHeader.fileInfo & STORFS_INFO_REG_FILE_TYPE_FILE) == STORFS_INFO_REG_FILE_TYPE_DIRECTORY)
+    //Run the next step of the operation, queued writes program a single page on each call
+    if(!handle->done)
+    {
+        status = async_step_helper(storfsInst, handle);
+        if(status != STORFS_OK && handle->status == STORFS_OK)
         {
-            //Remove the header from storage so it may be re-written
-            if(storfsInst->erase(storfsInst, rmStream.filePrevLoc.pageLoc) != STORFS_OK)
-            {
-                return STORFS_ERROR;
-            }
-            if(file_header_create_helper(storfsInst, &storfsPreviousHeader, rmStream.filePrevLoc, "") != STORFS_OK)
-            {
-                return STORFS_ERROR;
-            }
+            handle->status = status;
         }
-        else
+        if(!handle->done)
         {
-            uint8_t siblingBuf[storfsInst->pageSize];
-            uint8_t updatedHeader[STORFS_HEADER_TOTAL_SIZE];
-
-            STORFS_LOGD(TAG, "Updating Previous File Sibling Location at the file's initial location at %ld%ld, %d", (uint32_t)(rmStream.filePrevLoc.pageLoc >> 32), (uint32_t)(rmStream.filePrevLoc.pageLoc), 0);
-
-            if(storfsInst->read(storfsInst, rmStream.fileLoc.pageLoc, STORFS_HEADER_TOTAL_SIZE, siblingBuf, (storfsInst->pageSize - STORFS_HEADER_TOTAL_SIZE)) != STORFS_OK)
-            {
-                return STORFS_READ_FAILED;
-            }
-
-            //Remove the header from storage so it may be re-written
-            if(storfsInst->erase(storfsInst, rmStream.filePrevLoc.pageLoc) != STORFS_OK)
-            {
-                return STORFS_ERROR;
-            }
-
-            info_to_buf(updatedHeader, &storfsPreviousHeader);
-            for(int i = 0; i < storfsInst->pageSize; i++)
-            {
-                if(i < STORFS_HEADER_TOTAL_SIZE)
-                {
-                    siblingBuf[i] = updatedHeader[i];
-                }
-                else
-                {
-                    siblingBuf[i] = siblingBuf[i - STORFS_HEADER_TOTAL_SIZE];
-                }
-            }
-            if(storfsInst->write(storfsInst, rmStream.filePrevLoc.pageLoc, 0, siblingBuf, storfsInst->pageSize) != STORFS_OK)
-            {
-                return STORFS_WRITE_FAILED;
-            }
+            return STORFS_OK;
         }
     }
 
-    //Update the next open byte to the file that was deleted if the next open byte is currently larger than the files location
-    if(storfsInst->cachedInfo.nextOpenByte >= BYTEPAGE_TO_LOCATION(rmStream.fileLoc.byteLoc, rmStream.fileLoc.pageLoc, storfsInst))
+    //Remove the completed operation from the queue once every page it freed has been erased
+    if(STORFS_LOCK(storfsInst, STORFS_LOCK_EXCLUSIVE) != STORFS_OK)
     {
-        update_root_next_open_byte(storfsInst, BYTEPAGE_TO_LOCATION(rmStream.fileLoc.byteLoc, rmStream.fileLoc.pageLoc, storfsInst));
+        return STORFS_ERROR;
     }
-    
-    return STORFS_OK;
-}
-
-storfs_err_t storfs_rewind(storfs_t *storfsInst, STORFS_FILE *stream)
-{
-    if(storfsInst == NULL || stream == NULL || stream->fileFlags == STORFS_FILE_DELETED_FLAG)
+#ifndef STORFS_LAZY_DELETE
+    if(storfsInst->cachedInfo.asyncEraseCount > 0)
     {
-        STORFS_LOGE(TAG, "Error in opening the current file stream");
-        return STORFS_ERROR;
+        STORFS_UNLOCK(storfsInst, STORFS_LOCK_EXCLUSIVE);
+        return STORFS_OK;
     }
+#endif
+    storfsInst->cachedInfo.asyncHead = handle->next;
+    if(storfsInst->cachedInfo.asyncHead == NULL)
+    {
+        storfsInst->cachedInfo.asyncTail = NULL;
+    }
+    if(storfsInst->cachedInfo.asyncWrite == handle)
+    {
+        storfsInst->cachedInfo.asyncWrite = NULL;
+    }
+    STORFS_UNLOCK(storfsInst, STORFS_LOCK_EXCLUSIVE);
 
-    LOGI(TAG, "Rewinding file %s to original location", stream->fileInfo.fileName);
-
-    //Set read pointer location
-    stream->fileRead.readLocPtr.pageLoc = stream->fileLoc.pageLoc;
-    stream->fileRead.readLocPtr.byteLoc = STORFS_HEADER_TOTAL_SIZE;
-    //Set read file size remainder
-    stream->fileRead.fileSizeRem = stream->fileInfo.fileSize - STORFS_HEADER_TOTAL_SIZE - (stream->fileInfo.fileSize / storfsInst->pageSize * STORFS_FRAGMENT_HEADER_TOTAL_SIZE);
-
-    LOGD(TAG, "File size remainder %ld", stream->fileRead.fileSizeRem);
-
-    //Set rewind flag
-    stream->fileFlags |= STORFS_FILE_REWIND_FLAG;
+    //Report completion, the handle may be queued again from within the callback
+    handle->pending = 0;
+    if(handle->callback != NULL)
+    {
+        handle->callback(storfsInst, handle);
+    }
 
     return STORFS_OK;
 }
+#endif
 
 storfs_err_t storfs_display_header(storfs_t *storfsInst, storfs_loc_t loc)
 {
     storfs_file_header_t header;
-    if(file_header_store_helper(storfsInst, &header, loc, "Test") != STORFS_OK)
+    storfs_err_t status;
+
+    if(STORFS_LOCK(storfsInst, STORFS_LOCK_SHARED) != STORFS_OK)
+    {
+        return STORFS_ERROR;
+    }
+    status = file_header_store_helper(storfsInst, &header, loc, "Test");
+    STORFS_UNLOCK(storfsInst, STORFS_LOCK_SHARED);
+    if(status != STORFS_OK)
     {
         return STORFS_ERROR;
     }
-    file_info_display_helper(header);
+    file_info_display_helper(&header);
 
     return STORFS_OK;
 }